@@ -0,0 +1,927 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+    Benchmark harness. Each benchmark performs some number of operations
+    on prepared inputs: one call of a scalar function, or one element of
+    an array function. A benchmark is warmed up, calibrated so that one
+    repetition takes at least the minimum time, then repeated; the
+    report gives the minimum, median, mean and standard deviation of the
+    time per operation, and throughput computed from the minimum and
+    the bytes each operation reads and writes.
+
+    Options:
+        -f text|csv|json    output format (default text)
+        -r count            repetitions per measurement (default 7)
+        -t seconds          minimum time per repetition (default 0.02)
+        -s size             run array benchmarks at this size only
+        -n text             run only benchmarks whose names contain text
+*/
+
+// array sizes, from cache-resident to memory-bound
+static const size_t SIZES[] = { 1024, 65536, 1048576 };
+static const size_t SIZE_COUNT = sizeof(SIZES) / sizeof(SIZES[0]);
+
+// operations per batch for scalar functions
+static const size_t SCALAR_BATCH = 4096;
+
+// the largest array size any benchmark uses
+static const size_t MAX_SIZE = 1048576;
+
+// a benchmark
+typedef struct
+{
+    const char * name;          //! function and variant
+    void (* run)(const size_t); //! performs the given number of operations
+    size_t bytes;               //! bytes read and written per operation
+    bool sized;                 //! array function, run at each size
+}
+benchmark_t;
+
+// the statistics for one measurement
+typedef struct
+{
+    double min;                 //! fastest repetition, ns per operation
+    double median;              //! median repetition
+    double mean;                //! mean repetition
+    double stddev;              //! standard deviation of repetitions
+}
+measurement_t;
+
+typedef enum
+{
+    FORMAT_TEXT,
+    FORMAT_CSV,
+    FORMAT_JSON
+}
+format_t;
+
+//-----------------------------------------------------------------------------
+// Inputs and outputs
+//-----------------------------------------------------------------------------
+
+// doubles in [1, 1000], valid for every logarithm
+static double * positive;
+
+// doubles in [-10, 10]
+static double * wide;
+
+// doubles in (-1, 1)
+static double * unit;
+
+// odd 64-bit integers, and 32-bit ones for cheaper arithmetic
+static uint64_t * odd64;
+static uint64_t * small64;
+
+// integers sharing the factor 2 * 3 * 5 * 7, so GCDs don't stop early at 1
+static uint64_t * multiples;
+
+static omnia_rational_t * rationals;
+
+static double * out_d;
+static double * out_d2;
+static uint64_t * out_u;
+static bool * out_b;
+
+// keeps results alive without letting the compiler discard the work
+static volatile uint64_t sink_u;
+static volatile double sink_d;
+
+static omnia_montgomery_t montgomery;
+static omnia_log_base_t base10;
+static omnia_fir_t * fir;
+static omnia_iir_t * iir;
+
+// low-discrepancy sequences of a typical integration dimension
+#define LOWDISC_DIMS 16
+static omnia_sobol_t * sobol;
+static omnia_halton_t * halton;
+
+// weighted choice among a typical number of categories
+#define ALIAS_CATEGORIES 1000
+static omnia_alias_t * alias;
+
+// caller-owned generators
+static omnia_xoshiro256_t xoshiro256;
+static omnia_pcg64_t pcg64;
+static omnia_wyrand_t wyrand;
+
+// allocate and fill the inputs; returns false if memory runs out
+static bool prepare(void)
+{
+    positive  = malloc(sizeof(double) * MAX_SIZE);
+    wide      = malloc(sizeof(double) * MAX_SIZE);
+    unit      = malloc(sizeof(double) * MAX_SIZE);
+    odd64     = malloc(sizeof(uint64_t) * MAX_SIZE);
+    small64   = malloc(sizeof(uint64_t) * MAX_SIZE);
+    multiples = malloc(sizeof(uint64_t) * MAX_SIZE);
+    rationals = malloc(sizeof(omnia_rational_t) * MAX_SIZE);
+    out_d     = malloc(sizeof(double) * MAX_SIZE);
+    out_d2    = malloc(sizeof(double) * MAX_SIZE);
+    out_u     = malloc(sizeof(uint64_t) * MAX_SIZE);
+    out_b     = malloc(sizeof(bool) * MAX_SIZE);
+
+    if (!positive || !wide || !unit || !odd64 || !small64 || !multiples || !rationals || !out_d || !out_d2 || !out_u || !out_b)
+        return false;
+
+    uint64_t seed[2] = { 12345, 67890 };
+    omnia_xs128p_set_seed(seed);
+    omnia_kiss64_set_seed(seed[0]);
+    omnia_xoshiro256_seed_r(&xoshiro256, seed[0]);
+    omnia_pcg64_seed_r(&pcg64, seed, seed);
+    omnia_wyrand_seed_r(&wyrand, seed[0]);
+    omnia_kiss32_set_seed((uint32_t)seed[1]);
+
+    for (size_t i = 0; i < MAX_SIZE; ++i)
+    {
+        positive[i] = 1.0 + 999.0 * omnia_xs128p_real();
+        wide[i] = 20.0 * omnia_xs128p_real() - 10.0;
+        unit[i] = 1.998 * omnia_xs128p_real() - 0.999;
+        odd64[i] = omnia_xs128p_next() | 1;
+        small64[i] = (omnia_xs128p_next() >> 32) | 1;
+        multiples[i] = (omnia_xs128p_next() >> 12) * 210;
+        omnia_rational_set(&rationals[i], (int64_t)(omnia_xs128p_next() % 2001) - 1000, 1 + (int64_t)(omnia_xs128p_next() % 12));
+    }
+
+    // filters of typical sizes: 32 taps, and two biquad sections
+    double taps[32];
+    omnia_biquad_t sections[2];
+
+    omnia_fir_design(taps, 32, OMNIA_FILTER_LOWPASS, 0.1, 0.0);
+    omnia_biquad_design(&sections[0], OMNIA_FILTER_LOWPASS, 0.1, 0.7071);
+    omnia_biquad_design(&sections[1], OMNIA_FILTER_LOWPASS, 0.1, 0.7071);
+
+    fir = omnia_fir_create(taps, 32);
+    iir = omnia_iir_create(sections, 2);
+
+    omnia_montgomery_init(&montgomery, UINT64_C(0xffffffffffffffc5));
+    omnia_log_base_init(&base10, 10.0);
+
+    alias = omnia_alias_create(positive, ALIAS_CATEGORIES);
+    sobol = omnia_sobol_create(LOWDISC_DIMS);
+    halton = omnia_halton_create(LOWDISC_DIMS);
+
+    return (fir != NULL) && (iir != NULL) && (alias != NULL) && (sobol != NULL) && (halton != NULL);
+}
+
+// release everything prepare allocated
+static void release(void)
+{
+    free(positive);
+    free(wide);
+    free(unit);
+    free(odd64);
+    free(small64);
+    free(multiples);
+    free(rationals);
+    free(out_d);
+    free(out_d2);
+    free(out_u);
+    free(out_b);
+    omnia_fir_free(fir);
+    omnia_iir_free(iir);
+    omnia_alias_free(alias);
+    omnia_sobol_free(sobol);
+    omnia_halton_free(halton);
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+static void run_kiss32_next(const size_t n)
+{
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_kiss32_next();
+
+    sink_u = acc;
+}
+
+static void run_kiss64_next(const size_t n)
+{
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_kiss64_next();
+
+    sink_u = acc;
+}
+
+static void run_xs128p_next(const size_t n)
+{
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_xs128p_next();
+
+    sink_u = acc;
+}
+
+static void run_kiss32_fill(const size_t n)
+{
+    omnia_kiss32_fill((uint32_t *)out_u, n);
+}
+
+static void run_kiss64_fill(const size_t n)
+{
+    omnia_kiss64_fill(out_u, n);
+}
+
+static void run_xs128p_fill(const size_t n)
+{
+    omnia_xs128p_fill(out_u, n);
+}
+
+static void run_xoshiro256ss_fill(const size_t n)
+{
+    omnia_xoshiro256ss_fill_r(&xoshiro256, out_u, n);
+}
+
+static void run_xoshiro256pp_fill(const size_t n)
+{
+    omnia_xoshiro256pp_fill_r(&xoshiro256, out_u, n);
+}
+
+static void run_pcg64_fill(const size_t n)
+{
+    omnia_pcg64_fill_r(&pcg64, out_u, n);
+}
+
+static void run_wyrand_fill(const size_t n)
+{
+    omnia_wyrand_fill_r(&wyrand, out_u, n);
+}
+
+static void run_alias_sample(const size_t n)
+{
+    size_t sum = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        sum += omnia_alias_sample(alias);
+
+    sink_u = sum;
+}
+
+static void run_alias_fill(const size_t n)
+{
+    omnia_alias_fill(alias, (size_t *)out_u, n);
+}
+
+// n coordinates; the sequences restart so they never run out
+static void run_sobol_fill(const size_t n)
+{
+    omnia_sobol_seek(sobol, 0);
+    omnia_sobol_fill(sobol, out_d, n / LOWDISC_DIMS);
+}
+
+static void run_halton_fill(const size_t n)
+{
+    omnia_halton_seek(halton, 0);
+    omnia_halton_fill(halton, out_d, n / LOWDISC_DIMS);
+}
+
+static void run_xs128p_real(const size_t n)
+{
+    double acc = 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_xs128p_real();
+
+    sink_d = acc;
+}
+
+static void run_round_nearest(const size_t n)
+{
+    double acc = 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_round_nearest(wide[i]);
+
+    sink_d = acc;
+}
+
+static void run_round_nearest_array(const size_t n)
+{
+    omnia_round_nearest_array(wide, out_d, n);
+}
+
+static void run_sigdig(const size_t n)
+{
+    double acc = 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_sigdig(positive[i], 6);
+
+    sink_d = acc;
+}
+
+static void run_sigdig_array(const size_t n)
+{
+    omnia_sigdig_array(positive, out_d, n, 6);
+}
+
+static void run_format_sigdig(const size_t n)
+{
+    char buffer[64];
+    size_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_format_sigdig(wide[i], 6, buffer);
+
+    sink_u = acc;
+}
+
+static void run_gcf(const size_t n)
+{
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_gcf(odd64[i], odd64[i + 1]);
+
+    sink_u = acc;
+}
+
+static void run_lcm(const size_t n)
+{
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_lcm(small64[i], small64[i + 1]);
+
+    sink_u = acc;
+}
+
+static void run_gcf_array(const size_t n)
+{
+    sink_u = omnia_gcf_array(multiples, n);
+}
+
+static void run_gcf_pairwise(const size_t n)
+{
+    omnia_gcf_pairwise(odd64, small64, out_u, n);
+}
+
+static void run_mulmod(const size_t n)
+{
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_mulmod(odd64[i], odd64[i + 1], montgomery.modulus);
+
+    sink_u = acc;
+}
+
+static void run_powmod(const size_t n)
+{
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_powmod(odd64[i], odd64[i + 1], montgomery.modulus);
+
+    sink_u = acc;
+}
+
+static void run_montgomery_mul_array(const size_t n)
+{
+    omnia_montgomery_mul_array(&montgomery, odd64, small64, out_u, n);
+}
+
+static void run_montgomery_pow_array(const size_t n)
+{
+    omnia_montgomery_pow_array(&montgomery, small64, UINT64_C(0xfedcba9876543210), out_u, n);
+}
+
+static void run_is_prime(const size_t n)
+{
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_is_prime(odd64[i]);
+
+    sink_u = acc;
+}
+
+static void run_is_prime_array(const size_t n)
+{
+    omnia_is_prime_array(odd64, out_b, n);
+}
+
+static void run_factor(const size_t n)
+{
+    uint64_t factors[OMNIA_FACTOR_MAX];
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_factor(small64[i] * (small64[i + 1] >> 8), factors);
+
+    sink_u = acc;
+}
+
+static void run_prime_count(const size_t n)
+{
+    sink_u = omnia_prime_count(n * 64, 1);
+}
+
+static void run_rational_add(const size_t n)
+{
+    omnia_rational_t r;
+    int64_t acc = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        omnia_rational_add(rationals[i], rationals[i + 1], &r);
+        acc += r.num;
+    }
+
+    sink_u = (uint64_t)acc;
+}
+
+static void run_rational_sum(const size_t n)
+{
+    omnia_rational_t r;
+
+    omnia_rational_sum(rationals, n, &r);
+    sink_u = (uint64_t)r.num;
+}
+
+static void run_log_libm(const size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out_d[i] = log(positive[i]);
+}
+
+static void run_log_ulp(const size_t n)
+{
+    omnia_log_array(positive, out_d, n, OMNIA_ACCURACY_ULP);
+}
+
+static void run_log_1e7(const size_t n)
+{
+    omnia_log_array(positive, out_d, n, OMNIA_ACCURACY_1E7);
+}
+
+static void run_log_1e4(const size_t n)
+{
+    omnia_log_array(positive, out_d, n, OMNIA_ACCURACY_1E4);
+}
+
+static void run_exp_libm(const size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out_d[i] = exp(wide[i]);
+}
+
+static void run_exp_ulp(const size_t n)
+{
+    omnia_exp_array(wide, out_d, n, OMNIA_ACCURACY_ULP);
+}
+
+static void run_exp_1e7(const size_t n)
+{
+    omnia_exp_array(wide, out_d, n, OMNIA_ACCURACY_1E7);
+}
+
+static void run_exp_1e4(const size_t n)
+{
+    omnia_exp_array(wide, out_d, n, OMNIA_ACCURACY_1E4);
+}
+
+static void run_sin_libm(const size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out_d[i] = sin(wide[i]);
+}
+
+static void run_sin_ulp(const size_t n)
+{
+    omnia_sin_array(wide, out_d, n, OMNIA_ACCURACY_ULP);
+}
+
+static void run_sin_1e7(const size_t n)
+{
+    omnia_sin_array(wide, out_d, n, OMNIA_ACCURACY_1E7);
+}
+
+static void run_sin_1e4(const size_t n)
+{
+    omnia_sin_array(wide, out_d, n, OMNIA_ACCURACY_1E4);
+}
+
+static void run_cos_ulp(const size_t n)
+{
+    omnia_cos_array(wide, out_d, n, OMNIA_ACCURACY_ULP);
+}
+
+static void run_sincos_ulp(const size_t n)
+{
+    omnia_sincos_array(wide, out_d, out_d2, n, OMNIA_ACCURACY_ULP);
+}
+
+static void run_log_base_array(const size_t n)
+{
+    omnia_log_base_array(&base10, positive, out_d, n, OMNIA_ACCURACY_ULP);
+}
+
+static void run_power_to_db_array(const size_t n)
+{
+    omnia_power_to_db_array(positive, out_d, n, OMNIA_ACCURACY_1E7);
+}
+
+static void run_asinh(const size_t n)
+{
+    double acc = 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_asinh(wide[i]);
+
+    sink_d = acc;
+}
+
+static void run_acosh(const size_t n)
+{
+    double acc = 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_acosh(positive[i]);
+
+    sink_d = acc;
+}
+
+static void run_atanh(const size_t n)
+{
+    double acc = 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+        acc += omnia_atanh(unit[i]);
+
+    sink_d = acc;
+}
+
+static void run_asinh_array(const size_t n)
+{
+    omnia_asinh_array(wide, out_d, n, OMNIA_ACCURACY_ULP);
+}
+
+static void run_acosh_array(const size_t n)
+{
+    omnia_acosh_array(positive, out_d, n, OMNIA_ACCURACY_ULP);
+}
+
+static void run_atanh_array(const size_t n)
+{
+    omnia_atanh_array(unit, out_d, n, OMNIA_ACCURACY_ULP);
+}
+
+static void run_basic_stats(const size_t n)
+{
+    double * stats = omnia_basic_stats(wide, n);
+
+    sink_d = stats[0];
+    omnia_free(stats);
+}
+
+static void run_make_sinusoid(const size_t n)
+{
+    static const omnia_wave_factor_t factors[] = { { 10.0, 1.0 }, { 33.0, 0.5 }, { 7.0, 0.25 } };
+
+    double * signal = omnia_make_sinusoid(factors, 3, n);
+
+    sink_d = signal[n - 1];
+    omnia_free(signal);
+}
+
+static void run_fft(const size_t n)
+{
+    memcpy(out_d, wide, sizeof(double) * n);
+    memset(out_d2, 0, sizeof(double) * n);
+    omnia_fft(out_d, out_d2, n, false);
+}
+
+static void run_fir_process(const size_t n)
+{
+    omnia_fir_process(fir, wide, out_d, n);
+}
+
+static void run_iir_process(const size_t n)
+{
+    omnia_iir_process(iir, wide, out_d, n);
+}
+
+static void run_autocorrelation(const size_t n)
+{
+    double result[33];
+
+    omnia_autocorrelation(wide, n, 32, true, result);
+    sink_d = result[1];
+}
+
+// scalar benchmarks read element i + 1, well within MAX_SIZE
+static const benchmark_t BENCHMARKS[] =
+{
+    { "omnia_kiss32_next",                  run_kiss32_next,            4,  false },
+    { "omnia_kiss64_next",                  run_kiss64_next,            8,  false },
+    { "omnia_xs128p_next",                  run_xs128p_next,            8,  false },
+    { "omnia_kiss32_fill",                  run_kiss32_fill,            4,  true  },
+    { "omnia_kiss64_fill",                  run_kiss64_fill,            8,  true  },
+    { "omnia_xs128p_fill",                  run_xs128p_fill,            8,  true  },
+    { "omnia_xoshiro256ss_fill_r",          run_xoshiro256ss_fill,      8,  true  },
+    { "omnia_xoshiro256pp_fill_r",          run_xoshiro256pp_fill,      8,  true  },
+    { "omnia_pcg64_fill_r",                 run_pcg64_fill,             8,  true  },
+    { "omnia_wyrand_fill_r",                run_wyrand_fill,            8,  true  },
+    { "omnia_alias_sample",                 run_alias_sample,           8,  false },
+    { "omnia_alias_fill",                   run_alias_fill,             8,  true  },
+    { "omnia_sobol_fill",                   run_sobol_fill,             8,  true  },
+    { "omnia_halton_fill",                  run_halton_fill,            8,  true  },
+    { "omnia_xs128p_real",                  run_xs128p_real,            8,  false },
+    { "omnia_round_nearest",                run_round_nearest,          8,  false },
+    { "omnia_round_nearest_array",          run_round_nearest_array,    16, true  },
+    { "omnia_sigdig",                       run_sigdig,                 8,  false },
+    { "omnia_sigdig_array",                 run_sigdig_array,           16, true  },
+    { "omnia_format_sigdig",                run_format_sigdig,          8,  false },
+    { "omnia_gcf",                          run_gcf,                    16, false },
+    { "omnia_lcm",                          run_lcm,                    16, false },
+    { "omnia_gcf_array",                    run_gcf_array,              8,  true  },
+    { "omnia_gcf_pairwise",                 run_gcf_pairwise,           24, true  },
+    { "omnia_mulmod",                       run_mulmod,                 16, false },
+    { "omnia_powmod",                       run_powmod,                 16, false },
+    { "omnia_montgomery_mul_array",         run_montgomery_mul_array,   24, true  },
+    { "omnia_montgomery_pow_array",         run_montgomery_pow_array,   16, true  },
+    { "omnia_is_prime",                     run_is_prime,               8,  false },
+    { "omnia_is_prime_array",               run_is_prime_array,         9,  true  },
+    { "omnia_factor",                       run_factor,                 8,  false },
+    { "omnia_prime_count/64",               run_prime_count,            0,  true  },
+    { "omnia_rational_add",                 run_rational_add,           32, false },
+    { "omnia_rational_sum",                 run_rational_sum,           16, true  },
+    { "log (libm)",                         run_log_libm,               16, true  },
+    { "omnia_log_array/ulp",                run_log_ulp,                16, true  },
+    { "omnia_log_array/1e7",                run_log_1e7,                16, true  },
+    { "omnia_log_array/1e4",                run_log_1e4,                16, true  },
+    { "exp (libm)",                         run_exp_libm,               16, true  },
+    { "omnia_exp_array/ulp",                run_exp_ulp,                16, true  },
+    { "omnia_exp_array/1e7",                run_exp_1e7,                16, true  },
+    { "omnia_exp_array/1e4",                run_exp_1e4,                16, true  },
+    { "sin (libm)",                         run_sin_libm,               16, true  },
+    { "omnia_sin_array/ulp",                run_sin_ulp,                16, true  },
+    { "omnia_sin_array/1e7",                run_sin_1e7,                16, true  },
+    { "omnia_sin_array/1e4",                run_sin_1e4,                16, true  },
+    { "omnia_cos_array/ulp",                run_cos_ulp,                16, true  },
+    { "omnia_sincos_array/ulp",             run_sincos_ulp,             24, true  },
+    { "omnia_log_base_array",               run_log_base_array,         16, true  },
+    { "omnia_power_to_db_array",            run_power_to_db_array,      16, true  },
+    { "omnia_asinh",                        run_asinh,                  8,  false },
+    { "omnia_acosh",                        run_acosh,                  8,  false },
+    { "omnia_atanh",                        run_atanh,                  8,  false },
+    { "omnia_asinh_array",                  run_asinh_array,            16, true  },
+    { "omnia_acosh_array",                  run_acosh_array,            16, true  },
+    { "omnia_atanh_array",                  run_atanh_array,            16, true  },
+    { "omnia_basic_stats",                  run_basic_stats,            8,  true  },
+    { "omnia_make_sinusoid/3",              run_make_sinusoid,          8,  true  },
+    { "omnia_fft",                          run_fft,                    32, true  },
+    { "omnia_fir_process/32",               run_fir_process,            16, true  },
+    { "omnia_iir_process/2",                run_iir_process,            16, true  },
+    { "omnia_autocorrelation/32",           run_autocorrelation,        8,  true  }
+};
+
+static const size_t BENCHMARK_COUNT = sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+
+//-----------------------------------------------------------------------------
+// Measurement
+//-----------------------------------------------------------------------------
+
+// monotonic time in seconds
+static double now(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return (double)t.tv_sec + (double)t.tv_nsec * 1.0e-9;
+}
+
+static int compare_doubles(const void * a, const void * b)
+{
+    const double x = *(const double *)a;
+    const double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+// time a benchmark at one size
+static measurement_t measure(const benchmark_t * b, const size_t n, const size_t reps, const double min_time)
+{
+    measurement_t result;
+    double * times = malloc(sizeof(double) * reps);
+    size_t iterations = 1;
+
+    // warm up caches and branch predictors, then find an iteration count that fills min_time
+    b->run(n);
+
+    for (;;)
+    {
+        const double start = now();
+
+        for (size_t k = 0; k < iterations; ++k)
+            b->run(n);
+
+        const double elapsed = now() - start;
+
+        if ((elapsed >= min_time) || (iterations >= (SIZE_MAX >> 1)))
+            break;
+
+        // aim a little past the minimum, growing at most 100x per step
+        const double scale = (elapsed > 0.0) ? 1.2 * min_time / elapsed : 100.0;
+        iterations = (size_t)((double)iterations * ((scale > 100.0) ? 100.0 : (scale < 2.0) ? 2.0 : scale));
+    }
+
+    double sum = 0.0, sumsq = 0.0;
+
+    for (size_t r = 0; r < reps; ++r)
+    {
+        const double start = now();
+
+        for (size_t k = 0; k < iterations; ++k)
+            b->run(n);
+
+        times[r] = (now() - start) * 1.0e9 / ((double)iterations * (double)n);
+        sum += times[r];
+        sumsq += times[r] * times[r];
+    }
+
+    qsort(times, reps, sizeof(double), compare_doubles);
+
+    result.min = times[0];
+    result.median = (reps & 1) ? times[reps / 2] : 0.5 * (times[reps / 2 - 1] + times[reps / 2]);
+    result.mean = sum / (double)reps;
+    result.stddev = (reps > 1) ? sqrt(fmax(0.0, (sumsq - sum * sum / (double)reps) / (double)(reps - 1))) : 0.0;
+
+    free(times);
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+// Reporting
+//-----------------------------------------------------------------------------
+
+static void report_header(const format_t format)
+{
+    switch (format)
+    {
+        case FORMAT_CSV:
+            printf("name,size,ns_per_op_min,ns_per_op_median,ns_per_op_mean,ns_per_op_stddev,gb_per_s\n");
+            break;
+        case FORMAT_JSON:
+            printf("[\n");
+            break;
+        default:
+            printf("%-28s %9s %10s %10s %10s %9s %8s\n", "function", "size", "min ns/op", "median", "mean", "stddev", "GB/s");
+            break;
+    }
+}
+
+static void report(const format_t format, const benchmark_t * b, const size_t size, const measurement_t * m, const bool first)
+{
+    // throughput at the best time; bytes per ns is GB/s
+    const double gbps = (m->min > 0.0) ? (double)b->bytes / m->min : 0.0;
+
+    switch (format)
+    {
+        case FORMAT_CSV:
+            printf("\"%s\",%zu,%.4f,%.4f,%.4f,%.4f,%.4f\n", b->name, size, m->min, m->median, m->mean, m->stddev, gbps);
+            break;
+        case FORMAT_JSON:
+            printf("%s  { \"name\": \"%s\", \"size\": %zu, \"ns_per_op\": { \"min\": %.4f, \"median\": %.4f, \"mean\": %.4f, \"stddev\": %.4f }, \"gb_per_s\": %.4f }",
+                   first ? "" : ",\n", b->name, size, m->min, m->median, m->mean, m->stddev, gbps);
+            break;
+        default:
+            printf("%-28s %9zu %10.3f %10.3f %10.3f %9.3f %8.3f\n", b->name, size, m->min, m->median, m->mean, m->stddev, gbps);
+            break;
+    }
+
+    fflush(stdout);
+}
+
+static void report_footer(const format_t format)
+{
+    if (format == FORMAT_JSON)
+        printf("\n]\n");
+}
+
+static void usage(const char * program)
+{
+    fprintf(stderr, "usage: %s [-f text|csv|json] [-r repetitions] [-t seconds] [-s size] [-n name]\n", program);
+}
+
+int main(int argc, char * argv[])
+{
+    format_t format = FORMAT_TEXT;
+    size_t reps = 7;
+    double min_time = 0.02;
+    size_t only_size = 0;
+    const char * filter = NULL;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((i + 1 < argc) && (0 == strcmp(argv[i], "-f")))
+        {
+            ++i;
+
+            if (0 == strcmp(argv[i], "csv"))
+                format = FORMAT_CSV;
+            else if (0 == strcmp(argv[i], "json"))
+                format = FORMAT_JSON;
+            else if (0 == strcmp(argv[i], "text"))
+                format = FORMAT_TEXT;
+            else
+            {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        else if ((i + 1 < argc) && (0 == strcmp(argv[i], "-r")))
+            reps = strtoul(argv[++i], NULL, 10);
+        else if ((i + 1 < argc) && (0 == strcmp(argv[i], "-t")))
+            min_time = strtod(argv[++i], NULL);
+        else if ((i + 1 < argc) && (0 == strcmp(argv[i], "-s")))
+            only_size = strtoul(argv[++i], NULL, 10);
+        else if ((i + 1 < argc) && (0 == strcmp(argv[i], "-n")))
+            filter = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // the FFT needs a power of two
+    if ((reps == 0) || (min_time < 0.0) || (only_size > MAX_SIZE) || ((only_size != 0) && (omnia_prev_pow2_size(only_size) != only_size)))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (!prepare())
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+
+    bool first = true;
+
+    report_header(format);
+
+    for (size_t b = 0; b < BENCHMARK_COUNT; ++b)
+    {
+        const benchmark_t * bench = &BENCHMARKS[b];
+
+        if ((filter != NULL) && (strstr(bench->name, filter) == NULL))
+            continue;
+
+        if (!bench->sized)
+        {
+            const measurement_t m = measure(bench, SCALAR_BATCH, reps, min_time);
+            report(format, bench, 1, &m, first);
+            first = false;
+            continue;
+        }
+
+        for (size_t s = 0; s < SIZE_COUNT; ++s)
+        {
+            const size_t size = (only_size != 0) ? only_size : SIZES[s];
+            const measurement_t m = measure(bench, size, reps, min_time);
+
+            report(format, bench, size, &m, first);
+            first = false;
+
+            if (only_size != 0)
+                break;
+        }
+    }
+
+    report_footer(format);
+    release();
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include <math.h>
+
+/*
+    Vose's alias method. With the weights scaled so that they average
+    one, each category owns one column of height one; a category of
+    weight below one fills the rest of its column with part of the
+    weight of a category above one, its alias. A draw picks a column
+    uniformly, then the column's category or its alias.
+
+    A single 64-bit random value r is enough: the 128-bit product r * n
+    has the column in its high half, and its low half is uniform within
+    the column, so its top 32 bits serve as the coin. Each entry packs
+    a 32-bit threshold and a 32-bit alias, so a draw touches one 8-byte
+    entry.
+*/
+
+// entries per block of random values filled at once
+#define ALIAS_BLOCK 256
+
+typedef struct
+{
+    uint32_t threshold;     // coins below this choose the column's own category
+    uint32_t alias;         // the category chosen otherwise
+}
+alias_entry_t;
+
+struct omnia_alias_s
+{
+    size_t n;
+    alias_entry_t * entry;
+};
+
+// choose a category with one random value
+static inline size_t alias_pick(const alias_entry_t * entry, const uint64_t n, const uint64_t random)
+{
+    const uint128_t x = (uint128_t)random * n;
+    const size_t column = (size_t)(x >> 64);
+    const uint32_t coin = (uint32_t)((uint64_t)x >> 32);
+    const alias_entry_t e = entry[column];
+
+    // a select rather than a branch, which would be mispredicted at random
+    const size_t own = (size_t)0 - (size_t)(coin < e.threshold);
+
+    return (column & own) | ((size_t)e.alias & ~own);
+}
+
+// Create an alias table
+omnia_alias_t * omnia_alias_create(const double * weights, const size_t n)
+{
+    omnia_alias_t * table;
+    double total = 0.0;
+
+    if ((weights == NULL) || (n == 0) || (n > UINT32_MAX))
+        return NULL;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!(weights[i] >= 0.0) || isinf(weights[i]))
+            return NULL;
+
+        total += weights[i];
+    }
+
+    if (!(total > 0.0) || isinf(total))
+        return NULL;
+
+    table = (omnia_alias_t *)omnia_alloc_zero(1, sizeof(omnia_alias_t));
+
+    if (table == NULL)
+        return NULL;
+
+    table->n = n;
+    table->entry = (alias_entry_t *)omnia_alloc(sizeof(alias_entry_t) * n);
+
+    double * scaled = (double *)omnia_alloc(sizeof(double) * n);
+    uint32_t * work = (uint32_t *)omnia_alloc(sizeof(uint32_t) * n);
+
+    if ((table->entry == NULL) || (scaled == NULL) || (work == NULL))
+    {
+        omnia_free(scaled);
+        omnia_free(work);
+        omnia_alias_free(table);
+        return NULL;
+    }
+
+    // small categories are stacked at the front of work, large ones at the back
+    size_t small = 0;
+    size_t large = n;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        // n / total overflows for a subnormal total; weights[i] / total cannot
+        scaled[i] = weights[i] / total * (double)n;
+
+        if (scaled[i] >= 1.0)
+            work[--large] = (uint32_t)i;
+        else if (scaled[i] > 0.0)
+            work[small++] = (uint32_t)i;
+    }
+
+    // zero weights go on top, so they are paired while large categories remain
+    for (size_t i = 0; i < n; ++i)
+        if (!(scaled[i] > 0.0))
+            work[small++] = (uint32_t)i;
+
+    while ((small > 0) && (large < n))
+    {
+        const uint32_t s = work[--small];
+        const uint32_t l = work[large++];
+
+        table->entry[s].threshold = (uint32_t)fmin(ldexp(scaled[s], 32), 4294967295.0);
+        table->entry[s].alias = l;
+
+        // the large category gives up the rest of the small one's column
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+
+        if (scaled[l] < 1.0)
+            work[small++] = l;
+        else
+            work[--large] = l;
+    }
+
+    // whatever remains differs from one only by rounding, and keeps its whole column
+    while (small > 0)
+    {
+        const uint32_t s = work[--small];
+        table->entry[s].threshold = UINT32_MAX;
+        table->entry[s].alias = s;
+    }
+
+    while (large < n)
+    {
+        const uint32_t l = work[large++];
+        table->entry[l].threshold = UINT32_MAX;
+        table->entry[l].alias = l;
+    }
+
+    omnia_free(scaled);
+    omnia_free(work);
+
+    return table;
+}
+
+// Release an alias table
+void omnia_alias_free(omnia_alias_t * table)
+{
+    if (table != NULL)
+    {
+        omnia_free(table->entry);
+        omnia_free(table);
+    }
+}
+
+// Number of categories in an alias table
+size_t omnia_alias_size(const omnia_alias_t * table)
+{
+    return table->n;
+}
+
+// Choose a category with a given random value
+size_t omnia_alias_pick(const omnia_alias_t * table, const uint64_t random)
+{
+    return alias_pick(table->entry, table->n, random);
+}
+
+// Choose categories for an array of random values
+void omnia_alias_map(const omnia_alias_t * table, const uint64_t * random, size_t * result, const size_t n)
+{
+    const alias_entry_t * entry = table->entry;
+    const uint64_t count = table->n;
+
+    for (size_t i = 0; i < n; ++i)
+        result[i] = alias_pick(entry, count, random[i]);
+}
+
+// Draw a category
+size_t omnia_alias_sample(const omnia_alias_t * table)
+{
+    return alias_pick(table->entry, table->n, omnia_xs128p_next());
+}
+
+// Draw a category with a caller-owned generator
+size_t omnia_alias_sample_r(const omnia_alias_t * table, omnia_xs128p_t * state)
+{
+    return alias_pick(table->entry, table->n, omnia_xs128p_next_r(state));
+}
+
+// Draw an array of categories
+void omnia_alias_fill(const omnia_alias_t * table, size_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_ALIAS_FILL, n);
+
+    uint64_t random[ALIAS_BLOCK];
+
+    // the library's generator fills a block at a time with its state in registers
+    for (size_t first = 0; first < n; first += ALIAS_BLOCK)
+    {
+        const size_t m = (n - first < ALIAS_BLOCK) ? n - first : ALIAS_BLOCK;
+
+        omnia_xs128p_fill(random, m);
+        omnia_alias_map(table, random, result + first, m);
+    }
+}
+
+// Draw an array of categories with a caller-owned generator
+void omnia_alias_fill_r(const omnia_alias_t * table, omnia_xs128p_t * state, size_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_ALIAS_FILL, n);
+
+    const alias_entry_t * entry = table->entry;
+    const uint64_t count = table->n;
+    omnia_xs128p_t g = *state;
+
+    for (size_t i = 0; i < n; ++i)
+        result[i] = alias_pick(entry, count, omnia_xs128p_next_r(&g));
+
+    *state = g;
+}
@@ -0,0 +1,223 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Correlations are computed directly when only a few lags are wanted,
+    and through the FFT otherwise. The direct loops run over the lags in
+    the inner loop, so that they vectorize as multiply-adds.
+
+    For the FFT path, the data is zero-padded to a power of two of at
+    least n + max_lag points, which is enough to keep the circular
+    correlation from wrapping into any of the requested lags.
+*/
+
+// relative cost of one FFT butterfly compared to a multiply-add
+#define FFT_COST_FACTOR 2.0
+
+// transform length for a given signal length and lag count
+static size_t fft_length(const size_t n, const size_t max_lag)
+{
+    return omnia_next_pow2_size(n + max_lag);
+}
+
+// true if transforms are cheaper than the direct method
+static bool prefer_fft(const size_t n, const size_t lags, const size_t len, const double transforms)
+{
+    const double direct = (double)n * (double)lags;
+    const double fft = transforms * FFT_COST_FACTOR * (double)len * (double)omnia_ilog2_size(len);
+
+    return fft < direct;
+}
+
+// Autocorrelation
+bool omnia_autocorrelation(const double * x, const size_t n, const size_t max_lag, const bool normalize, double * result)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_AUTOCORRELATION, n);
+
+    if ((x == NULL) || (result == NULL) || (n == 0))
+        return false;
+
+    // lags at or beyond the signal length have no overlap
+    const size_t lags = (max_lag < n) ? max_lag : n - 1;
+    const size_t len = fft_length(n, lags);
+
+    for (size_t k = 0; k <= max_lag; ++k)
+        result[k] = 0.0;
+
+    if (prefer_fft(n, lags + 1, len, 2.0))
+    {
+        double * re = (double *)omnia_alloc_zero(len, sizeof(double));
+        double * im = (double *)omnia_alloc_zero(len, sizeof(double));
+        omnia_fft_plan_t * plan = omnia_fft_plan_create(len);
+
+        if ((re == NULL) || (im == NULL) || (plan == NULL))
+        {
+            omnia_free(re);
+            omnia_free(im);
+            omnia_fft_plan_free(plan);
+            return false;
+        }
+
+        memcpy(re, x, sizeof(double) * n);
+        omnia_fft_execute(plan, re, im, false);
+
+        // power spectrum
+        for (size_t i = 0; i < len; ++i)
+        {
+            re[i] = re[i] * re[i] + im[i] * im[i];
+            im[i] = 0.0;
+        }
+
+        omnia_fft_execute(plan, re, im, true);
+        memcpy(result, re, sizeof(double) * (lags + 1));
+
+        omnia_free(re);
+        omnia_free(im);
+        omnia_fft_plan_free(plan);
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const double xi = x[i];
+            const size_t top = (n - 1 - i < lags) ? n - 1 - i : lags;
+
+            for (size_t k = 0; k <= top; ++k)
+                result[k] += xi * x[i + k];
+        }
+    }
+
+    if (normalize && (result[0] > 0.0))
+    {
+        const double scale = 1.0 / result[0];
+
+        for (size_t k = 0; k <= lags; ++k)
+            result[k] *= scale;
+    }
+
+    return true;
+}
+
+// Cross-correlation
+bool omnia_cross_correlation(const double * x, const double * y, const size_t n, const size_t max_lag, const bool normalize, double * result)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_CROSS_CORRELATION, n);
+
+    if ((x == NULL) || (y == NULL) || (result == NULL) || (n == 0))
+        return false;
+
+    const size_t lags = (max_lag < n) ? max_lag : n - 1;
+    const size_t len = fft_length(n, lags);
+
+    // result[max_lag] is lag zero
+    double * r = result + max_lag;
+
+    for (size_t k = 0; k <= 2 * max_lag; ++k)
+        result[k] = 0.0;
+
+    if (prefer_fft(n, 2 * lags + 1, len, 2.0))
+    {
+        double * re = (double *)omnia_alloc_zero(len, sizeof(double));
+        double * im = (double *)omnia_alloc_zero(len, sizeof(double));
+        omnia_fft_plan_t * plan = omnia_fft_plan_create(len);
+
+        if ((re == NULL) || (im == NULL) || (plan == NULL))
+        {
+            omnia_free(re);
+            omnia_free(im);
+            omnia_fft_plan_free(plan);
+            return false;
+        }
+
+        // both real signals share one transform: z = x + iy
+        memcpy(re, x, sizeof(double) * n);
+        memcpy(im, y, sizeof(double) * n);
+        omnia_fft_execute(plan, re, im, false);
+
+        // separate X and Y from Z, and form conj(X) * Y; the result is
+        // Hermitian, so each pair of bins is written together
+        for (size_t i = 0; i <= len / 2; ++i)
+        {
+            const size_t j = (len - i) & (len - 1);
+            const double xr = 0.5 * (re[i] + re[j]);
+            const double xi = 0.5 * (im[i] - im[j]);
+            const double yr = 0.5 * (im[i] + im[j]);
+            const double yi = 0.5 * (re[j] - re[i]);
+            const double pr = xr * yr + xi * yi;
+            const double pi = xr * yi - xi * yr;
+
+            re[i] = pr;
+            im[i] = pi;
+            re[j] = pr;
+            im[j] = -pi;
+        }
+
+        omnia_fft_execute(plan, re, im, true);
+
+        r[0] = re[0];
+
+        for (size_t k = 1; k <= lags; ++k)
+        {
+            r[k] = re[k];
+            r[-(ptrdiff_t)k] = re[len - k];
+        }
+
+        omnia_free(re);
+        omnia_free(im);
+        omnia_fft_plan_free(plan);
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const double xi = x[i];
+
+            // lags k for which 0 <= i + k < n
+            const ptrdiff_t lo = (i < lags) ? -(ptrdiff_t)i : -(ptrdiff_t)lags;
+            const ptrdiff_t hi = (n - 1 - i < lags) ? (ptrdiff_t)(n - 1 - i) : (ptrdiff_t)lags;
+            const double * yi = y + i;
+
+            for (ptrdiff_t k = lo; k <= hi; ++k)
+                r[k] += xi * yi[k];
+        }
+    }
+
+    if (normalize)
+    {
+        double sxx = 0.0, syy = 0.0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            sxx += x[i] * x[i];
+            syy += y[i] * y[i];
+        }
+
+        if ((sxx > 0.0) && (syy > 0.0))
+        {
+            const double scale = 1.0 / sqrt(sxx * syy);
+
+            for (size_t k = 0; k <= 2 * max_lag; ++k)
+                result[k] *= scale;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,181 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include <stdlib.h>
+
+/*
+    Iterative radix-2 FFT over split real/imaginary arrays. The plan
+    stores the twiddle factors of each stage contiguously (the stage
+    with half-length h occupies entries h-1 through 2h-2), so that the
+    butterfly loop reads them with unit stride and vectorizes.
+*/
+
+struct omnia_fft_plan_s
+{
+    size_t n;
+    uint32_t * reverse;
+    double * tw_re;
+    double * tw_im;
+};
+
+// Create a plan for transforms of a given length
+omnia_fft_plan_t * omnia_fft_plan_create(const size_t n)
+{
+    omnia_fft_plan_t * plan = NULL;
+
+    // length must be a power of two
+    if ((n == 0) || ((n & (n - 1)) != 0) || (n > ((size_t)1 << 31)))
+        return NULL;
+
+    plan = (omnia_fft_plan_t *)omnia_alloc(sizeof(omnia_fft_plan_t));
+
+    if (plan == NULL)
+        return NULL;
+
+    plan->n = n;
+    plan->reverse = (uint32_t *)omnia_alloc(sizeof(uint32_t) * n);
+    plan->tw_re = (double *)omnia_alloc(sizeof(double) * n);
+    plan->tw_im = (double *)omnia_alloc(sizeof(double) * n);
+
+    if ((plan->reverse == NULL) || (plan->tw_re == NULL) || (plan->tw_im == NULL))
+    {
+        omnia_fft_plan_free(plan);
+        return NULL;
+    }
+
+    // bit-reversal permutation
+    const size_t bits = omnia_ilog2_size(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint32_t r = 0;
+
+        for (size_t b = 0; b < bits; ++b)
+            r |= (uint32_t)((i >> b) & 1) << (bits - 1 - b);
+
+        plan->reverse[i] = r;
+    }
+
+    // twiddle factors for each stage
+    for (size_t h = 1; h < n; h <<= 1)
+    {
+        for (size_t j = 0; j < h; ++j)
+        {
+            const double angle = -OMNIA_PI * (double)j / (double)h;
+            plan->tw_re[h - 1 + j] = cos(angle);
+            plan->tw_im[h - 1 + j] = sin(angle);
+        }
+    }
+
+    return plan;
+}
+
+// Release a plan
+void omnia_fft_plan_free(omnia_fft_plan_t * plan)
+{
+    if (plan != NULL)
+    {
+        omnia_free(plan->reverse);
+        omnia_free(plan->tw_re);
+        omnia_free(plan->tw_im);
+        omnia_free(plan);
+    }
+}
+
+// Length of the transforms performed by a plan
+size_t omnia_fft_plan_length(const omnia_fft_plan_t * plan)
+{
+    return (plan != NULL) ? plan->n : 0;
+}
+
+// Perform an in-place transform using a plan
+void omnia_fft_execute(const omnia_fft_plan_t * plan, double * re, double * im, const bool inverse)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_FFT_EXECUTE, plan->n);
+
+    const size_t n = plan->n;
+    const double sign = inverse ? -1.0 : 1.0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const size_t r = plan->reverse[i];
+
+        if (r > i)
+        {
+            double t = re[i];
+            re[i] = re[r];
+            re[r] = t;
+            t = im[i];
+            im[i] = im[r];
+            im[r] = t;
+        }
+    }
+
+    for (size_t h = 1; h < n; h <<= 1)
+    {
+        const double * wr = plan->tw_re + h - 1;
+        const double * wi = plan->tw_im + h - 1;
+
+        for (size_t base = 0; base < n; base += 2 * h)
+        {
+            double * ar = re + base;
+            double * ai = im + base;
+            double * br = ar + h;
+            double * bi = ai + h;
+
+            for (size_t j = 0; j < h; ++j)
+            {
+                const double twi = sign * wi[j];
+                const double tr = br[j] * wr[j] - bi[j] * twi;
+                const double ti = br[j] * twi + bi[j] * wr[j];
+                br[j] = ar[j] - tr;
+                bi[j] = ai[j] - ti;
+                ar[j] += tr;
+                ai[j] += ti;
+            }
+        }
+    }
+
+    if (inverse)
+    {
+        const double scale = 1.0 / (double)n;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            re[i] *= scale;
+            im[i] *= scale;
+        }
+    }
+}
+
+// Fast Fourier transform
+bool omnia_fft(double * re, double * im, const size_t n, const bool inverse)
+{
+    if ((re == NULL) || (im == NULL))
+        return false;
+
+    omnia_fft_plan_t * plan = omnia_fft_plan_create(n);
+
+    if (plan == NULL)
+        return false;
+
+    omnia_fft_execute(plan, re, im, inverse);
+    omnia_fft_plan_free(plan);
+
+    return true;
+}
@@ -0,0 +1,420 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    FIR filters keep the last (taps - 1) input samples between calls, so
+    chunked input produces exactly the same output as a single call.
+
+    Short kernels use the direct form: the input block is appended to
+    the history and each tap is applied across the whole block (tap in
+    the outer loop), which turns the inner loop into a vectorizable
+    multiply-add over contiguous memory.
+
+    Long kernels use overlap-save FFT convolution. Because the kernel is
+    real, two consecutive blocks are packed into the real and imaginary
+    parts of a single complex transform.
+*/
+
+// kernels longer than this are applied with FFT convolution
+#define FIR_FFT_THRESHOLD 64
+
+// number of samples processed per pass of the direct form
+#define FIR_DIRECT_BLOCK 1024
+
+struct omnia_fir_s
+{
+    size_t ntaps;
+    double * taps;          // reversed, so that output i is the dot product with work[i...]
+    double * work;          // history followed by the current input block
+    size_t block;           // input samples per pass
+
+    // FFT convolution only
+    omnia_fft_plan_t * plan;
+    double * kernel_re;
+    double * kernel_im;
+    double * buf_re;
+    double * buf_im;
+};
+
+// Create a FIR filter
+omnia_fir_t * omnia_fir_create(const double * taps, const size_t ntaps)
+{
+    omnia_fir_t * fir;
+
+    if ((taps == NULL) || (ntaps == 0))
+        return NULL;
+
+    fir = (omnia_fir_t *)omnia_alloc_zero(1, sizeof(omnia_fir_t));
+
+    if (fir == NULL)
+        return NULL;
+
+    fir->ntaps = ntaps;
+    fir->taps = (double *)omnia_alloc(sizeof(double) * ntaps);
+
+    if (fir->taps == NULL)
+    {
+        omnia_fir_free(fir);
+        return NULL;
+    }
+
+    for (size_t k = 0; k < ntaps; ++k)
+        fir->taps[k] = taps[ntaps - 1 - k];
+
+    if (ntaps <= FIR_FFT_THRESHOLD)
+        fir->block = FIR_DIRECT_BLOCK;
+    else
+    {
+        // transform length of at least four times the kernel keeps the overlap small
+        const size_t n = omnia_next_pow2_size(4 * ntaps);
+
+        fir->block = n - (ntaps - 1);
+        fir->plan = omnia_fft_plan_create(n);
+        fir->kernel_re = (double *)omnia_alloc_zero(n, sizeof(double));
+        fir->kernel_im = (double *)omnia_alloc_zero(n, sizeof(double));
+        fir->buf_re = (double *)omnia_alloc(sizeof(double) * n);
+        fir->buf_im = (double *)omnia_alloc(sizeof(double) * n);
+
+        if ((fir->plan == NULL) || (fir->kernel_re == NULL) || (fir->kernel_im == NULL)
+        ||  (fir->buf_re == NULL) || (fir->buf_im == NULL))
+        {
+            omnia_fir_free(fir);
+            return NULL;
+        }
+
+        memcpy(fir->kernel_re, taps, sizeof(double) * ntaps);
+        omnia_fft_execute(fir->plan, fir->kernel_re, fir->kernel_im, false);
+    }
+
+    // the FFT form consumes two blocks per transform
+    fir->work = (double *)omnia_alloc_zero(ntaps - 1 + 2 * fir->block, sizeof(double));
+
+    if (fir->work == NULL)
+    {
+        omnia_fir_free(fir);
+        return NULL;
+    }
+
+    return fir;
+}
+
+// Release a FIR filter
+void omnia_fir_free(omnia_fir_t * fir)
+{
+    if (fir != NULL)
+    {
+        omnia_free(fir->taps);
+        omnia_free(fir->work);
+        omnia_fft_plan_free(fir->plan);
+        omnia_free(fir->kernel_re);
+        omnia_free(fir->kernel_im);
+        omnia_free(fir->buf_re);
+        omnia_free(fir->buf_im);
+        omnia_free(fir);
+    }
+}
+
+// Clear the history of a FIR filter
+void omnia_fir_reset(omnia_fir_t * fir)
+{
+    if (fir != NULL)
+        memset(fir->work, 0, sizeof(double) * (fir->ntaps - 1));
+}
+
+// direct form for len samples already appended to the history
+static void fir_direct(const omnia_fir_t * fir, double * out, const size_t len)
+{
+    const double * w = fir->work;
+
+    for (size_t i = 0; i < len; ++i)
+        out[i] = 0.0;
+
+    for (size_t k = 0; k < fir->ntaps; ++k)
+    {
+        const double h = fir->taps[k];
+        const double * wk = w + k;
+
+        for (size_t i = 0; i < len; ++i)
+            out[i] += h * wk[i];
+    }
+}
+
+// overlap-save for len samples already appended to the history
+static void fir_fft(const omnia_fir_t * fir, double * out, const size_t len)
+{
+    const size_t n = omnia_fft_plan_length(fir->plan);
+    const size_t overlap = fir->ntaps - 1;
+    const size_t len_a = (len < fir->block) ? len : fir->block;
+    const size_t len_b = len - len_a;
+    double * re = fir->buf_re;
+    double * im = fir->buf_im;
+
+    // first block in the real part, second in the imaginary part
+    memcpy(re, fir->work, sizeof(double) * (overlap + len_a));
+    memset(re + overlap + len_a, 0, sizeof(double) * (n - overlap - len_a));
+
+    if (len_b > 0)
+    {
+        memcpy(im, fir->work + len_a, sizeof(double) * (overlap + len_b));
+        memset(im + overlap + len_b, 0, sizeof(double) * (n - overlap - len_b));
+    }
+    else
+        memset(im, 0, sizeof(double) * n);
+
+    omnia_fft_execute(fir->plan, re, im, false);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double r = re[i] * fir->kernel_re[i] - im[i] * fir->kernel_im[i];
+        const double j = re[i] * fir->kernel_im[i] + im[i] * fir->kernel_re[i];
+        re[i] = r;
+        im[i] = j;
+    }
+
+    omnia_fft_execute(fir->plan, re, im, true);
+
+    // the first (taps - 1) outputs of each block are circular wrap-around
+    memcpy(out, re + overlap, sizeof(double) * len_a);
+
+    if (len_b > 0)
+        memcpy(out + len_a, im + overlap, sizeof(double) * len_b);
+}
+
+// Apply a FIR filter to a block of samples
+void omnia_fir_process(omnia_fir_t * fir, const double * in, double * out, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_FIR_PROCESS, n);
+
+    const size_t overlap = fir->ntaps - 1;
+    const size_t chunk = (fir->plan != NULL) ? 2 * fir->block : fir->block;
+
+    for (size_t pos = 0; pos < n; pos += chunk)
+    {
+        const size_t len = (n - pos < chunk) ? n - pos : chunk;
+
+        // copying the input first allows in-place filtering
+        memcpy(fir->work + overlap, in + pos, sizeof(double) * len);
+
+        if (fir->plan != NULL)
+            fir_fft(fir, out + pos, len);
+        else
+            fir_direct(fir, out + pos, len);
+
+        memmove(fir->work, fir->work + len, sizeof(double) * overlap);
+    }
+}
+
+// Design a windowed-sinc FIR filter
+bool omnia_fir_design(double * taps, const size_t ntaps, const omnia_filter_type_t type, const double f1, const double f2)
+{
+    if ((taps == NULL) || (ntaps == 0) || (f1 <= 0.0) || (f1 >= 0.5))
+        return false;
+
+    // spectral inversion needs a center tap
+    if ((type == OMNIA_FILTER_HIGHPASS) && ((ntaps & 1) == 0))
+        return false;
+
+    if ((type == OMNIA_FILTER_BANDPASS) && ((f2 <= f1) || (f2 >= 0.5)))
+        return false;
+
+    const double mid = 0.5 * (double)(ntaps - 1);
+    const double lo = (type == OMNIA_FILTER_BANDPASS) ? f1 : 0.0;
+    const double hi = (type == OMNIA_FILTER_BANDPASS) ? f2 : f1;
+    double gain = 0.0;
+
+    for (size_t k = 0; k < ntaps; ++k)
+    {
+        const double t = (double)k - mid;
+        double h;
+
+        // difference of two ideal low-pass responses, lo may be zero
+        if (t == 0.0)
+            h = 2.0 * (hi - lo);
+        else
+            h = (sin(2.0 * OMNIA_PI * hi * t) - sin(2.0 * OMNIA_PI * lo * t)) / (OMNIA_PI * t);
+
+        // Blackman window
+        if (ntaps > 1)
+        {
+            const double phase = 2.0 * OMNIA_PI * (double)k / (double)(ntaps - 1);
+            h *= 0.42 - 0.5 * cos(phase) + 0.08 * cos(2.0 * phase);
+        }
+
+        taps[k] = h;
+        gain += h;
+    }
+
+    switch (type)
+    {
+        case OMNIA_FILTER_LOWPASS:
+            // unity gain at DC
+            for (size_t k = 0; k < ntaps; ++k)
+                taps[k] /= gain;
+            break;
+
+        case OMNIA_FILTER_HIGHPASS:
+            // all-pass minus low-pass
+            for (size_t k = 0; k < ntaps; ++k)
+                taps[k] = -taps[k] / gain;
+
+            taps[ntaps / 2] += 1.0;
+            break;
+
+        case OMNIA_FILTER_BANDPASS:
+            break;
+    }
+
+    return true;
+}
+
+/*
+    Biquad sections use the transposed direct form II. A cascade runs
+    each section over the whole block before moving to the next, which
+    keeps each recurrence in a tight loop with its state in registers.
+*/
+
+// Design a biquad section
+bool omnia_biquad_design(omnia_biquad_t * bq, const omnia_filter_type_t type, const double frequency, const double q)
+{
+    if ((bq == NULL) || (frequency <= 0.0) || (frequency >= 0.5) || (q <= 0.0))
+        return false;
+
+    // coefficients from Robert Bristow-Johnson's "Audio EQ Cookbook"
+    const double w0 = 2.0 * OMNIA_PI * frequency;
+    const double cw = cos(w0);
+    const double alpha = sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+
+    switch (type)
+    {
+        case OMNIA_FILTER_LOWPASS:
+            bq->b0 = (1.0 - cw) / 2.0;
+            bq->b1 = 1.0 - cw;
+            bq->b2 = (1.0 - cw) / 2.0;
+            break;
+
+        case OMNIA_FILTER_HIGHPASS:
+            bq->b0 = (1.0 + cw) / 2.0;
+            bq->b1 = -(1.0 + cw);
+            bq->b2 = (1.0 + cw) / 2.0;
+            break;
+
+        case OMNIA_FILTER_BANDPASS:
+            bq->b0 = alpha;
+            bq->b1 = 0.0;
+            bq->b2 = -alpha;
+            break;
+
+        default:
+            return false;
+    }
+
+    bq->b0 /= a0;
+    bq->b1 /= a0;
+    bq->b2 /= a0;
+    bq->a1 = -2.0 * cw / a0;
+    bq->a2 = (1.0 - alpha) / a0;
+
+    return true;
+}
+
+struct omnia_iir_s
+{
+    size_t nsections;
+    omnia_biquad_t * sections;
+    double * state;         // two delay elements per section
+};
+
+// Create a cascade of biquad sections
+omnia_iir_t * omnia_iir_create(const omnia_biquad_t * sections, const size_t nsections)
+{
+    omnia_iir_t * iir;
+
+    if ((sections == NULL) || (nsections == 0))
+        return NULL;
+
+    iir = (omnia_iir_t *)omnia_alloc(sizeof(omnia_iir_t));
+
+    if (iir == NULL)
+        return NULL;
+
+    iir->nsections = nsections;
+    iir->sections = (omnia_biquad_t *)omnia_alloc(sizeof(omnia_biquad_t) * nsections);
+    iir->state = (double *)omnia_alloc_zero(2 * nsections, sizeof(double));
+
+    if ((iir->sections == NULL) || (iir->state == NULL))
+    {
+        omnia_iir_free(iir);
+        return NULL;
+    }
+
+    memcpy(iir->sections, sections, sizeof(omnia_biquad_t) * nsections);
+
+    return iir;
+}
+
+// Release a biquad cascade
+void omnia_iir_free(omnia_iir_t * iir)
+{
+    if (iir != NULL)
+    {
+        omnia_free(iir->sections);
+        omnia_free(iir->state);
+        omnia_free(iir);
+    }
+}
+
+// Clear the state of a biquad cascade
+void omnia_iir_reset(omnia_iir_t * iir)
+{
+    if (iir != NULL)
+        memset(iir->state, 0, sizeof(double) * 2 * iir->nsections);
+}
+
+// Apply a biquad cascade to a block of samples
+void omnia_iir_process(omnia_iir_t * iir, const double * in, double * out, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_IIR_PROCESS, n);
+
+    const double * src = in;
+
+    for (size_t s = 0; s < iir->nsections; ++s)
+    {
+        const omnia_biquad_t bq = iir->sections[s];
+        double z1 = iir->state[2 * s];
+        double z2 = iir->state[2 * s + 1];
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const double x = src[i];
+            const double y = bq.b0 * x + z1;
+            z1 = bq.b1 * x - bq.a1 * y + z2;
+            z2 = bq.b2 * x - bq.a2 * y;
+            out[i] = y;
+        }
+
+        iir->state[2 * s] = z1;
+        iir->state[2 * s + 1] = z2;
+
+        // later sections work in place on the output
+        src = out;
+    }
+}
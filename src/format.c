@@ -0,0 +1,704 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include "format_tables.h"
+#include <string.h>
+
+/*
+    Shortest round-trip conversion of doubles to decimal, following
+    Ulf Adams' Ryu algorithm ("Ryu: fast float-to-string conversion",
+    PLDI 2018). The binary value and the bounds of its rounding interval
+    are multiplied by a 128-bit approximation of a power of five, and
+    decimal digits are removed until the interval would no longer
+    contain a unique shortest representation.
+
+    Text is produced with the same layout rules as printf's %g, but
+    without locale lookups and without printf's parsing overhead.
+*/
+
+#define DOUBLE_MANTISSA_BITS 52
+#define DOUBLE_EXPONENT_BITS 11
+#define DOUBLE_BIAS 1023
+
+// decimal digits
+typedef struct
+{
+    uint64_t mantissa;
+    int32_t exponent;
+}
+decimal_t;
+
+// ceil(log2(5^e)) for e > 0, or 1 for e == 0
+static inline int32_t pow5bits(const int32_t e)
+{
+    return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+// floor(log10(2^e))
+static inline uint32_t log10_pow2(const int32_t e)
+{
+    return ((uint32_t)e * 78913) >> 18;
+}
+
+// floor(log10(5^e))
+static inline uint32_t log10_pow5(const int32_t e)
+{
+    return ((uint32_t)e * 732923) >> 20;
+}
+
+static inline uint32_t pow5_factor(uint64_t value)
+{
+    uint32_t count = 0;
+
+    while (value % 5 == 0)
+    {
+        value /= 5;
+        ++count;
+    }
+
+    return count;
+}
+
+static inline bool multiple_of_pow5(const uint64_t value, const uint32_t p)
+{
+    return pow5_factor(value) >= p;
+}
+
+static inline bool multiple_of_pow2(const uint64_t value, const uint32_t p)
+{
+    return (value & ((1ULL << p) - 1)) == 0;
+}
+
+// (m * mul) >> j, where mul is a 128-bit table entry and j >= 64
+static inline uint64_t mul_shift(const uint64_t m, const uint64_t * mul, const int32_t j)
+{
+    const uint128_t b0 = (uint128_t)m * mul[0];
+    const uint128_t b2 = (uint128_t)m * mul[1];
+
+    return (uint64_t)(((b0 >> 64) + b2) >> (j - 64));
+}
+
+// shortest decimal representation of a finite, non-zero double
+static decimal_t shortest(const uint64_t ieee_mantissa, const uint32_t ieee_exponent)
+{
+    int32_t e2;
+    uint64_t m2;
+
+    if (ieee_exponent == 0)
+    {
+        e2 = 1 - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+        m2 = ieee_mantissa;
+    }
+    else
+    {
+        e2 = (int32_t)ieee_exponent - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+        m2 = (1ULL << DOUBLE_MANTISSA_BITS) | ieee_mantissa;
+    }
+
+    const bool accept_bounds = (m2 & 1) == 0;
+
+    // the value and the bounds of its rounding interval, times four
+    const uint64_t mv = 4 * m2;
+    const uint32_t mm_shift = (ieee_mantissa != 0) || (ieee_exponent <= 1);
+
+    uint64_t vr, vp, vm;
+    int32_t e10;
+    bool vm_trailing_zeros = false;
+    bool vr_trailing_zeros = false;
+
+    if (e2 >= 0)
+    {
+        const uint32_t q = log10_pow2(e2) - (e2 > 3);
+        const int32_t k = POW5_INV_BITCOUNT + pow5bits((int32_t)q) - 1;
+        const int32_t i = -e2 + (int32_t)q + k;
+
+        e10 = (int32_t)q;
+        vr = mul_shift(mv, POW5_INV_SPLIT[q], i);
+        vp = mul_shift(mv + 2, POW5_INV_SPLIT[q], i);
+        vm = mul_shift(mv - 1 - mm_shift, POW5_INV_SPLIT[q], i);
+
+        if (q <= 21)
+        {
+            // only one of mp, mv and mm can be a multiple of 5, if any
+            if (mv % 5 == 0)
+                vr_trailing_zeros = multiple_of_pow5(mv, q);
+            else if (accept_bounds)
+                vm_trailing_zeros = multiple_of_pow5(mv - 1 - mm_shift, q);
+            else
+                vp -= multiple_of_pow5(mv + 2, q);
+        }
+    }
+    else
+    {
+        const uint32_t q = log10_pow5(-e2) - (-e2 > 1);
+        const int32_t i = -e2 - (int32_t)q;
+        const int32_t k = pow5bits(i) - POW5_BITCOUNT;
+        const int32_t j = (int32_t)q - k;
+
+        e10 = (int32_t)q + e2;
+        vr = mul_shift(mv, POW5_SPLIT[i], j);
+        vp = mul_shift(mv + 2, POW5_SPLIT[i], j);
+        vm = mul_shift(mv - 1 - mm_shift, POW5_SPLIT[i], j);
+
+        if (q <= 1)
+        {
+            // mv has at least q trailing zero bits, so vr is exact
+            vr_trailing_zeros = true;
+
+            if (accept_bounds)
+                vm_trailing_zeros = (mm_shift == 1);
+            else
+                --vp;
+        }
+        else if (q < 63)
+            vr_trailing_zeros = multiple_of_pow2(mv, q);
+    }
+
+    // remove digits while the interval still holds a shorter representation
+    int32_t removed = 0;
+    uint32_t last_removed = 0;
+    uint64_t output;
+
+    if (vm_trailing_zeros || vr_trailing_zeros)
+    {
+        // general case, which tracks exactness for the rounding decision
+        while (vp / 10 > vm / 10)
+        {
+            vm_trailing_zeros &= (vm % 10 == 0);
+            vr_trailing_zeros &= (last_removed == 0);
+            last_removed = (uint32_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+
+        if (vm_trailing_zeros)
+        {
+            while (vm % 10 == 0)
+            {
+                vr_trailing_zeros &= (last_removed == 0);
+                last_removed = (uint32_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+        }
+
+        // exactly halfway: round to even
+        if (vr_trailing_zeros && (last_removed == 5) && (vr % 2 == 0))
+            last_removed = 4;
+
+        output = vr + (((vr == vm) && (!accept_bounds || !vm_trailing_zeros)) || (last_removed >= 5));
+    }
+    else
+    {
+        // common case, with two digits removed at once where possible
+        bool round_up = false;
+
+        if (vp / 100 > vm / 100)
+        {
+            round_up = (vr % 100) >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+
+        while (vp / 10 > vm / 10)
+        {
+            round_up = (vr % 10) >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+
+        output = vr + ((vr == vm) || round_up);
+    }
+
+    decimal_t result;
+    result.mantissa = output;
+    result.exponent = e10 + removed;
+
+    return result;
+}
+
+// number of decimal digits in a value below 10^17
+static inline int decimal_length(const uint64_t v)
+{
+    uint64_t p = 10;
+    int length = 1;
+
+    while ((length < 17) && (v >= p))
+    {
+        p *= 10;
+        ++length;
+    }
+
+    return length;
+}
+
+static const uint64_t POW10[18] =
+{
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL
+};
+
+static const char DIGIT_PAIRS[200] =
+{
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+// write the length decimal digits of v, two at a time
+static inline void write_digits(char * p, uint64_t v, int length)
+{
+    while (length >= 2)
+    {
+        const uint32_t pair = (uint32_t)(v % 100) * 2;
+        v /= 100;
+        length -= 2;
+        p[length] = DIGIT_PAIRS[pair];
+        p[length + 1] = DIGIT_PAIRS[pair + 1];
+    }
+
+    if (length == 1)
+        p[0] = (char)('0' + v);
+}
+
+// lay out digits in %g style with the given precision; returns the length
+static size_t write_decimal(char * buffer, const bool negative, uint64_t mantissa, int32_t exponent, const int precision)
+{
+    char digits[20];
+    char * p = buffer;
+
+    // printf's %g drops trailing zeros
+    while ((mantissa % 10 == 0) && (mantissa != 0))
+    {
+        mantissa /= 10;
+        ++exponent;
+    }
+
+    const int length = decimal_length(mantissa);
+    const int32_t sci = exponent + length - 1;
+
+    write_digits(digits, mantissa, length);
+
+    if (negative)
+        *p++ = '-';
+
+    if ((sci < -4) || (sci >= precision))
+    {
+        // d.ddde+XX
+        *p++ = digits[0];
+
+        if (length > 1)
+        {
+            *p++ = '.';
+            memcpy(p, digits + 1, (size_t)(length - 1));
+            p += length - 1;
+        }
+
+        *p++ = 'e';
+        *p++ = (sci < 0) ? '-' : '+';
+
+        const int32_t e = (sci < 0) ? -sci : sci;
+
+        if (e >= 100)
+        {
+            *p++ = (char)('0' + e / 100);
+            *p++ = DIGIT_PAIRS[(e % 100) * 2];
+            *p++ = DIGIT_PAIRS[(e % 100) * 2 + 1];
+        }
+        else
+        {
+            *p++ = DIGIT_PAIRS[e * 2];
+            *p++ = DIGIT_PAIRS[e * 2 + 1];
+        }
+    }
+    else if (sci < 0)
+    {
+        // 0.000ddd
+        *p++ = '0';
+        *p++ = '.';
+
+        for (int32_t i = -1; i > sci; --i)
+            *p++ = '0';
+
+        memcpy(p, digits, (size_t)length);
+        p += length;
+    }
+    else if (sci >= length - 1)
+    {
+        // ddd000
+        memcpy(p, digits, (size_t)length);
+        p += length;
+
+        for (int32_t i = length - 1; i < sci; ++i)
+            *p++ = '0';
+    }
+    else
+    {
+        // ddd.ddd
+        memcpy(p, digits, (size_t)(sci + 1));
+        p += sci + 1;
+        *p++ = '.';
+        memcpy(p, digits + sci + 1, (size_t)(length - sci - 1));
+        p += length - sci - 1;
+    }
+
+    *p = '\0';
+
+    return (size_t)(p - buffer);
+}
+
+// text for zero, infinity and NaN; returns zero for other values
+static size_t write_special(char * buffer, const bool negative, const uint64_t ieee_mantissa, const uint32_t ieee_exponent)
+{
+    const char * text;
+
+    if (ieee_exponent == ((1u << DOUBLE_EXPONENT_BITS) - 1))
+        text = (ieee_mantissa != 0) ? "nan" : (negative ? "-inf" : "inf");
+    else if ((ieee_exponent == 0) && (ieee_mantissa == 0))
+        text = negative ? "-0" : "0";
+    else
+        return 0;
+
+    const size_t length = strlen(text);
+    memcpy(buffer, text, length + 1);
+
+    return length;
+}
+
+/*
+    Rounding the shortest digits again to fewer digits is double rounding,
+    which can differ from rounding the exact binary value as printf does:
+    0.15 is shortest as "15" but lies just below 0.15, so %.1g gives 0.1.
+    The shortest digits are safe to round when they are at least two
+    digits longer than asked for, since a rounding midpoint between them
+    and the exact value would itself be a shorter representation inside
+    the rounding interval; and safe to use as they are when they fit and
+    the double is normal, since then the requested digits are spaced more
+    widely than the binary values for up to 15 digits. Everything else is
+    computed from the exact value with big-integer arithmetic.
+*/
+
+// enough 32-bit limbs for m * 5^p * 2^63, the largest value divided below
+#define BIG_LIMBS 40
+
+typedef struct
+{
+    uint32_t limb[BIG_LIMBS];   // least significant first
+    int count;                  // limbs in use
+}
+big_t;
+
+static void big_set(big_t * a, const uint64_t v)
+{
+    a->limb[0] = (uint32_t)v;
+    a->limb[1] = (uint32_t)(v >> 32);
+    a->count = (a->limb[1] != 0) ? 2 : 1;
+}
+
+static void big_mul_small(big_t * a, const uint32_t m)
+{
+    uint64_t carry = 0;
+
+    for (int i = 0; i < a->count; ++i)
+    {
+        carry += (uint64_t)a->limb[i] * m;
+        a->limb[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+
+    if (carry != 0)
+        a->limb[a->count++] = (uint32_t)carry;
+}
+
+static void big_mul_pow5(big_t * a, int32_t p)
+{
+    // 5^13 is the largest power of five below 2^32
+    for (; p >= 13; p -= 13)
+        big_mul_small(a, 1220703125U);
+
+    if (p > 0)
+        big_mul_small(a, (uint32_t)(POW10[p] >> p));
+}
+
+static void big_shift_left(big_t * a, const int32_t bits)
+{
+    const int words = bits / 32;
+    const int shift = bits % 32;
+
+    a->limb[a->count] = 0;
+
+    for (int i = a->count; i >= 0; --i)
+    {
+        uint32_t v = a->limb[i] << shift;
+
+        if ((shift != 0) && (i > 0))
+            v |= a->limb[i - 1] >> (32 - shift);
+
+        a->limb[i + words] = v;
+    }
+
+    for (int i = 0; i < words; ++i)
+        a->limb[i] = 0;
+
+    a->count += words + 1;
+
+    while ((a->count > 1) && (a->limb[a->count - 1] == 0))
+        --a->count;
+}
+
+static void big_shift_right1(big_t * a)
+{
+    for (int i = 0; i < a->count - 1; ++i)
+        a->limb[i] = (a->limb[i] >> 1) | (a->limb[i + 1] << 31);
+
+    a->limb[a->count - 1] >>= 1;
+
+    if ((a->count > 1) && (a->limb[a->count - 1] == 0))
+        --a->count;
+}
+
+static int big_compare(const big_t * a, const big_t * b)
+{
+    if (a->count != b->count)
+        return (a->count < b->count) ? -1 : 1;
+
+    for (int i = a->count - 1; i >= 0; --i)
+        if (a->limb[i] != b->limb[i])
+            return (a->limb[i] < b->limb[i]) ? -1 : 1;
+
+    return 0;
+}
+
+// a -= b, for a >= b
+static void big_subtract(big_t * a, const big_t * b)
+{
+    int64_t borrow = 0;
+
+    for (int i = 0; i < a->count; ++i)
+    {
+        borrow += (int64_t)a->limb[i] - ((i < b->count) ? b->limb[i] : 0);
+        a->limb[i] = (uint32_t)borrow;
+        borrow >>= 32;
+    }
+
+    while ((a->count > 1) && (a->limb[a->count - 1] == 0))
+        --a->count;
+}
+
+// floor(x * 10^p) for x = m * 2^e and a result below 2^63; *half compares the fraction with one half
+static uint64_t scaled_floor(const uint64_t m, const int32_t e, const int32_t p, int * half)
+{
+    big_t num, den;
+    const int32_t s = e + p;
+
+    big_set(&num, m);
+    big_set(&den, 1);
+
+    if (p >= 0)
+        big_mul_pow5(&num, p);
+    else
+        big_mul_pow5(&den, -p);
+
+    if (s >= 0)
+        big_shift_left(&num, s);
+    else
+        big_shift_left(&den, -s);
+
+    // restoring division, one quotient bit at a time
+    uint64_t q = 0;
+    big_shift_left(&den, 63);
+
+    for (int bit = 63; bit >= 0; --bit)
+    {
+        if (big_compare(&num, &den) >= 0)
+        {
+            big_subtract(&num, &den);
+            q |= 1ULL << bit;
+        }
+
+        if (bit > 0)
+            big_shift_right1(&den);
+    }
+
+    // compare twice the remainder with the divisor
+    big_shift_left(&num, 1);
+    *half = big_compare(&num, &den);
+
+    return q;
+}
+
+// the exact value of a finite, non-zero double rounded to digits significant digits
+static decimal_t exact_digits(const uint64_t ieee_mantissa, const uint32_t ieee_exponent, const int digits, int32_t sci)
+{
+    const uint64_t m = (ieee_exponent == 0) ? ieee_mantissa : ((1ULL << DOUBLE_MANTISSA_BITS) | ieee_mantissa);
+    const int32_t e = ((ieee_exponent == 0) ? 1 : (int32_t)ieee_exponent) - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS;
+    decimal_t d;
+    int half;
+
+    // sci, from the shortest digits, may be one too high or too low
+    for (;;)
+    {
+        d.mantissa = scaled_floor(m, e, digits - 1 - sci, &half);
+        d.exponent = sci + 1 - digits;
+
+        if (d.mantissa < POW10[digits - 1])
+            --sci;
+        else if (d.mantissa >= POW10[digits])
+            ++sci;
+        else
+            break;
+    }
+
+    // half to even, as printf rounds in the default rounding mode
+    if ((half > 0) || ((half == 0) && (d.mantissa & 1)))
+        ++d.mantissa;
+
+    // 9.99... rounded up to 10.0
+    if (d.mantissa == POW10[digits])
+    {
+        d.mantissa = POW10[digits - 1];
+        ++d.exponent;
+    }
+
+    return d;
+}
+
+// common implementation; digits of zero asks for the shortest representation
+static size_t format(const double x, const uint16_t digits, char * buffer)
+{
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    const bool negative = (bits >> 63) != 0;
+    const uint64_t ieee_mantissa = bits & ((1ULL << DOUBLE_MANTISSA_BITS) - 1);
+    const uint32_t ieee_exponent = (uint32_t)((bits >> DOUBLE_MANTISSA_BITS) & ((1u << DOUBLE_EXPONENT_BITS) - 1));
+
+    size_t length = write_special(buffer, negative, ieee_mantissa, ieee_exponent);
+
+    if (length > 0)
+        return length;
+
+    decimal_t d = shortest(ieee_mantissa, ieee_exponent);
+
+    if ((digits == 0) || (digits >= 17))
+        return write_decimal(buffer, negative, d.mantissa, d.exponent, 17);
+
+    const int length10 = decimal_length(d.mantissa);
+
+    if (length10 >= digits + 2)
+    {
+        // round the shortest representation; see above for why this is exact
+        const int drop = length10 - digits;
+        const uint64_t divisor = POW10[drop];
+        uint64_t q = d.mantissa / divisor;
+        const uint64_t r = d.mantissa % divisor;
+
+        if (r != divisor / 2)
+        {
+            if (r > divisor / 2)
+                ++q;
+
+            d.mantissa = q;
+            d.exponent += drop;
+            return write_decimal(buffer, negative, d.mantissa, d.exponent, digits);
+        }
+    }
+    else if ((length10 <= digits) && (digits <= 15) && (ieee_exponent != 0))
+        return write_decimal(buffer, negative, d.mantissa, d.exponent, digits);
+
+    d = exact_digits(ieee_mantissa, ieee_exponent, digits, d.exponent + length10 - 1);
+
+    return write_decimal(buffer, negative, d.mantissa, d.exponent, digits);
+}
+
+// Format a double as the shortest text that reads back to the same value
+size_t omnia_format_double(const double x, char * buffer)
+{
+    return format(x, 0, buffer);
+}
+
+// Format a double with a number of significant digits
+size_t omnia_format_sigdig(const double x, const uint16_t digits, char * buffer)
+{
+    return format(x, digits, buffer);
+}
+
+// Format an array of doubles as delimited text
+size_t omnia_format_array(const double * x, const size_t n, const uint16_t digits, const char separator, char * buffer, const size_t size, size_t * written)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_FORMAT_ARRAY, n);
+
+    char temp[OMNIA_FORMAT_BUFFER_SIZE];
+    size_t count = 0;
+    size_t pos = 0;
+
+    if ((x != NULL) && (buffer != NULL) && (size > 0))
+    {
+        for (count = 0; count < n; ++count)
+        {
+            const size_t sep = (count > 0) ? 1 : 0;
+
+            // format in place when there is certainly room
+            if (size - pos > OMNIA_FORMAT_BUFFER_SIZE + sep)
+            {
+                if (sep)
+                    buffer[pos++] = separator;
+
+                pos += format(x[count], digits, buffer + pos);
+            }
+            else
+            {
+                const size_t length = format(x[count], digits, temp);
+
+                // the terminating null must fit, too
+                if (pos + sep + length >= size)
+                    break;
+
+                if (sep)
+                    buffer[pos++] = separator;
+
+                memcpy(buffer + pos, temp, length);
+                pos += length;
+            }
+        }
+
+        buffer[pos] = '\0';
+    }
+
+    if (written != NULL)
+        *written = pos;
+
+    return count;
+}
@@ -15,7 +15,7 @@
     License), the text of which is available at the website above. 
 */
 
-#include "omnia.h"
+#include "omnia_internal.h"
 
 // lowest common denominator
 uint64_t omnia_lcm(const uint64_t x, const uint64_t y)
@@ -33,17 +33,259 @@ uint64_t omnia_lcm(const uint64_t x, const uint64_t y)
     return result;
 }
 
-// greatest common multiple
-uint64_t omnia_gcf(uint64_t x, uint64_t y)
+// lowest common multiple with overflow detection
+uint64_t omnia_lcm_checked(const uint64_t x, const uint64_t y, bool * overflow)
 {
-    uint64_t temp;
+    uint64_t result = 0;
+    bool over = false;
+
+    if ((x != 0) && (y != 0))
+    {
+        const uint128_t product = (uint128_t)(x / omnia_gcf(x, y)) * y;
+
+        if ((product >> 64) != 0)
+            over = true;
+        else
+            result = (uint64_t)product;
+    }
+
+    if (overflow != NULL)
+        *overflow = over;
+
+    return result;
+}
+
+/*
+    Reductions keep four independent running values, so that the
+    processor can overlap their dependency chains. A new value far
+    larger than the running GCD is first reduced with one division,
+    which is cheaper than the many subtract-and-shift steps the binary
+    algorithm would need to close the gap.
+
+    Long arrays are split into chunks for omnia_parallel_run. Each chunk
+    keeps its own partial result, and the partials are combined in order
+    once every chunk is done. A chunk that settles the answer (a GCD of
+    one, or the first zero or overflow of an LCM) raises a flag, and
+    chunks that start later skip work whose result can no longer matter.
+*/
+
+// most chunks a reduction is split into
+#define MAX_PARTIALS 256
+
+// fold one value into a running GCD
+static inline uint64_t gcf_step(const uint64_t g, uint64_t v)
+{
+    if ((g != 0) && ((v >> 32) > g))
+        v %= g;
+
+    return omnia_gcf(g, v);
+}
+
+// a GCD reduction in progress
+typedef struct
+{
+    const uint64_t * a;
+    size_t grain;
+    bool one;                       // some chunk reached 1
+    uint64_t partial[MAX_PARTIALS];
+}
+gcf_job_t;
 
-    while (y != 0)
+// GCD of the elements [begin, end)
+static void gcf_range(const size_t begin, const size_t end, void * data)
+{
+    gcf_job_t * job = (gcf_job_t *)data;
+    const uint64_t * a = job->a;
+    uint64_t g0 = 0, g1 = 0, g2 = 0, g3 = 0;
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4)
     {
-        temp = x % y;
-        x = y;
-        y = temp;
+        g0 = gcf_step(g0, a[i]);
+        g1 = gcf_step(g1, a[i + 1]);
+        g2 = gcf_step(g2, a[i + 2]);
+        g3 = gcf_step(g3, a[i + 3]);
+
+        // nothing can reduce a GCD of one
+        if ((g0 == 1) | (g1 == 1) | (g2 == 1) | (g3 == 1) | __atomic_load_n(&job->one, __ATOMIC_RELAXED))
+        {
+            __atomic_store_n(&job->one, true, __ATOMIC_RELAXED);
+            job->partial[begin / job->grain] = 1;
+            return;
+        }
     }
 
-    return x;
+    for (; i < end; ++i)
+        g0 = gcf_step(g0, a[i]);
+
+    job->partial[begin / job->grain] = omnia_gcf(omnia_gcf(g0, g1), omnia_gcf(g2, g3));
+}
+
+// Greatest common factor of an array of values
+uint64_t omnia_gcf_array(const uint64_t * a, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_GCF_ARRAY, n);
+
+    if ((a == NULL) || (n == 0))
+        return 0;
+
+    gcf_job_t job;
+
+    job.a = a;
+    job.grain = omnia_parallel_grain(n, MAX_PARTIALS);
+    job.one = false;
+
+    omnia_parallel_run(n, job.grain, gcf_range, &job);
+
+    const size_t chunks = (n - 1) / job.grain + 1;
+    uint64_t g = 0;
+
+    for (size_t i = 0; (i < chunks) && (g != 1); ++i)
+        g = omnia_gcf(g, job.partial[i]);
+
+    return g;
+}
+
+// how an LCM chunk ended
+typedef struct
+{
+    uint64_t lcm;       // of the elements before any zero
+    bool zero;          // the chunk holds a zero
+    bool overflow;      // the elements before any zero overflow by themselves
+}
+lcm_partial_t;
+
+// an LCM reduction in progress
+typedef struct
+{
+    const uint64_t * a;
+    size_t grain;
+    size_t stop;                    // lowest chunk that ended early, or SIZE_MAX
+    lcm_partial_t partial[MAX_PARTIALS];
+}
+lcm_job_t;
+
+// LCM of the elements [begin, end), up to the first zero
+static void lcm_range(const size_t begin, const size_t end, void * data)
+{
+    lcm_job_t * job = (lcm_job_t *)data;
+    const size_t chunk = begin / job->grain;
+    lcm_partial_t * part = &job->partial[chunk];
+
+    part->lcm = 1;
+    part->zero = false;
+    part->overflow = false;
+
+    // a zero or overflow in an earlier chunk decides the result
+    if (__atomic_load_n(&job->stop, __ATOMIC_RELAXED) < chunk)
+        return;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (job->a[i] == 0)
+            part->zero = true;
+        else
+            part->lcm = omnia_lcm_checked(part->lcm, job->a[i], &part->overflow);
+
+        if (part->zero || part->overflow)
+        {
+            size_t stop = __atomic_load_n(&job->stop, __ATOMIC_RELAXED);
+
+            while ((chunk < stop) && !__atomic_compare_exchange_n(&job->stop, &stop, chunk, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                ;
+
+            return;
+        }
+    }
+}
+
+// Lowest common multiple of an array of values
+uint64_t omnia_lcm_array(const uint64_t * a, const size_t n, bool * overflow)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_LCM_ARRAY, n);
+
+    uint64_t result = 0;
+    bool over = false;
+
+    if ((a != NULL) && (n != 0))
+    {
+        lcm_job_t job;
+
+        job.a = a;
+        job.grain = omnia_parallel_grain(n, MAX_PARTIALS);
+        job.stop = SIZE_MAX;
+
+        omnia_parallel_run(n, job.grain, lcm_range, &job);
+
+        // in order, stopping where a serial scan would: at the first zero, or once the LCM overflows
+        const size_t chunks = (n - 1) / job.grain + 1;
+        result = 1;
+
+        for (size_t i = 0; i < chunks; ++i)
+        {
+            const lcm_partial_t * part = &job.partial[i];
+
+            if (part->overflow)
+                over = true;
+            else
+                result = omnia_lcm_checked(result, part->lcm, &over);
+
+            if (over || part->zero)
+            {
+                result = 0;
+                break;
+            }
+        }
+    }
+
+    if (overflow != NULL)
+        *overflow = over;
+
+    return result;
+}
+
+// a pairwise GCD in progress
+typedef struct
+{
+    const uint64_t * a;
+    const uint64_t * b;
+    uint64_t * result;
+}
+pairwise_job_t;
+
+// pairwise GCDs of the elements [begin, end)
+static void pairwise_range(const size_t begin, const size_t end, void * data)
+{
+    const pairwise_job_t * job = (const pairwise_job_t *)data;
+    const uint64_t * a = job->a;
+    const uint64_t * b = job->b;
+    uint64_t * result = job->result;
+    size_t i = begin;
+
+    // independent pairs, unrolled so their dependency chains overlap
+    for (; i + 4 <= end; i += 4)
+    {
+        const uint64_t r0 = omnia_gcf(a[i], b[i]);
+        const uint64_t r1 = omnia_gcf(a[i + 1], b[i + 1]);
+        const uint64_t r2 = omnia_gcf(a[i + 2], b[i + 2]);
+        const uint64_t r3 = omnia_gcf(a[i + 3], b[i + 3]);
+
+        result[i] = r0;
+        result[i + 1] = r1;
+        result[i + 2] = r2;
+        result[i + 3] = r3;
+    }
+
+    for (; i < end; ++i)
+        result[i] = omnia_gcf(a[i], b[i]);
+}
+
+// Greatest common factors of corresponding elements of two arrays
+void omnia_gcf_pairwise(const uint64_t * a, const uint64_t * b, uint64_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_GCF_PAIRWISE, n);
+
+    pairwise_job_t job = { a, b, result };
+
+    omnia_parallel_run(n, omnia_get_grain(), pairwise_range, &job);
 }
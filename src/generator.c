@@ -0,0 +1,428 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+
+/*
+    Generators added beside xorshift+ and KISS:
+
+    xoshiro256** and xoshiro256++ (Blackman and Vigna) share a 256-bit
+    xor/shift/rotate state with a period of 2^256 - 1, and scramble it
+    with a multiply or an add, so that the low bits no longer show the
+    linear artifacts of xorshift128+.
+
+        http://prng.di.unimi.it/
+
+    PCG64 (O'Neill) is the XSL-RR output of a 128-bit linear congruential
+    generator; the stream selector chooses one of 2^127 increments.
+
+        http://www.pcg-random.org/
+
+    wyrand (Wang Yi), from wyhash final version 4, multiplies a Weyl
+    counter by itself and folds the 128-bit product; one multiply per
+    value, and a period of 2^64.
+
+        https://github.com/wangyi-fudan/wyhash
+
+    The fill functions keep the state in local variables, so that the
+    compiler holds it in registers for the whole loop.
+*/
+
+//-----------------------------------------------------------------------------
+// xoshiro256** and xoshiro256++
+//-----------------------------------------------------------------------------
+
+static inline uint64_t rotl64(const uint64_t x, const int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// advance the shared state
+static inline void xoshiro256_step(uint64_t s[4])
+{
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+}
+
+// Seed a xoshiro256 generator
+void omnia_xoshiro256_seed_r(omnia_xoshiro256_t * state, const uint64_t seed)
+{
+    uint64_t mix = seed;
+
+    // SplitMix64 outputs for consecutive counters differ, so the state is never all zero
+    for (int i = 0; i < 4; ++i)
+        state->s[i] = omnia_splitmix64(&mix);
+}
+
+// Get the next xoshiro256** value
+uint64_t omnia_xoshiro256ss_next_r(omnia_xoshiro256_t * state)
+{
+    const uint64_t result = rotl64(state->s[1] * 5, 7) * 9;
+
+    xoshiro256_step(state->s);
+    return result;
+}
+
+// Get the next xoshiro256++ value
+uint64_t omnia_xoshiro256pp_next_r(omnia_xoshiro256_t * state)
+{
+    const uint64_t result = rotl64(state->s[0] + state->s[3], 23) + state->s[0];
+
+    xoshiro256_step(state->s);
+    return result;
+}
+
+// Fill an array from a xoshiro256** generator
+void omnia_xoshiro256ss_fill_r(omnia_xoshiro256_t * state, uint64_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_XOSHIRO256SS_FILL, n);
+
+    uint64_t s[4] = { state->s[0], state->s[1], state->s[2], state->s[3] };
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        result[i] = rotl64(s[1] * 5, 7) * 9;
+        xoshiro256_step(s);
+    }
+
+    memcpy(state->s, s, sizeof(s));
+}
+
+// Fill an array from a xoshiro256++ generator
+void omnia_xoshiro256pp_fill_r(omnia_xoshiro256_t * state, uint64_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_XOSHIRO256PP_FILL, n);
+
+    uint64_t s[4] = { state->s[0], state->s[1], state->s[2], state->s[3] };
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        result[i] = rotl64(s[0] + s[3], 23) + s[0];
+        xoshiro256_step(s);
+    }
+
+    memcpy(state->s, s, sizeof(s));
+}
+
+// Jump a xoshiro256 generator ahead by 2^128 values
+void omnia_xoshiro256_jump_r(omnia_xoshiro256_t * state)
+{
+    // the polynomial x^(2^128) modulo the characteristic polynomial of the step
+    static const uint64_t JUMP[4] =
+    {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+
+    uint64_t s[4] = { state->s[0], state->s[1], state->s[2], state->s[3] };
+    uint64_t j[4] = { 0, 0, 0, 0 };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int b = 0; b < 64; ++b)
+        {
+            if (JUMP[i] & (1ULL << b))
+            {
+                j[0] ^= s[0];
+                j[1] ^= s[1];
+                j[2] ^= s[2];
+                j[3] ^= s[3];
+            }
+
+            xoshiro256_step(s);
+        }
+    }
+
+    memcpy(state->s, j, sizeof(j));
+}
+
+//-----------------------------------------------------------------------------
+// PCG64
+//-----------------------------------------------------------------------------
+
+#define PCG64_MULT_HI 0x2360ed051fc65da4ULL
+#define PCG64_MULT_LO 0x4385df649fccf645ULL
+
+static inline uint128_t pcg64_join(const uint64_t words[2])
+{
+    return ((uint128_t)words[1] << 64) | words[0];
+}
+
+static inline void pcg64_split(uint64_t words[2], const uint128_t v)
+{
+    words[0] = (uint64_t)v;
+    words[1] = (uint64_t)(v >> 64);
+}
+
+// the XSL-RR output function
+static inline uint64_t pcg64_output(const uint128_t s)
+{
+    const uint64_t x = (uint64_t)(s >> 64) ^ (uint64_t)s;
+    const unsigned r = (unsigned)(s >> 122);
+
+    return (x >> r) | (x << ((64 - r) & 63));
+}
+
+// Seed a PCG64 generator
+void omnia_pcg64_seed_r(omnia_pcg64_t * state, const uint64_t seed[2], const uint64_t stream[2])
+{
+    const uint128_t mult = ((uint128_t)PCG64_MULT_HI << 64) | PCG64_MULT_LO;
+    const uint128_t inc = (pcg64_join(stream) << 1) | 1;
+    uint128_t s = 0;
+
+    // as the reference pcg_setseq_128_srandom_r
+    s = s * mult + inc;
+    s += pcg64_join(seed);
+    s = s * mult + inc;
+
+    pcg64_split(state->state, s);
+    pcg64_split(state->inc, inc);
+}
+
+// Get the next PCG64 value
+uint64_t omnia_pcg64_next_r(omnia_pcg64_t * state)
+{
+    const uint128_t mult = ((uint128_t)PCG64_MULT_HI << 64) | PCG64_MULT_LO;
+    const uint128_t s = pcg64_join(state->state) * mult + pcg64_join(state->inc);
+
+    pcg64_split(state->state, s);
+    return pcg64_output(s);
+}
+
+// Fill an array from a PCG64 generator
+void omnia_pcg64_fill_r(omnia_pcg64_t * state, uint64_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_PCG64_FILL, n);
+
+    const uint128_t mult = ((uint128_t)PCG64_MULT_HI << 64) | PCG64_MULT_LO;
+    const uint128_t inc = pcg64_join(state->inc);
+    uint128_t s = pcg64_join(state->state);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        s = s * mult + inc;
+        result[i] = pcg64_output(s);
+    }
+
+    pcg64_split(state->state, s);
+}
+
+// Jump a PCG64 generator ahead by 2^64 values
+void omnia_pcg64_jump_r(omnia_pcg64_t * state)
+{
+    // squaring the affine step s -> m * s + c doubles the distance it covers
+    uint128_t m = ((uint128_t)PCG64_MULT_HI << 64) | PCG64_MULT_LO;
+    uint128_t c = pcg64_join(state->inc);
+
+    for (int i = 0; i < 64; ++i)
+    {
+        c *= m + 1;
+        m *= m;
+    }
+
+    pcg64_split(state->state, pcg64_join(state->state) * m + c);
+}
+
+//-----------------------------------------------------------------------------
+// wyrand
+//-----------------------------------------------------------------------------
+
+#define WYRAND_INCREMENT 0x2d358dccaa6c78a5ULL
+#define WYRAND_MIX 0x8bb84b93962eacc9ULL
+
+static inline uint64_t wyrand_output(const uint64_t s)
+{
+    const uint128_t t = (uint128_t)s * (s ^ WYRAND_MIX);
+
+    return (uint64_t)(t >> 64) ^ (uint64_t)t;
+}
+
+// Seed a wyrand generator
+void omnia_wyrand_seed_r(omnia_wyrand_t * state, const uint64_t seed)
+{
+    state->s = seed;
+}
+
+// Get the next wyrand value
+uint64_t omnia_wyrand_next_r(omnia_wyrand_t * state)
+{
+    state->s += WYRAND_INCREMENT;
+    return wyrand_output(state->s);
+}
+
+// Fill an array from a wyrand generator
+void omnia_wyrand_fill_r(omnia_wyrand_t * state, uint64_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_WYRAND_FILL, n);
+
+    const uint64_t s = state->s;
+
+    // each value depends only on its counter, so the iterations are independent
+    for (size_t i = 0; i < n; ++i)
+        result[i] = wyrand_output(s + (uint64_t)(i + 1) * WYRAND_INCREMENT);
+
+    state->s = s + (uint64_t)n * WYRAND_INCREMENT;
+}
+
+// Jump a wyrand generator ahead by 2^32 values
+void omnia_wyrand_jump_r(omnia_wyrand_t * state)
+{
+    state->s += WYRAND_INCREMENT << 32;
+}
+
+//-----------------------------------------------------------------------------
+// Common interface
+//-----------------------------------------------------------------------------
+
+// adapters from the untyped state of the interface
+
+static void xs128p_seed(void * state, const uint64_t seed)
+{
+    omnia_xs128p_expand_seed((omnia_xs128p_t *)state, seed);
+}
+
+static uint64_t xs128p_next(void * state)
+{
+    return omnia_xs128p_next_r((omnia_xs128p_t *)state);
+}
+
+static void xs128p_fill(void * state, uint64_t * result, const size_t n)
+{
+    omnia_xs128p_fill_r((omnia_xs128p_t *)state, result, n);
+}
+
+static void xs128p_jump(void * state)
+{
+    omnia_xs128p_jump_r((omnia_xs128p_t *)state);
+}
+
+static void xoshiro256_seed(void * state, const uint64_t seed)
+{
+    omnia_xoshiro256_seed_r((omnia_xoshiro256_t *)state, seed);
+}
+
+static uint64_t xoshiro256ss_next(void * state)
+{
+    return omnia_xoshiro256ss_next_r((omnia_xoshiro256_t *)state);
+}
+
+static void xoshiro256ss_fill(void * state, uint64_t * result, const size_t n)
+{
+    omnia_xoshiro256ss_fill_r((omnia_xoshiro256_t *)state, result, n);
+}
+
+static uint64_t xoshiro256pp_next(void * state)
+{
+    return omnia_xoshiro256pp_next_r((omnia_xoshiro256_t *)state);
+}
+
+static void xoshiro256pp_fill(void * state, uint64_t * result, const size_t n)
+{
+    omnia_xoshiro256pp_fill_r((omnia_xoshiro256_t *)state, result, n);
+}
+
+static void xoshiro256_jump(void * state)
+{
+    omnia_xoshiro256_jump_r((omnia_xoshiro256_t *)state);
+}
+
+static void pcg64_seed(void * state, const uint64_t seed)
+{
+    uint64_t mix = seed;
+    const uint64_t s[2] = { omnia_splitmix64(&mix), omnia_splitmix64(&mix) };
+    const uint64_t stream[2] = { omnia_splitmix64(&mix), omnia_splitmix64(&mix) };
+
+    omnia_pcg64_seed_r((omnia_pcg64_t *)state, s, stream);
+}
+
+static uint64_t pcg64_next(void * state)
+{
+    return omnia_pcg64_next_r((omnia_pcg64_t *)state);
+}
+
+static void pcg64_fill(void * state, uint64_t * result, const size_t n)
+{
+    omnia_pcg64_fill_r((omnia_pcg64_t *)state, result, n);
+}
+
+static void pcg64_jump(void * state)
+{
+    omnia_pcg64_jump_r((omnia_pcg64_t *)state);
+}
+
+static void wyrand_seed(void * state, const uint64_t seed)
+{
+    omnia_wyrand_seed_r((omnia_wyrand_t *)state, seed);
+}
+
+static uint64_t wyrand_next(void * state)
+{
+    return omnia_wyrand_next_r((omnia_wyrand_t *)state);
+}
+
+static void wyrand_fill(void * state, uint64_t * result, const size_t n)
+{
+    omnia_wyrand_fill_r((omnia_wyrand_t *)state, result, n);
+}
+
+static void wyrand_jump(void * state)
+{
+    omnia_wyrand_jump_r((omnia_wyrand_t *)state);
+}
+
+// indexed by omnia_generator_id_t
+static const omnia_generator_t GENERATORS[OMNIA_GENERATOR_COUNT] =
+{
+    { "xs128p",       sizeof(omnia_xs128p_t),     64,  xs128p_seed,     xs128p_next,       xs128p_fill,       xs128p_jump     },
+    { "xoshiro256ss", sizeof(omnia_xoshiro256_t), 128, xoshiro256_seed, xoshiro256ss_next, xoshiro256ss_fill, xoshiro256_jump },
+    { "xoshiro256pp", sizeof(omnia_xoshiro256_t), 128, xoshiro256_seed, xoshiro256pp_next, xoshiro256pp_fill, xoshiro256_jump },
+    { "pcg64",        sizeof(omnia_pcg64_t),      64,  pcg64_seed,      pcg64_next,        pcg64_fill,        pcg64_jump      },
+    { "wyrand",       sizeof(omnia_wyrand_t),     32,  wyrand_seed,     wyrand_next,       wyrand_fill,       wyrand_jump     }
+};
+
+// Get a generator by identifier
+const omnia_generator_t * omnia_get_generator(const omnia_generator_id_t id)
+{
+    if ((unsigned)id >= OMNIA_GENERATOR_COUNT)
+        return NULL;
+
+    return &GENERATORS[id];
+}
+
+// Get a generator by name
+const omnia_generator_t * omnia_find_generator(const char * name)
+{
+    if (name != NULL)
+    {
+        for (size_t i = 0; i < OMNIA_GENERATOR_COUNT; ++i)
+            if (strcmp(GENERATORS[i].name, name) == 0)
+                return &GENERATORS[i];
+    }
+
+    return NULL;
+}
+
+// Get a number in [0,1) from any generator
+double omnia_generator_real(const omnia_generator_t * generator, void * state)
+{
+    return (double)(generator->next(state) >> 11) * 0x1.0p-53;
+}
@@ -0,0 +1,25 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+/*
+    The exported copies of the functions that omnia.h defines inline when
+    OMNIA_INLINE is set. Both come from the same definitions in the
+    header, so inlined and library calls always agree.
+*/
+#define OMNIA_INLINE_EXPORT
+
+#include "omnia_internal.h"
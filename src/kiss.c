@@ -15,7 +15,7 @@
     License), the text of which is available at the website above. 
 */
 
-#include "omnia.h"
+#include "omnia_internal.h"
 
 #include <unistd.h>
 #include <fcntl.h>
@@ -36,56 +36,106 @@
 */
 
 /* The state must be seeded so that it is not everywhere zero. */
-static uint64_t s[2];
+static omnia_xs128p_t state;
 
 // Initialize a psuedo-random number generator
 void omnia_xs128p_set_seed(const uint64_t seed[2])
 {
-    s[0] = seed[0];
-    s[1] = seed[1];
+    omnia_xs128p_seed_r(&state, seed);
 }
 
 // get next 64-bit unsigned integer in sequence
 uint64_t omnia_xs128p_next(void) 
 {
-    uint64_t x = s[0];
-    const uint64_t y = s[1];
-
-    s[0] = y;
-    x ^= x << 23;
-    s[1] = x ^ y ^ (x >> 17) ^ (y >> 26);
-
-    return s[1] + y;
+    return omnia_xs128p_next_r(&state);
 }
 
 // Get the next integer in the range [lo,hi]
 uint64_t omnia_xs128p_range(uint64_t lo, uint64_t hi)
 {
-    if (hi == lo)
-        return hi;
-
-    if (hi < lo)
-    {
-        uint64_t tt = hi;
-        hi = lo;
-        lo = tt;
-    }
-
-    double range = hi - lo + 1.0;
-    return lo + (uint64_t)(floor(range * omnia_xs128p_real()));
+    return omnia_xs128p_range_r(&state, lo, hi);
 }
 
 // Get the next random value as a size_t index
 size_t omnia_xs128p_index(const size_t length)
 {
-    return (size_t)((double)length * omnia_xs128p_real());
+    return omnia_xs128p_index_r(&state, length);
 }
 
 // Get the next number in the range [0,1)
 double omnia_xs128p_real()
 {
     // privides a granularity of approx. 2.3E-10
-    return (double)((double)omnia_xs128p_next() / 18446744073709551615.0);
+    return omnia_xs128p_real_r(&state);
+}
+
+// Fill an array with 64-bit values from a caller's generator
+void omnia_xs128p_fill_r(omnia_xs128p_t * g, uint64_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_XS128P_FILL, n);
+
+    uint64_t s0 = g->s[0];
+    uint64_t s1 = g->s[1];
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint64_t x = s0;
+        const uint64_t y = s1;
+
+        s0 = y;
+        x ^= x << 23;
+        s1 = x ^ y ^ (x >> 17) ^ (y >> 26);
+
+        result[i] = s1 + y;
+    }
+
+    g->s[0] = s0;
+    g->s[1] = s1;
+}
+
+// Fill an array with 64-bit values
+void omnia_xs128p_fill(uint64_t * result, const size_t n)
+{
+    omnia_xs128p_fill_r(&state, result, n);
+}
+
+/*
+    The state advances by a linear map T over GF(2)^128, so T^k is some
+    polynomial in T of degree below 128: x^k reduced modulo the
+    characteristic polynomial of T. For k = 2^64 and these shifts, the
+    coefficients of that polynomial are the bits below, lowest first.
+    Summing T^j over the set bits costs 128 steps of the generator.
+*/
+static const uint64_t JUMP[2] = { 0x8c405782bca686adULL, 0xc44f35946fef49c6ULL };
+
+// Advance a caller's generator by 2^64 values
+void omnia_xs128p_jump_r(omnia_xs128p_t * g)
+{
+    uint64_t j0 = 0;
+    uint64_t j1 = 0;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        for (int b = 0; b < 64; ++b)
+        {
+            if (JUMP[i] & (1ULL << b))
+            {
+                j0 ^= g->s[0];
+                j1 ^= g->s[1];
+            }
+
+            omnia_xs128p_next_r(g);
+        }
+    }
+
+    g->s[0] = j0;
+    g->s[1] = j1;
+}
+
+// Advance by 2^64 values
+void omnia_xs128p_jump()
+{
+    omnia_xs128p_jump_r(&state);
 }
 
 /*
@@ -105,7 +155,16 @@ static uint64_t t =   29979245822353888ULL;
 // Initialize a psuedo-random number generator
 void omnia_kiss64_set_seed(const uint64_t seed)
 {
-    t = seed;
+    // t is overwritten by the first step, so the seed goes into the
+    // component generators; the xorshift part must not be zero
+    x = 1234567890987654321ULL ^ seed;
+    c =  123456123456123456ULL;
+    y = 362436362436362436ULL ^ seed;
+    z =    1066149217761810ULL ^ seed;
+    t =   29979245822353888ULL;
+
+    if (y == 0)
+        y = 362436362436362436ULL;
 }
 
 // get next 64-bit unsigned integer in sequence
@@ -148,6 +207,33 @@ double omnia_kiss64_real()
     return (double)((double)omnia_kiss64_next() / 18446744073709551615.0);
 }
 
+// Fill an array with 64-bit values
+void omnia_kiss64_fill(uint64_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_KISS64_FILL, n);
+
+    uint64_t lx = x;
+    uint64_t lc = c;
+    uint64_t ly = y;
+    uint64_t lz = z;
+    uint64_t lt = t;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        lt = (lt = (lx << 58) + lc, lc = (lx >> 6), lx += lt, lc += (lx < lt), lx)
+           + (ly ^= (ly << 13), ly ^= (ly >> 17), ly ^= (ly << 43))
+           + (lz = 6906969069LL * lz + 1234567);
+
+        result[i] = lt;
+    }
+
+    x = lx;
+    c = lc;
+    y = ly;
+    z = lz;
+    t = lt;
+}
+
 /*
     The popular "Keep It Simple Stupid" psuedorandom number generator.
     It has a period of around 2^125, which is shorter than most other
@@ -158,19 +244,16 @@ double omnia_kiss64_real()
 
 static const uint64_t A = 698769069ULL;
 static const uint32_t K = 1812433253UL;
-static uint32_t * m = NULL;
+static uint32_t m[4];
+static bool seeded = false;
 
 void omnia_kiss32_set_seed(const uint32_t seed)
 {
-    m = malloc(sizeof(uint32_t) * 4);
-
-    if (m != NULL)
-    {
-        m[0] = K * (seed ^ (seed >> 30)) + 1;
-        m[1] = K * (m[0] ^ (m[0] >> 30)) + 2;
-        m[2] = K * (m[1] ^ (m[1] >> 30)) + 3;
-        m[3] = K * (m[2] ^ (m[2] >> 30)) + 5;
-    }
+    m[0] = K * (seed ^ (seed >> 30)) + 1;
+    m[1] = K * (m[0] ^ (m[0] >> 30)) + 2;
+    m[2] = K * (m[1] ^ (m[1] >> 30)) + 3;
+    m[3] = K * (m[2] ^ (m[2] >> 30)) + 5;
+    seeded = true;
 }
 
 uint32_t omnia_kiss32_next()
@@ -178,7 +261,7 @@ uint32_t omnia_kiss32_next()
     uint32_t result = 0;
     uint64_t temp;
 
-    if (m != NULL)
+    if (seeded)
     {
         m[1] = 69069 * m[1] + 12345;
         m[2] ^= ( m[2] << 13);
@@ -223,3 +306,42 @@ double omnia_kiss32_real()
     // privides a granularity of approx. 2.3E-10
     return (double)((double)omnia_kiss32_next() / 4294967296.0);
 }
+
+// Fill an array with 32-bit values
+void omnia_kiss32_fill(uint32_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_KISS32_FILL, n);
+
+    if (!seeded)
+    {
+        // match omnia_kiss32_next on an unseeded generator
+        for (size_t i = 0; i < n; ++i)
+            result[i] = 0;
+
+        return;
+    }
+
+    uint32_t m0 = m[0];
+    uint32_t m1 = m[1];
+    uint32_t m2 = m[2];
+    uint32_t m3 = m[3];
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        m1 = 69069 * m1 + 12345;
+        m2 ^= (m2 << 13);
+        m2 ^= (m2 >> 17);
+        m2 ^= (m2 <<  5);
+
+        const uint64_t temp = A * m3 + m0;
+        m0 = (temp >> 32);
+        m3 = (uint32_t)temp;
+
+        result[i] = m1 + m2 + m3;
+    }
+
+    m[0] = m0;
+    m[1] = m1;
+    m[2] = m2;
+    m[3] = m3;
+}
@@ -15,35 +15,62 @@
     License), the text of which is available at the website above. 
 */
 
-#include "omnia.h"
+#include "omnia_internal.h"
 
 // Logarithm to a specified base
 double omnia_log2base(const double x, const double base)
 {
     double result = NAN;
     
-    if (x >= 1.0)
+    if ((base > 0.0) && (base != 1.0))
         result = log(x) / log(base);
     
     return result;
 }
 
-// Smallest power of 2 that includes a given value
-int omnia_sizepow2(const int n)
+// Prepare a logarithm base
+bool omnia_log_base_init(omnia_log_base_t * ctx, const double base)
 {
-    int n2 = 0;
-    
-    if (n > 0)
-    {
-        n2 = 1;
-        while (true)
-        {
-            if (n <= n2)
-                break;
-            else
-                n2 <<= 1;
-        }
-    }
-    
-    return n2;
+    if ((ctx == NULL) || !(base > 0.0) || (base == 1.0) || isinf(base))
+        return false;
+
+    ctx->base = base;
+    ctx->scale = 1.0 / log(base);
+    return true;
+}
+
+// Logarithm to a prepared base
+double omnia_log_base(const omnia_log_base_t * ctx, const double x)
+{
+    return log(x) * ctx->scale;
+}
+
+// scale natural logarithms in place
+static void scale_array(double * x, const size_t n, const double scale)
+{
+    for (size_t i = 0; i < n; ++i)
+        x[i] *= scale;
+}
+
+// Logarithm to a prepared base of each element of an array
+void omnia_log_base_array(const omnia_log_base_t * ctx, const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_LOG_BASE_ARRAY, n);
+
+    omnia_log_array(x, result, n, accuracy);
+    scale_array(result, n, ctx->scale);
+}
+
+// Convert an array of power ratios to decibels
+void omnia_power_to_db_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    omnia_log_array(x, result, n, accuracy);
+    scale_array(result, n, 10.0 * OMNIA_LOG10_E);
+}
+
+// Convert an array of amplitude ratios to decibels
+void omnia_amplitude_to_db_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    omnia_log_array(x, result, n, accuracy);
+    scale_array(result, n, 20.0 * OMNIA_LOG10_E);
 }
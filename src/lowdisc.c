@@ -0,0 +1,606 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include "sobol_tables.h"
+
+/*
+    Sobol sequences. Direction number k of a dimension is a 32-bit
+    binary fraction; point i is the exclusive-or of the direction
+    numbers selected by the bits of gray(i) = i ^ (i >> 1). Consecutive
+    Gray codes differ in one bit, the lowest set bit of i, so each point
+    follows from the one before with a single exclusive-or per
+    coordinate.
+
+    Direction numbers are stored bit-major: the numbers for bit k of
+    every dimension are consecutive, so that stepping from one point to
+    the next, and converting it to doubles, are plain loops over the
+    dimensions that the compiler vectorizes.
+*/
+
+#define SOBOL_BITS 32
+
+struct omnia_sobol_s
+{
+    size_t dims;
+    uint64_t index;         // index of the next point
+    uint32_t * direction;   // SOBOL_BITS rows of dims direction numbers
+    uint32_t * shift;       // digital shift per dimension; zero unless scrambled
+    uint32_t * x;           // next point, before the shift
+};
+
+// convert a 32-bit binary fraction to a double, in a vectorizable way
+OMNIA_KERNEL_INLINE double fraction32(const uint32_t x)
+{
+    // 1 + x * 2^-32 has x in the high bits of its mantissa; subtracting 1 is exact
+    const uint64_t bits = ((uint64_t)x << 20) | 0x3ff0000000000000ULL;
+    double r;
+
+    memcpy(&r, &bits, sizeof(r));
+    return r - 1.0;
+}
+
+// compute the direction numbers of one dimension
+static void sobol_directions(uint32_t * v, const size_t j)
+{
+    if (j == 0)
+    {
+        // the van der Corput sequence
+        for (int k = 0; k < SOBOL_BITS; ++k)
+            v[k] = 1U << (SOBOL_BITS - 1 - k);
+
+        return;
+    }
+
+    const uint32_t poly = SOBOL_POLY[j - 1];
+    const int s = 31 - __builtin_clz(poly);
+
+    for (int k = 0; k < s; ++k)
+        v[k] = (uint32_t)SOBOL_MINIT[j - 1][k] << (SOBOL_BITS - 1 - k);
+
+    // the recurrence defined by the polynomial's coefficients
+    for (int k = s; k < SOBOL_BITS; ++k)
+    {
+        uint32_t d = v[k - s] ^ (v[k - s] >> s);
+
+        for (int i = 1; i < s; ++i)
+            if ((poly >> (s - i)) & 1)
+                d ^= v[k - i];
+
+        v[k] = d;
+    }
+}
+
+// multiply a direction number by a random lower-triangular matrix with a unit diagonal
+static uint32_t sobol_scramble(const uint32_t v, const uint32_t * rows)
+{
+    uint32_t result = 0;
+
+    for (int b = 0; b < SOBOL_BITS; ++b)
+        result |= (uint32_t)__builtin_parity(v & rows[b]) << b;
+
+    return result;
+}
+
+// shared by both create functions
+static omnia_sobol_t * sobol_create(const size_t dims, const bool scrambled, const uint64_t seed)
+{
+    omnia_sobol_t * sobol;
+    uint32_t v[SOBOL_BITS];
+
+    if ((dims == 0) || (dims > OMNIA_LOWDISC_MAX_DIMENSIONS))
+        return NULL;
+
+    sobol = (omnia_sobol_t *)omnia_alloc_zero(1, sizeof(omnia_sobol_t));
+
+    if (sobol == NULL)
+        return NULL;
+
+    sobol->dims = dims;
+    sobol->direction = (uint32_t *)omnia_alloc(sizeof(uint32_t) * SOBOL_BITS * dims);
+    sobol->shift = (uint32_t *)omnia_alloc_zero(dims, sizeof(uint32_t));
+    sobol->x = (uint32_t *)omnia_alloc_zero(dims, sizeof(uint32_t));
+
+    if ((sobol->direction == NULL) || (sobol->shift == NULL) || (sobol->x == NULL))
+    {
+        omnia_sobol_free(sobol);
+        return NULL;
+    }
+
+    omnia_xs128p_t rng;
+    omnia_xs128p_expand_seed(&rng, seed);
+
+    for (size_t j = 0; j < dims; ++j)
+    {
+        sobol_directions(v, j);
+
+        if (scrambled)
+        {
+            // output bit b depends on bit b and on random choices of the bits above it
+            uint32_t rows[SOBOL_BITS];
+
+            for (int b = 0; b < SOBOL_BITS; ++b)
+            {
+                const uint32_t above = (uint32_t)(0xffffffffULL << (b + 1));
+                rows[b] = (1U << b) | ((uint32_t)omnia_xs128p_next_r(&rng) & above);
+            }
+
+            for (int k = 0; k < SOBOL_BITS; ++k)
+                v[k] = sobol_scramble(v[k], rows);
+
+            sobol->shift[j] = (uint32_t)(omnia_xs128p_next_r(&rng) >> 32);
+        }
+
+        for (int k = 0; k < SOBOL_BITS; ++k)
+            sobol->direction[k * dims + j] = v[k];
+    }
+
+    return sobol;
+}
+
+// Create a Sobol sequence generator
+omnia_sobol_t * omnia_sobol_create(const size_t dims)
+{
+    return sobol_create(dims, false, 0);
+}
+
+// Create a scrambled Sobol sequence generator
+omnia_sobol_t * omnia_sobol_create_scrambled(const size_t dims, const uint64_t seed)
+{
+    return sobol_create(dims, true, seed);
+}
+
+// Release a Sobol sequence generator
+void omnia_sobol_free(omnia_sobol_t * sobol)
+{
+    if (sobol != NULL)
+    {
+        omnia_free(sobol->direction);
+        omnia_free(sobol->shift);
+        omnia_free(sobol->x);
+        omnia_free(sobol);
+    }
+}
+
+// Number of dimensions of a Sobol sequence
+size_t omnia_sobol_dimensions(const omnia_sobol_t * sobol)
+{
+    return sobol->dims;
+}
+
+// Index of the next Sobol point
+uint64_t omnia_sobol_index(const omnia_sobol_t * sobol)
+{
+    return sobol->index;
+}
+
+// Move to any point of a Sobol sequence
+bool omnia_sobol_seek(omnia_sobol_t * sobol, const uint64_t index)
+{
+    if (index > OMNIA_LOWDISC_MAX_POINTS)
+        return false;
+
+    const size_t dims = sobol->dims;
+    uint64_t gray = index ^ (index >> 1);
+
+    memset(sobol->x, 0, sizeof(uint32_t) * dims);
+
+    for (int k = 0; (k < SOBOL_BITS) && (gray != 0); ++k, gray >>= 1)
+    {
+        if (gray & 1)
+        {
+            const uint32_t * v = sobol->direction + k * dims;
+
+            for (size_t j = 0; j < dims; ++j)
+                sobol->x[j] ^= v[j];
+        }
+    }
+
+    sobol->index = index;
+    return true;
+}
+
+// store n points starting at index, and leave x at the point that follows them
+OMNIA_VECTOR_CLONES
+static void sobol_rows(const uint32_t * direction, const uint32_t * shift, uint32_t * x, const size_t dims, const uint64_t index, double * points, const size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint64_t next = index + i + 1;
+        double * p = points + i * dims;
+
+        if (next < OMNIA_LOWDISC_MAX_POINTS)
+        {
+            const uint32_t * v = direction + (size_t)omnia_ctz_u64(next) * dims;
+
+            for (size_t j = 0; j < dims; ++j)
+            {
+                p[j] = fraction32(x[j] ^ shift[j]);
+                x[j] ^= v[j];
+            }
+        }
+        else
+        {
+            for (size_t j = 0; j < dims; ++j)
+                p[j] = fraction32(x[j] ^ shift[j]);
+        }
+    }
+}
+
+// Get the next Sobol point
+bool omnia_sobol_next(omnia_sobol_t * sobol, double * point)
+{
+    return omnia_sobol_fill(sobol, point, 1) == 1;
+}
+
+// Get a block of Sobol points
+size_t omnia_sobol_fill(omnia_sobol_t * sobol, double * points, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_SOBOL_FILL, n);
+
+    const uint64_t left = OMNIA_LOWDISC_MAX_POINTS - sobol->index;
+    const size_t count = ((uint64_t)n < left) ? n : (size_t)left;
+
+    sobol_rows(sobol->direction, sobol->shift, sobol->x, sobol->dims, sobol->index, points, count);
+    sobol->index += count;
+
+    return count;
+}
+
+/*
+    Halton sequences. Coordinate j of point i is the radical inverse of
+    i in base b, the (j+1)-th prime: the digits of i, least significant
+    first, become the digits after the radix point. Each coordinate
+    keeps the digits of the index and the partial sums of the radical
+    inverse from each digit upward, so stepping to the next index
+    recomputes only the sums below the highest digit that changed; on
+    average that is one multiply-add.
+
+    Every coordinate has as many digits as fit in a double, whether or
+    not the index uses them: unscrambled, the extra digits are zero;
+    scrambled, they carry random constants, so that the coordinates are
+    not confined to multiples of b^-k. The sums are always formed in the
+    same order, so seeking to a point and stepping to it give identical
+    results.
+*/
+
+// largest value of b^digits
+#define HALTON_PRECISION 4503599627370496.0
+
+// coordinates per block of points filled (16 KiB)
+#define HALTON_BLOCK 2048
+
+struct omnia_halton_s
+{
+    size_t dims;
+    uint64_t index;         // index of the next point
+    uint32_t * base;        // base of each dimension
+    uint32_t * levels;      // digits kept for each dimension
+    size_t * offset;        // first digit of each dimension in the arrays below
+
+    uint32_t * digit;       // digits of the index, least significant first
+    uint32_t * scrambled;   // the digits after scrambling
+    uint32_t * mult;        // scramble multiplier of each digit position; one if unscrambled
+    uint32_t * add;         // scramble offset of each digit position; zero if unscrambled
+    double * scale;         // b^-(k+1) for digit position k
+    double * partial;       // sum of the scrambled digits from position k upward, each times its scale
+};
+
+// the first dims primes
+static void halton_bases(uint32_t * base, const size_t dims)
+{
+    uint32_t p = 2;
+
+    for (size_t j = 0; j < dims; ++p)
+        if (omnia_is_prime(p))
+            base[j++] = p;
+}
+
+// recompute the partial sums of dimension j from digit position k down
+static inline void halton_sums(omnia_halton_t * halton, const size_t j, size_t k)
+{
+    const size_t at = halton->offset[j];
+    const size_t levels = halton->levels[j];
+    const uint32_t * e = halton->scrambled + at;
+    const double * scale = halton->scale + at;
+    double * partial = halton->partial + at;
+
+    double sum = (k + 1 < levels) ? partial[k + 1] : 0.0;
+
+    for (;;)
+    {
+        sum += (double)e[k] * scale[k];
+        partial[k] = sum;
+
+        if (k == 0)
+            break;
+
+        --k;
+    }
+}
+
+// advance dimension j to the next index
+static inline void halton_step(omnia_halton_t * halton, const size_t j)
+{
+    const size_t at = halton->offset[j];
+    const uint32_t b = halton->base[j];
+    uint32_t * d = halton->digit + at;
+    uint32_t * e = halton->scrambled + at;
+    const uint32_t * mult = halton->mult + at;
+    size_t k = 0;
+
+    // the index stays below b^levels, so the carry always stops
+    while (d[k] == b - 1)
+    {
+        d[k] = 0;
+        e[k] = halton->add[at + k];
+        ++k;
+    }
+
+    d[k] += 1;
+    e[k] += mult[k];
+
+    if (e[k] >= b)
+        e[k] -= b;
+
+    halton_sums(halton, j, k);
+}
+
+// keep a coordinate below one despite rounding in the sums
+static inline double halton_clamp(const double v)
+{
+    return (v < 1.0) ? v : 1.0 - DBL_EPSILON / 2.0;
+}
+
+// store count values of dimension j, every dims elements, stepping past each but the last
+static void halton_column(omnia_halton_t * halton, const size_t j, double * p, const size_t dims, const size_t count, const bool step_last)
+{
+    const size_t at = halton->offset[j];
+    const uint32_t b = halton->base[j];
+    const uint32_t mult = halton->mult[at];
+    const double scale = halton->scale[at];
+    uint32_t d = halton->digit[at];
+    uint32_t e = halton->scrambled[at];
+    double upper = halton->partial[at + 1];     // every base keeps at least four digits
+
+    // only the lowest digit changes until it carries, once every b values
+    for (size_t i = 0; i < count; ++i)
+    {
+        p[i * dims] = halton_clamp(upper + (double)e * scale);
+
+        if ((i + 1 == count) && !step_last)
+            break;
+
+        if (d + 1 < b)
+        {
+            ++d;
+            e += mult;
+
+            if (e >= b)
+                e -= b;
+        }
+        else
+        {
+            halton->digit[at] = d;
+            halton->scrambled[at] = e;
+            halton_step(halton, j);
+
+            d = halton->digit[at];
+            e = halton->scrambled[at];
+            upper = halton->partial[at + 1];
+        }
+    }
+
+    halton->digit[at] = d;
+    halton->scrambled[at] = e;
+    halton->partial[at] = upper + (double)e * scale;
+}
+
+// shared by both create functions
+static omnia_halton_t * halton_create(const size_t dims, const bool scrambled, const uint64_t seed)
+{
+    omnia_halton_t * halton;
+    size_t total = 0;
+
+    if ((dims == 0) || (dims > OMNIA_LOWDISC_MAX_DIMENSIONS))
+        return NULL;
+
+    halton = (omnia_halton_t *)omnia_alloc_zero(1, sizeof(omnia_halton_t));
+
+    if (halton == NULL)
+        return NULL;
+
+    halton->dims = dims;
+    halton->base = (uint32_t *)omnia_alloc(sizeof(uint32_t) * dims);
+    halton->levels = (uint32_t *)omnia_alloc(sizeof(uint32_t) * dims);
+    halton->offset = (size_t *)omnia_alloc(sizeof(size_t) * dims);
+
+    if ((halton->base == NULL) || (halton->levels == NULL) || (halton->offset == NULL))
+    {
+        omnia_halton_free(halton);
+        return NULL;
+    }
+
+    halton_bases(halton->base, dims);
+
+    for (size_t j = 0; j < dims; ++j)
+    {
+        const double b = (double)halton->base[j];
+        uint32_t levels = 0;
+
+        // every index below OMNIA_LOWDISC_MAX_POINTS fits, since b^levels > 2^52 / b
+        for (double p = b; p <= HALTON_PRECISION; p *= b)
+            ++levels;
+
+        halton->levels[j] = levels;
+        halton->offset[j] = total;
+        total += levels;
+    }
+
+    halton->digit = (uint32_t *)omnia_alloc_zero(total, sizeof(uint32_t));
+    halton->scrambled = (uint32_t *)omnia_alloc(sizeof(uint32_t) * total);
+    halton->mult = (uint32_t *)omnia_alloc(sizeof(uint32_t) * total);
+    halton->add = (uint32_t *)omnia_alloc(sizeof(uint32_t) * total);
+    halton->scale = (double *)omnia_alloc(sizeof(double) * total);
+    halton->partial = (double *)omnia_alloc(sizeof(double) * total);
+
+    if ((halton->digit == NULL) || (halton->scrambled == NULL) || (halton->mult == NULL)
+    ||  (halton->add == NULL) || (halton->scale == NULL) || (halton->partial == NULL))
+    {
+        omnia_halton_free(halton);
+        return NULL;
+    }
+
+    omnia_xs128p_t rng;
+    omnia_xs128p_expand_seed(&rng, seed);
+
+    for (size_t j = 0; j < dims; ++j)
+    {
+        const uint32_t b = halton->base[j];
+        const size_t at = halton->offset[j];
+        double scale = 1.0;
+
+        for (size_t k = 0; k < halton->levels[j]; ++k)
+        {
+            scale /= (double)b;
+            halton->scale[at + k] = scale;
+
+            if (scrambled)
+            {
+                halton->mult[at + k] = 1 + (uint32_t)omnia_xs128p_index_r(&rng, b - 1);
+                halton->add[at + k] = (uint32_t)omnia_xs128p_index_r(&rng, b);
+            }
+            else
+            {
+                halton->mult[at + k] = 1;
+                halton->add[at + k] = 0;
+            }
+        }
+    }
+
+    omnia_halton_seek(halton, 0);
+    return halton;
+}
+
+// Create a Halton sequence generator
+omnia_halton_t * omnia_halton_create(const size_t dims)
+{
+    return halton_create(dims, false, 0);
+}
+
+// Create a scrambled Halton sequence generator
+omnia_halton_t * omnia_halton_create_scrambled(const size_t dims, const uint64_t seed)
+{
+    return halton_create(dims, true, seed);
+}
+
+// Release a Halton sequence generator
+void omnia_halton_free(omnia_halton_t * halton)
+{
+    if (halton != NULL)
+    {
+        omnia_free(halton->base);
+        omnia_free(halton->levels);
+        omnia_free(halton->offset);
+        omnia_free(halton->digit);
+        omnia_free(halton->scrambled);
+        omnia_free(halton->mult);
+        omnia_free(halton->add);
+        omnia_free(halton->scale);
+        omnia_free(halton->partial);
+        omnia_free(halton);
+    }
+}
+
+// Number of dimensions of a Halton sequence
+size_t omnia_halton_dimensions(const omnia_halton_t * halton)
+{
+    return halton->dims;
+}
+
+// Index of the next Halton point
+uint64_t omnia_halton_index(const omnia_halton_t * halton)
+{
+    return halton->index;
+}
+
+// Move to any point of a Halton sequence
+bool omnia_halton_seek(omnia_halton_t * halton, const uint64_t index)
+{
+    if (index > OMNIA_LOWDISC_MAX_POINTS)
+        return false;
+
+    // the final position has no point; its digits are never used
+    const uint64_t digits_of = (index < OMNIA_LOWDISC_MAX_POINTS) ? index : 0;
+
+    for (size_t j = 0; j < halton->dims; ++j)
+    {
+        const uint32_t b = halton->base[j];
+        const size_t at = halton->offset[j];
+        const size_t levels = halton->levels[j];
+        uint64_t i = digits_of;
+
+        for (size_t k = 0; k < levels; ++k)
+        {
+            const uint32_t d = (uint32_t)(i % b);
+
+            i /= b;
+            halton->digit[at + k] = d;
+            halton->scrambled[at + k] = (uint32_t)(((uint64_t)halton->mult[at + k] * d + halton->add[at + k]) % b);
+        }
+
+        halton_sums(halton, j, levels - 1);
+    }
+
+    halton->index = index;
+    return true;
+}
+
+// Get the next Halton point
+bool omnia_halton_next(omnia_halton_t * halton, double * point)
+{
+    return omnia_halton_fill(halton, point, 1) == 1;
+}
+
+// Get a block of Halton points
+size_t omnia_halton_fill(omnia_halton_t * halton, double * points, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_HALTON_FILL, n);
+
+    const uint64_t left = OMNIA_LOWDISC_MAX_POINTS - halton->index;
+    const size_t count = ((uint64_t)n < left) ? n : (size_t)left;
+    const size_t dims = halton->dims;
+
+    // the position after the last point has no digits to step to
+    const bool step_last = (halton->index + count < OMNIA_LOWDISC_MAX_POINTS);
+
+    // one dimension at a time, so that its digits stay in registers, over
+    // blocks of points small enough to stay in the L1 cache between columns
+    const size_t block = (dims < HALTON_BLOCK) ? HALTON_BLOCK / dims : 1;
+
+    for (size_t first = 0; first < count; first += block)
+    {
+        const size_t m = (count - first < block) ? count - first : block;
+        const bool step = (first + m < count) || step_last;
+
+        for (size_t j = 0; j < dims; ++j)
+            halton_column(halton, j, points + first * dims + j, dims, m, step);
+    }
+
+    halton->index += count;
+    return count;
+}
@@ -0,0 +1,136 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include <stdlib.h>
+
+/*
+    All memory the library hands to callers, and the buffers inside its
+    plans and filters, comes from the current allocator. The default
+    uses posix_memalign, so blocks it returns may also be released with
+    free. Allocators receive the alignment they must honor; the library
+    always asks for OMNIA_ALIGNMENT, enough for any SIMD load.
+*/
+
+// default allocation: aligned blocks from the C library
+static void * default_allocate(const size_t size, const size_t alignment, void * context)
+{
+    void * block = NULL;
+
+    (void)context;
+
+    if (posix_memalign(&block, alignment, (size == 0) ? 1 : size) != 0)
+        return NULL;
+
+    return block;
+}
+
+// default release
+static void default_release(void * block, void * context)
+{
+    (void)context;
+    free(block);
+}
+
+static const omnia_allocator_t default_allocator = { default_allocate, default_release, NULL };
+
+static omnia_allocator_t current = { default_allocate, default_release, NULL };
+
+// Install an allocator
+void omnia_set_allocator(const omnia_allocator_t * allocator)
+{
+    if ((allocator == NULL) || (allocator->allocate == NULL))
+        current = default_allocator;
+    else
+        current = *allocator;
+}
+
+// Get the current allocator
+omnia_allocator_t omnia_get_allocator(void)
+{
+    return current;
+}
+
+// Allocate memory
+void * omnia_alloc(const size_t size)
+{
+    return current.allocate(size, OMNIA_ALIGNMENT, current.context);
+}
+
+// Release memory
+void omnia_free(void * block)
+{
+    if ((block != NULL) && (current.release != NULL))
+        current.release(block, current.context);
+}
+
+/*
+    An arena hands out consecutive, aligned pieces of one buffer and
+    never releases them individually; resetting it reclaims everything
+    at once. This suits loops that allocate the same temporaries on each
+    pass.
+*/
+
+// arena allocation: bump a pointer
+static void * arena_allocate(const size_t size, const size_t alignment, void * context)
+{
+    omnia_arena_t * arena = (omnia_arena_t *)context;
+    const uintptr_t base = (uintptr_t)arena->buffer;
+    const uintptr_t start = (base + arena->used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    const size_t offset = (size_t)(start - base);
+
+    if ((offset > arena->size) || (size > arena->size - offset))
+        return NULL;
+
+    arena->used = offset + size;
+
+    return (void *)start;
+}
+
+// arena release: nothing until the arena is reset
+static void arena_release(void * block, void * context)
+{
+    (void)block;
+    (void)context;
+}
+
+// Initialize an arena
+bool omnia_arena_init(omnia_arena_t * arena, void * buffer, const size_t size)
+{
+    if ((arena == NULL) || (buffer == NULL))
+        return false;
+
+    arena->buffer = (unsigned char *)buffer;
+    arena->size = size;
+    arena->used = 0;
+
+    return true;
+}
+
+// Release everything allocated from an arena
+void omnia_arena_reset(omnia_arena_t * arena)
+{
+    if (arena != NULL)
+        arena->used = 0;
+}
+
+// Get an allocator that draws on an arena
+omnia_allocator_t omnia_arena_allocator(omnia_arena_t * arena)
+{
+    omnia_allocator_t result = { arena_allocate, arena_release, arena };
+    return result;
+}
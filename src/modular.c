@@ -0,0 +1,235 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+
+/*
+    A product of two 64-bit residues needs 128 bits, and reducing it with
+    the % operator calls a slow 128-by-64 division routine. Montgomery
+    multiplication keeps values in the form a * 2^64 mod m, where a
+    reduction costs two multiplications and a subtraction. Converting in
+    and out of that form costs one extra reduction each, so it pays when
+    several operations share a modulus: exponentiation, or batches
+    through a prepared omnia_montgomery_t.
+*/
+
+__extension__ typedef __int128 int128_t;
+
+// number of bases sharing each pass over the exponent
+#define POW_LANES 4
+
+// Extended greatest common factor
+uint64_t omnia_gcf_extended(const uint64_t a, const uint64_t b, int64_t * x, int64_t * y)
+{
+    // intermediate coefficients can exceed 64 bits; the final ones cannot
+    uint64_t r0 = a, r1 = b;
+    int128_t s0 = 1, s1 = 0;
+    int128_t t0 = 0, t1 = 1;
+
+    while (r1 != 0)
+    {
+        const uint64_t q = r0 / r1;
+        const uint64_t r = r0 - q * r1;
+        const int128_t s = s0 - (int128_t)q * s1;
+        const int128_t t = t0 - (int128_t)q * t1;
+
+        r0 = r1;
+        r1 = r;
+        s0 = s1;
+        s1 = s;
+        t0 = t1;
+        t1 = t;
+    }
+
+    if (x != NULL)
+        *x = (int64_t)s0;
+
+    if (y != NULL)
+        *y = (int64_t)t0;
+
+    return r0;
+}
+
+// Modular inverse
+uint64_t omnia_modinv(const uint64_t a, const uint64_t m)
+{
+    int64_t x;
+
+    if (m < 2)
+        return 0;
+
+    if (omnia_gcf_extended(a % m, m, &x, NULL) != 1)
+        return 0;
+
+    return (x < 0) ? m - (uint64_t)(-x) : (uint64_t)x;
+}
+
+// Modular multiplication
+uint64_t omnia_mulmod(const uint64_t a, const uint64_t b, const uint64_t m)
+{
+    if (m == 0)
+        return 0;
+
+    return (uint64_t)(((uint128_t)a * b) % m);
+}
+
+// Modular exponentiation
+uint64_t omnia_powmod(const uint64_t base, uint64_t exponent, const uint64_t m)
+{
+    omnia_montgomery_t ctx;
+
+    if (!omnia_montgomery_init(&ctx, m))
+        return 0;
+
+    return omnia_montgomery_pow(&ctx, base, exponent);
+}
+
+// Prepare a modulus for repeated arithmetic
+bool omnia_montgomery_init(omnia_montgomery_t * ctx, const uint64_t m)
+{
+    if ((ctx == NULL) || (m == 0))
+        return false;
+
+    ctx->modulus = m;
+    ctx->odd = (m & 1) != 0;
+
+    if (ctx->odd)
+    {
+        ctx->inverse = omnia_mont_inverse(m);
+        ctx->one = (0 - m) % m;
+        ctx->r2 = (uint64_t)(((uint128_t)ctx->one * ctx->one) % m);
+    }
+    else
+    {
+        ctx->inverse = 0;
+        ctx->one = 0;
+        ctx->r2 = 0;
+    }
+
+    return true;
+}
+
+// a * b mod m; a may be any value
+static inline uint64_t mul_prepared(const omnia_montgomery_t * ctx, const uint64_t a, uint64_t b)
+{
+    const uint64_t m = ctx->modulus;
+
+    if (!ctx->odd)
+        return (uint64_t)(((uint128_t)a * b) % m);
+
+    // the reduction needs a * b < m * 2^64
+    if (b >= m)
+        b %= m;
+
+    // (a * b / R) * R^2 / R = a * b
+    return omnia_mont_mul(omnia_mont_mul(a, b, m, ctx->inverse), ctx->r2, m, ctx->inverse);
+}
+
+// Modular multiplication with a prepared modulus
+uint64_t omnia_montgomery_mul(const omnia_montgomery_t * ctx, const uint64_t a, const uint64_t b)
+{
+    return mul_prepared(ctx, a, b);
+}
+
+// Modular exponentiation with a prepared modulus
+uint64_t omnia_montgomery_pow(const omnia_montgomery_t * ctx, const uint64_t base, uint64_t exponent)
+{
+    const uint64_t m = ctx->modulus;
+
+    if (!ctx->odd)
+    {
+        uint64_t b = base % m;
+        uint64_t result = 1 % m;
+
+        while (exponent != 0)
+        {
+            if (exponent & 1)
+                result = (uint64_t)(((uint128_t)result * b) % m);
+
+            exponent >>= 1;
+
+            if (exponent != 0)
+                b = (uint64_t)(((uint128_t)b * b) % m);
+        }
+
+        return result;
+    }
+
+    const uint64_t inv = ctx->inverse;
+    const uint64_t b = omnia_mont_mul(base, ctx->r2, m, inv);
+
+    return omnia_mont_reduce(omnia_mont_pow(b, exponent, ctx->one, m, inv), m, inv);
+}
+
+// Modular multiplication of corresponding elements of two arrays
+void omnia_montgomery_mul_array(const omnia_montgomery_t * ctx, const uint64_t * a, const uint64_t * b, uint64_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_MONTGOMERY_MUL_ARRAY, n);
+
+    for (size_t i = 0; i < n; ++i)
+        result[i] = mul_prepared(ctx, a[i], b[i]);
+}
+
+// Modular exponentiation of an array of bases
+void omnia_montgomery_pow_array(const omnia_montgomery_t * ctx, const uint64_t * base, const uint64_t exponent, uint64_t * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_MONTGOMERY_POW_ARRAY, n);
+
+    const uint64_t m = ctx->modulus;
+    const uint64_t inv = ctx->inverse;
+    size_t i = 0;
+
+    // independent bases, stepped together so their multiplications overlap
+    if (ctx->odd)
+    {
+        for (; i + POW_LANES <= n; i += POW_LANES)
+        {
+            uint64_t b[POW_LANES], r[POW_LANES];
+            uint64_t e = exponent;
+            size_t k;
+
+            for (k = 0; k < POW_LANES; ++k)
+            {
+                b[k] = omnia_mont_mul(base[i + k], ctx->r2, m, inv);
+                r[k] = ctx->one;
+            }
+
+            while (e != 0)
+            {
+                if (e & 1)
+                {
+                    for (k = 0; k < POW_LANES; ++k)
+                        r[k] = omnia_mont_mul(r[k], b[k], m, inv);
+                }
+
+                e >>= 1;
+
+                if (e != 0)
+                {
+                    for (k = 0; k < POW_LANES; ++k)
+                        b[k] = omnia_mont_mul(b[k], b[k], m, inv);
+                }
+            }
+
+            for (k = 0; k < POW_LANES; ++k)
+                result[i + k] = omnia_mont_reduce(r[k], m, inv);
+        }
+    }
+
+    for (; i < n; ++i)
+        result[i] = omnia_montgomery_pow(ctx, base[i], exponent);
+}
@@ -0,0 +1,232 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include <math.h>
+#include <stdlib.h>
+
+/*
+    Samples come from MC_STREAMS streams, each a subsequence of the
+    xorshift+ generator 2^64 values from the last. Each round gives every
+    stream a share of the samples; the streams are the units of work for
+    omnia_parallel_run, and keep their own statistics, which are merged
+    in stream order after the round. Neither the samples nor the order of
+    the arithmetic depend on which thread ran a stream.
+
+    The first round gives each stream one batch. Later rounds are sized
+    from the variance so far to reach the target error, but never more
+    than double the samples taken.
+*/
+
+// independent streams of samples
+#define MC_STREAMS 64
+
+// default points per batch
+#define MC_BATCH 256
+
+// default sample limit
+#define MC_MAX_SAMPLES (UINT64_C(1) << 24)
+
+// one integration in progress
+typedef struct
+{
+    const omnia_mc_options_t * options;
+    omnia_mc_fn_t fn;
+    omnia_mc_batch_fn_t batch_fn;
+    void * data;
+
+    omnia_xs128p_t rng[MC_STREAMS];
+    omnia_running_stats_t stats[MC_STREAMS];
+    uint64_t share[MC_STREAMS];     // samples for each stream this round
+    bool failed;                    // a stream could not get memory; accessed atomically
+}
+mc_job_t;
+
+// a double in [0,1) from the top 53 bits of the generator
+static inline double uniform53(omnia_xs128p_t * rng)
+{
+    return (double)(omnia_xs128p_next_r(rng) >> 11) * 0x1.0p-53;
+}
+
+// take this round's samples for streams [begin, end)
+static void mc_range(const size_t begin, const size_t end, void * data)
+{
+    mc_job_t * job = (mc_job_t *)data;
+    const size_t dims = job->options->dims;
+    const size_t batch = job->options->batch;
+
+    // each call allocates its own buffers, since it may run on any thread
+    double * points = (double *)malloc(sizeof(double) * batch * dims);
+    double * values = (double *)malloc(sizeof(double) * batch);
+
+    if ((points == NULL) || (values == NULL))
+    {
+        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+        free(points);
+        free(values);
+        return;
+    }
+
+    for (size_t s = begin; s < end; ++s)
+    {
+        omnia_xs128p_t rng = job->rng[s];
+
+        for (uint64_t left = job->share[s]; left != 0; )
+        {
+            const size_t n = (left < batch) ? (size_t)left : batch;
+
+            for (size_t i = 0; i < n * dims; ++i)
+                points[i] = uniform53(&rng);
+
+            if (job->batch_fn != NULL)
+                job->batch_fn(points, values, n, job->data);
+            else
+            {
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = job->fn(points + i * dims, job->data);
+            }
+
+            omnia_running_stats_add_array(&job->stats[s], values, n);
+            left -= n;
+        }
+
+        job->rng[s] = rng;
+    }
+
+    free(points);
+    free(values);
+}
+
+// shared by both forms
+static bool mc_integrate(const omnia_mc_options_t * options, omnia_mc_fn_t fn, omnia_mc_batch_fn_t batch_fn, void * data, omnia_mc_result_t * result)
+{
+    if ((options == NULL) || (result == NULL) || ((fn == NULL) && (batch_fn == NULL))
+    ||  (options->dims == 0) || (options->batch == 0) || (options->max_samples == 0)
+    ||  (options->batch > SIZE_MAX / sizeof(double) / options->dims))
+        return false;
+
+    mc_job_t job;
+
+    job.options = options;
+    job.fn = fn;
+    job.batch_fn = batch_fn;
+    job.data = data;
+    job.failed = false;
+
+    omnia_xs128p_expand_seed(&job.rng[0], options->seed);
+    omnia_running_stats_init(&job.stats[0]);
+
+    for (size_t s = 1; s < MC_STREAMS; ++s)
+    {
+        job.rng[s] = job.rng[s - 1];
+        omnia_xs128p_jump_r(&job.rng[s]);
+        omnia_running_stats_init(&job.stats[s]);
+    }
+
+    const uint64_t max = options->max_samples;
+    const double target = options->target_error;
+    const uint64_t min_round = (options->batch < max / MC_STREAMS) ? MC_STREAMS * (uint64_t)options->batch : max;
+    omnia_running_stats_t total = { 0, 0.0, 0.0 };
+    uint64_t round = min_round;
+    bool converged = false;
+
+    for (;;)
+    {
+        for (size_t s = 0; s < MC_STREAMS; ++s)
+            job.share[s] = round / MC_STREAMS + ((s < round % MC_STREAMS) ? 1 : 0);
+
+        omnia_parallel_run(MC_STREAMS, 1, mc_range, &job);
+
+        if (__atomic_load_n(&job.failed, __ATOMIC_RELAXED))
+            break;
+
+        omnia_running_stats_init(&total);
+
+        for (size_t s = 0; s < MC_STREAMS; ++s)
+            omnia_running_stats_merge(&total, &job.stats[s]);
+
+        const double error = omnia_running_stats_error(&total);
+
+        if ((target > 0.0) && (total.count >= options->min_samples) && (error <= target))
+        {
+            converged = true;
+            break;
+        }
+
+        // a NaN from the integrand will not go away
+        if ((total.count >= max) || isnan(total.mean))
+            break;
+
+        // samples needed for the target, from the variance so far; without one, all of them
+        double needed = (target > 0.0) ? (double)options->min_samples : (double)max;
+
+        if (target > 0.0)
+        {
+            const double projected = omnia_running_stats_variance(&total) / (target * target);
+
+            if (projected > needed)
+                needed = projected;
+        }
+
+        round = total.count;
+
+        if (needed < (double)(total.count + round))
+            round = (needed > (double)total.count) ? (uint64_t)(needed - (double)total.count) + 1 : 0;
+
+        if (round < min_round)
+            round = min_round;
+
+        if (round > max - total.count)
+            round = max - total.count;
+    }
+
+    const bool ok = !__atomic_load_n(&job.failed, __ATOMIC_RELAXED);
+
+    if (ok)
+    {
+        result->estimate = total.mean;
+        result->error = omnia_running_stats_error(&total);
+        result->variance = omnia_running_stats_variance(&total);
+        result->samples = total.count;
+        result->converged = converged;
+    }
+
+    return ok;
+}
+
+// Default Monte Carlo settings
+void omnia_mc_options_init(omnia_mc_options_t * options, const size_t dims)
+{
+    options->dims = dims;
+    options->seed = 0x853c49e6748fea9bULL;
+    options->target_error = 0.0;
+    options->min_samples = 0;
+    options->max_samples = MC_MAX_SAMPLES;
+    options->batch = MC_BATCH;
+}
+
+// Integrate a function by Monte Carlo
+bool omnia_mc_integrate(const omnia_mc_options_t * options, omnia_mc_fn_t fn, void * data, omnia_mc_result_t * result)
+{
+    return (fn != NULL) && mc_integrate(options, fn, NULL, data, result);
+}
+
+// Integrate a batched function by Monte Carlo
+bool omnia_mc_integrate_batch(const omnia_mc_options_t * options, omnia_mc_batch_fn_t fn, void * data, omnia_mc_result_t * result)
+{
+    return (fn != NULL) && mc_integrate(options, NULL, fn, data, result);
+}
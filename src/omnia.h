@@ -29,6 +29,264 @@
 extern "C" {
 #endif
 
+/*
+    Defining OMNIA_INLINE before including this header replaces the
+    declarations of a few small, frequently called functions with static
+    inline definitions, at the end of this file, so that calls compile
+    without going through the shared library. These are omnia_gcf,
+    omnia_round_nearest, omnia_sizepow2 and the state-passing xorshift+
+    functions. The library exports the same functions from the same
+    source, so code compiled either way links against it and gets the
+    same results.
+*/
+#if defined(OMNIA_INLINE_EXPORT)
+#define OMNIA_INLINE_API
+#elif defined(OMNIA_INLINE)
+#define OMNIA_INLINE_API static inline
+#endif
+
+//-----------------------------------------------------------------------------
+// Memory allocation
+//-----------------------------------------------------------------------------
+
+//! alignment of every block the library allocates, in bytes
+#define OMNIA_ALIGNMENT 64
+
+/*!
+    A source of memory for the library. Arrays returned to the caller,
+    and the buffers inside plans and filters, are obtained through the
+    current allocator.
+*/
+typedef struct
+{
+    void * (* allocate)(const size_t size, const size_t alignment, void * context);    //! returns an aligned block, or NULL
+    void (* release)(void * block, void * context);                                    //! releases a block; may be NULL
+    void * context;                                                                    //! passed to both functions
+}
+omnia_allocator_t;
+
+/*!
+    A fixed buffer from which memory is allocated consecutively and
+    reclaimed all at once.
+*/
+typedef struct
+{
+    unsigned char * buffer; //! memory to allocate from
+    size_t size;            //! bytes in buffer
+    size_t used;            //! bytes allocated so far, including padding
+}
+omnia_arena_t;
+
+// Install an allocator
+/*!
+    Replaces the allocator used by the library. Blocks must be released
+    through the allocator that provided them, so the allocator should be
+    installed before anything is allocated, or any objects from the old
+    allocator released first. The allocator may be called from any thread
+    that uses the library.
+    \param allocator the new allocator; NULL restores the default, which uses posix_memalign and free
+*/
+void omnia_set_allocator(const omnia_allocator_t * allocator);
+
+// Get the current allocator
+/*!
+    \return a copy of the allocator in use
+*/
+omnia_allocator_t omnia_get_allocator(void);
+
+// Allocate memory
+/*!
+    Obtains a block aligned to OMNIA_ALIGNMENT from the current allocator.
+    \param size bytes required
+    \return the block, or NULL if memory is exhausted
+*/
+void * omnia_alloc(const size_t size);
+
+// Release memory
+/*!
+    Returns a block to the current allocator. Arrays returned by library
+    functions are released this way; with the default allocator, free
+    works as well.
+    \param block a block from omnia_alloc or a library function, or NULL
+*/
+void omnia_free(void * block);
+
+// Initialize an arena
+/*!
+    Prepares an arena over a caller-supplied buffer.
+    \param arena the arena
+    \param buffer memory for the arena to hand out; it must outlive the arena
+    \param size bytes in buffer
+    \return true on success, false for NULL arguments
+*/
+bool omnia_arena_init(omnia_arena_t * arena, void * buffer, const size_t size);
+
+// Release everything allocated from an arena
+/*!
+    Makes the whole arena available again. Blocks previously allocated
+    from it must no longer be used.
+    \param arena the arena
+*/
+void omnia_arena_reset(omnia_arena_t * arena);
+
+// Get an allocator that draws on an arena
+/*!
+    Creates an allocator for omnia_set_allocator that carves blocks from
+    an arena. Releasing a block does nothing; reset the arena instead.
+    The arena is not locked, so it must be used by one thread at a time.
+    \param arena the arena
+    \return an allocator using <i>arena</i>
+*/
+omnia_allocator_t omnia_arena_allocator(omnia_arena_t * arena);
+
+//-----------------------------------------------------------------------------
+// Profiling
+//-----------------------------------------------------------------------------
+
+/*!
+    Functions counted when the library is configured with
+    --enable-profile. Times are inclusive: a counted function that calls
+    another, as omnia_make_sinusoid_into calls omnia_sin_array, includes
+    the callee's time in its own.
+*/
+typedef enum
+{
+    OMNIA_PROFILE_XS128P_FILL,
+    OMNIA_PROFILE_KISS64_FILL,
+    OMNIA_PROFILE_KISS32_FILL,
+    OMNIA_PROFILE_XOSHIRO256SS_FILL,
+    OMNIA_PROFILE_XOSHIRO256PP_FILL,
+    OMNIA_PROFILE_PCG64_FILL,
+    OMNIA_PROFILE_WYRAND_FILL,
+    OMNIA_PROFILE_SOBOL_FILL,
+    OMNIA_PROFILE_HALTON_FILL,
+    OMNIA_PROFILE_ALIAS_FILL,
+    OMNIA_PROFILE_ROUND_NEAREST_ARRAY,
+    OMNIA_PROFILE_SIGDIG_ARRAY,
+    OMNIA_PROFILE_FORMAT_ARRAY,
+    OMNIA_PROFILE_GCF_ARRAY,
+    OMNIA_PROFILE_LCM_ARRAY,
+    OMNIA_PROFILE_GCF_PAIRWISE,
+    OMNIA_PROFILE_MONTGOMERY_MUL_ARRAY,
+    OMNIA_PROFILE_MONTGOMERY_POW_ARRAY,
+    OMNIA_PROFILE_IS_PRIME_ARRAY,
+    OMNIA_PROFILE_SIEVE_PRIMES,
+    OMNIA_PROFILE_RATIONAL_NORMALIZE_ARRAY,
+    OMNIA_PROFILE_RATIONAL_SUM,
+    OMNIA_PROFILE_LOG_ARRAY,
+    OMNIA_PROFILE_LOG_BASE_ARRAY,
+    OMNIA_PROFILE_EXP_ARRAY,
+    OMNIA_PROFILE_SIN_ARRAY,
+    OMNIA_PROFILE_COS_ARRAY,
+    OMNIA_PROFILE_SINCOS_ARRAY,
+    OMNIA_PROFILE_ASINH_ARRAY,
+    OMNIA_PROFILE_ACOSH_ARRAY,
+    OMNIA_PROFILE_ATANH_ARRAY,
+    OMNIA_PROFILE_MOVING_AVERAGE,
+    OMNIA_PROFILE_BASIC_STATS,
+    OMNIA_PROFILE_MAKE_SINUSOID,
+    OMNIA_PROFILE_ADD_NOISE,
+    OMNIA_PROFILE_FFT_EXECUTE,
+    OMNIA_PROFILE_FIR_PROCESS,
+    OMNIA_PROFILE_IIR_PROCESS,
+    OMNIA_PROFILE_AUTOCORRELATION,
+    OMNIA_PROFILE_CROSS_CORRELATION,
+    OMNIA_PROFILE_GOERTZEL,
+    OMNIA_PROFILE_COUNT
+}
+omnia_profile_id_t;
+
+//! Totals for one counted function
+typedef struct
+{
+    const char * name;  //! name of the function
+    uint64_t calls;     //! number of calls
+    uint64_t elements;  //! array elements, or values, processed by those calls
+    uint64_t cycles;    //! time-stamp counter ticks spent in those calls (nanoseconds where there is no such counter)
+}
+omnia_profile_entry_t;
+
+// Is profiling compiled in?
+/*!
+    \return true if the library was configured with --enable-profile
+*/
+bool omnia_profile_enabled(void);
+
+// Take a snapshot of the profile counters
+/*!
+    Sums the counters of every thread that has called a counted function,
+    including threads that have since exited. Counters are updated
+    without locking, so calls in progress on other threads may or may not
+    be included. Without profiling, every count is zero.
+    \param result array of OMNIA_PROFILE_COUNT entries, indexed by omnia_profile_id_t
+*/
+void omnia_profile_snapshot(omnia_profile_entry_t result[OMNIA_PROFILE_COUNT]);
+
+// Reset the profile counters
+/*!
+    Sets every counter to zero, for all threads. Safe to call while other
+    threads are counting.
+*/
+void omnia_profile_reset(void);
+
+//-----------------------------------------------------------------------------
+// Parallel execution
+//-----------------------------------------------------------------------------
+
+/*!
+    A function that processes the elements [begin, end) of some loop.
+    It may be called from any of the library's threads, and concurrently
+    with itself for other ranges.
+*/
+typedef void (* omnia_range_fn_t)(const size_t begin, const size_t end, void * data);
+
+// Set the number of threads
+/*!
+    Sets the number of threads, including the caller's, that parallel
+    loops may use: omnia_parallel_for, the array statistics and signal
+    functions, and the prime sieve when asked for its default. The
+    library's worker threads are started when first needed.
+    \param threads number of threads; 1 keeps everything on the calling thread, 0 uses one per online processor (the default)
+*/
+void omnia_set_threads(const size_t threads);
+
+// Get the number of threads
+/*!
+    \return the number of threads parallel loops may use
+*/
+size_t omnia_get_threads(void);
+
+// Set the grain size
+/*!
+    Sets the number of elements in each chunk of a parallel loop. Loops
+    no longer than one chunk run on the calling thread, so this is also
+    the size below which the array functions stay single-threaded.
+    \param grain elements per chunk; 0 restores the default of 65536
+*/
+void omnia_set_grain(const size_t grain);
+
+// Get the grain size
+/*!
+    \return the number of elements in each chunk of a parallel loop
+*/
+size_t omnia_get_grain(void);
+
+// Run a loop on the library's threads
+/*!
+    Calls <i>fn</i> once for each chunk of [0, n), each chunk being
+    omnia_get_grain() elements except perhaps the last, and returns when
+    all have finished. Chunks are spread over the threads, with idle
+    threads stealing work from busy ones. A parallel loop started from
+    inside <i>fn</i> runs on the thread that started it, as does one
+    started by another thread while the library's threads are busy.
+    <i>fn</i> may call omnia_get_threads and omnia_set_threads; a new
+    setting applies to later loops.
+    \param n number of elements
+    \param fn function to process each chunk
+    \param data passed to <i>fn</i>
+*/
+void omnia_parallel_for(const size_t n, omnia_range_fn_t fn, void * data);
+
 //-----------------------------------------------------------------------------
 // Psuedo-random number generator -- xorshift+ 64 bits
 //-----------------------------------------------------------------------------
@@ -73,6 +331,91 @@ size_t omnia_xs128p_index(const size_t length);
 */
 double omnia_xs128p_real();
 
+//! Fill an array with integers
+/*!
+    Stores the next <i>n</i> values in sequence, exactly as <i>n</i> calls
+    to omnia_xs128p_next would, with the state kept in registers.
+    \param result - Array of at least n elements to receive the values
+    \param n - Number of values
+*/
+void omnia_xs128p_fill(uint64_t * result, const size_t n);
+
+//! Jump ahead by 2^64 values
+/*!
+    Advances the generator as if omnia_xs128p_next had been called 2^64
+    times. Jumping a seeded generator k times starts the k-th of up to
+    2^64 non-overlapping subsequences, for parallel streams.
+*/
+void omnia_xs128p_jump();
+
+//! State of an xorshift+ generator owned by the caller
+/*!
+    The functions with an _r suffix keep their state here instead of in
+    the library, so that each thread or object can have its own stream.
+    The state must be seeded so that it is not all zero.
+*/
+typedef struct
+{
+    uint64_t s[2];  //! the 128 bits of state
+}
+omnia_xs128p_t;
+
+#if !defined(OMNIA_INLINE)
+
+//! Seed a caller-owned generator
+/*!
+    \param state generator to initialize
+    \param seed initialization seed, as for omnia_xs128p_set_seed
+*/
+void omnia_xs128p_seed_r(omnia_xs128p_t * state, const uint64_t seed[2]);
+
+//! Get the next integer from a caller-owned generator
+/*!
+    \param state generator
+    \return A pseudorandom uint64_t value
+*/
+uint64_t omnia_xs128p_next_r(omnia_xs128p_t * state);
+
+//! Get the next integer in the range [lo,hi] from a caller-owned generator
+/*!
+    \param state generator
+    \param lo - Minimum value of result
+    \param hi - Maximum value of result
+    \return A pseudorandom uint64_t value
+*/
+uint64_t omnia_xs128p_range_r(omnia_xs128p_t * state, uint64_t lo, uint64_t hi);
+
+//! Get the next index in [0,length) from a caller-owned generator
+/*!
+    \param state generator
+    \param length - Maximum value of result
+    \return A pseudorandom size_t value
+*/
+size_t omnia_xs128p_index_r(omnia_xs128p_t * state, const size_t length);
+
+//! Get the next number in the range [0,1] from a caller-owned generator
+/*!
+    \param state generator
+    \return A pseudorandom double value
+*/
+double omnia_xs128p_real_r(omnia_xs128p_t * state);
+
+#endif
+
+//! Fill an array from a caller-owned generator
+/*!
+    \param state generator
+    \param result - Array of at least n elements to receive the values
+    \param n - Number of values
+*/
+void omnia_xs128p_fill_r(omnia_xs128p_t * state, uint64_t * result, const size_t n);
+
+//! Jump a caller-owned generator ahead by 2^64 values
+/*!
+    \param state generator
+*/
+void omnia_xs128p_jump_r(omnia_xs128p_t * state);
+
 //-----------------------------------------------------------------------------
 // Psuedo-random number generator -- Kiss 64 bits
 //-----------------------------------------------------------------------------
@@ -117,113 +460,1608 @@ size_t omnia_kiss64_index(const size_t length);
 */
 double omnia_kiss64_real();
 
+//! Fill an array with integers
+/*!
+    Stores the next <i>n</i> values in sequence, exactly as <i>n</i> calls
+    to omnia_kiss64_next would, with the state kept in registers.
+    \param result - Array of at least n elements to receive the values
+    \param n - Number of values
+*/
+void omnia_kiss64_fill(uint64_t * result, const size_t n);
+
 //-----------------------------------------------------------------------------
 // Psuedo-random number generator -- 32 bits
 //-----------------------------------------------------------------------------
 
-//! Initialize a psuedo-random number generator (PRNG)
+//! Initialize a psuedo-random number generator (PRNG)
+/*!
+    Initializes a psuedo-random number generator using a specified seed.
+    \param seed Initialization seed
+*/
+void omnia_kiss32_set_seed(const uint32_t seed);
+
+//!  Get the next integer
+/*!
+    Returns the next uint32_t in sequence.
+    \return A pseudorandom uint32_t value
+*/
+uint32_t omnia_kiss32_next();
+
+//! Get the next integer in the range [lo,hi]
+/*!
+    Returns the next int_value between lo and hi, inclusive.
+    \param lo - Minimum value of result
+    \param hi - Maximum value of result
+    \return A pseudorandom uint32_t value
+*/
+uint32_t omnia_kiss32_range(const uint32_t lo, const uint32_t hi);
+
+//! Get the next random value as a size_t index
+/*!
+    Returns the next value as a size_t "index" in the range [0,length).
+    \param length - Maximum value of result
+    \return A pseudorandom size_t value
+*/
+size_t omnia_kiss32_index(const size_t length);
+
+//! Get the next number in the range [0,1)
+/*!
+    Returns the next real number in the range [0,1], i.e., a number
+    greater than or equal to 0 and less than or equal to 1.
+    Provides 32-bit precision.
+    \return A pseudorandom double value
+*/
+double omnia_kiss32_real();
+
+//! Fill an array with integers
+/*!
+    Stores the next <i>n</i> values in sequence, exactly as <i>n</i> calls
+    to omnia_kiss32_next would, with the state kept in registers.
+    \param result - Array of at least n elements to receive the values
+    \param n - Number of values
+*/
+void omnia_kiss32_fill(uint32_t * result, const size_t n);
+
+//-----------------------------------------------------------------------------
+// Psuedo-random number generators -- xoshiro256, PCG64 and wyrand
+//-----------------------------------------------------------------------------
+
+/*!
+    Newer generators with caller-owned state. xoshiro256** and
+    xoshiro256++ share a 256-bit state with a period of 2^256 - 1; PCG64
+    is a 128-bit linear congruential generator with a permuted output,
+    with one of 2^127 streams chosen at seeding; wyrand is a 64-bit Weyl
+    counter with a multiplicative output, and is the fastest of them.
+    Each fill function stores exactly the values that as many calls to
+    the matching next function would return.
+*/
+typedef struct
+{
+    uint64_t s[4];  //! the 256 bits of state
+}
+omnia_xoshiro256_t;
+
+//! State of a PCG64 generator
+typedef struct
+{
+    uint64_t state[2];  //! 128-bit state, low word first
+    uint64_t inc[2];    //! 128-bit odd increment, low word first
+}
+omnia_pcg64_t;
+
+//! State of a wyrand generator
+typedef struct
+{
+    uint64_t s;     //! the 64-bit counter
+}
+omnia_wyrand_t;
+
+//! Seed a xoshiro256 generator
+/*!
+    Expands one value into the whole state, which is never all zero.
+    \param state generator to initialize
+    \param seed initialization seed
+*/
+void omnia_xoshiro256_seed_r(omnia_xoshiro256_t * state, const uint64_t seed);
+
+//! Get the next xoshiro256** integer
+/*!
+    \param state generator
+    \return A pseudorandom uint64_t value
+*/
+uint64_t omnia_xoshiro256ss_next_r(omnia_xoshiro256_t * state);
+
+//! Get the next xoshiro256++ integer
+/*!
+    \param state generator
+    \return A pseudorandom uint64_t value
+*/
+uint64_t omnia_xoshiro256pp_next_r(omnia_xoshiro256_t * state);
+
+//! Fill an array from a xoshiro256** generator
+/*!
+    \param state generator
+    \param result - Array of at least n elements to receive the values
+    \param n - Number of values
+*/
+void omnia_xoshiro256ss_fill_r(omnia_xoshiro256_t * state, uint64_t * result, const size_t n);
+
+//! Fill an array from a xoshiro256++ generator
+/*!
+    \param state generator
+    \param result - Array of at least n elements to receive the values
+    \param n - Number of values
+*/
+void omnia_xoshiro256pp_fill_r(omnia_xoshiro256_t * state, uint64_t * result, const size_t n);
+
+//! Jump a xoshiro256 generator ahead by 2^128 values
+/*!
+    The same jump serves both output functions.
+    \param state generator
+*/
+void omnia_xoshiro256_jump_r(omnia_xoshiro256_t * state);
+
+//! Seed a PCG64 generator
+/*!
+    Follows the reference implementation's pcg64_srandom_r, so that the
+    same seed and stream give the same values.
+    \param state generator to initialize
+    \param seed 128-bit initial state, low word first
+    \param stream 128-bit stream selector, low word first; the top bit is ignored
+*/
+void omnia_pcg64_seed_r(omnia_pcg64_t * state, const uint64_t seed[2], const uint64_t stream[2]);
+
+//! Get the next PCG64 integer
+/*!
+    \param state generator
+    \return A pseudorandom uint64_t value
+*/
+uint64_t omnia_pcg64_next_r(omnia_pcg64_t * state);
+
+//! Fill an array from a PCG64 generator
+/*!
+    \param state generator
+    \param result - Array of at least n elements to receive the values
+    \param n - Number of values
+*/
+void omnia_pcg64_fill_r(omnia_pcg64_t * state, uint64_t * result, const size_t n);
+
+//! Jump a PCG64 generator ahead by 2^64 values
+/*!
+    \param state generator
+*/
+void omnia_pcg64_jump_r(omnia_pcg64_t * state);
+
+//! Seed a wyrand generator
+/*!
+    Any value is a valid seed.
+    \param state generator to initialize
+    \param seed initialization seed
+*/
+void omnia_wyrand_seed_r(omnia_wyrand_t * state, const uint64_t seed);
+
+//! Get the next wyrand integer
+/*!
+    \param state generator
+    \return A pseudorandom uint64_t value
+*/
+uint64_t omnia_wyrand_next_r(omnia_wyrand_t * state);
+
+//! Fill an array from a wyrand generator
+/*!
+    \param state generator
+    \param result - Array of at least n elements to receive the values
+    \param n - Number of values
+*/
+void omnia_wyrand_fill_r(omnia_wyrand_t * state, uint64_t * result, const size_t n);
+
+//! Jump a wyrand generator ahead by 2^32 values
+/*!
+    The period is only 2^64, so this gives at most 2^32 disjoint streams.
+    \param state generator
+*/
+void omnia_wyrand_jump_r(omnia_wyrand_t * state);
+
+//-----------------------------------------------------------------------------
+// Common generator interface
+//-----------------------------------------------------------------------------
+
+/*!
+    A generator descriptor lets code choose an algorithm at run time
+    without changing its call sites. The state is untyped; allocate
+    state_size bytes, or use an omnia_generator_state_t, which holds the
+    state of any generator here, and seed it before use. The xorshift+
+    descriptor seeds as the library's other users of omnia_xs128p_t do.
+    KISS has no caller-owned state, and no descriptor.
+*/
+typedef struct
+{
+    const char * name;                                      //! short name, as given to omnia_find_generator
+    size_t state_size;                                      //! bytes of state
+    int jump_log2;                                          //! jump distance is 2^jump_log2 values
+    void (*seed)(void * state, const uint64_t seed);        //! initialize state from one value
+    uint64_t (*next)(void * state);                         //! next 64-bit value
+    void (*fill)(void * state, uint64_t * result, size_t n);//! next n values
+    void (*jump)(void * state);                             //! advance 2^jump_log2 values
+}
+omnia_generator_t;
+
+//! Storage for the state of any described generator
+typedef union
+{
+    uint64_t words[4];
+    omnia_xs128p_t xs128p;
+    omnia_xoshiro256_t xoshiro256;
+    omnia_pcg64_t pcg64;
+    omnia_wyrand_t wyrand;
+}
+omnia_generator_state_t;
+
+//! Described generators
+typedef enum
+{
+    OMNIA_GENERATOR_XS128P,
+    OMNIA_GENERATOR_XOSHIRO256SS,
+    OMNIA_GENERATOR_XOSHIRO256PP,
+    OMNIA_GENERATOR_PCG64,
+    OMNIA_GENERATOR_WYRAND,
+    OMNIA_GENERATOR_COUNT
+}
+omnia_generator_id_t;
+
+//! Get a generator descriptor
+/*!
+    \param id generator
+    \return The descriptor, or NULL for an unknown id
+*/
+const omnia_generator_t * omnia_get_generator(const omnia_generator_id_t id);
+
+//! Find a generator descriptor by name
+/*!
+    \param name "xs128p", "xoshiro256ss", "xoshiro256pp", "pcg64" or "wyrand"
+    \return The descriptor, or NULL if there is none by that name
+*/
+const omnia_generator_t * omnia_find_generator(const char * name);
+
+//! Get the next number in the range [0,1) from a described generator
+/*!
+    Uses the top 53 bits of the next value.
+    \param generator descriptor
+    \param state state of that generator
+    \return A pseudorandom double value
+*/
+double omnia_generator_real(const omnia_generator_t * generator, void * state);
+
+//-----------------------------------------------------------------------------
+// Low-discrepancy sequences
+//-----------------------------------------------------------------------------
+
+/*!
+    Sobol and Halton sequences fill the unit hypercube more evenly than
+    pseudo-random points, for quasi-Monte Carlo integration. A sequence
+    has a position, the index of its next point, that can be set to any
+    value; threads can generate disjoint blocks of one sequence by giving
+    each its own generator, created with the same arguments, and seeking
+    each to the start of its block.
+
+    Points are stored one after another, with the coordinates of each
+    point consecutive.
+*/
+
+//! maximum number of dimensions of a sequence
+#define OMNIA_LOWDISC_MAX_DIMENSIONS 1024
+
+//! number of points in a sequence; indices run from 0 to OMNIA_LOWDISC_MAX_POINTS - 1
+#define OMNIA_LOWDISC_MAX_POINTS 0x100000000ULL
+
+//! A Sobol sequence generator
+typedef struct omnia_sobol_s omnia_sobol_t;
+
+//! A Halton sequence generator
+typedef struct omnia_halton_s omnia_halton_t;
+
+// Create a Sobol sequence generator
+/*!
+    Uses the direction numbers of Joe and Kuo, and generates points in
+    Gray-code order, which visits the same points as the natural order
+    within each block of 2^k points starting at a multiple of 2^k. The
+    first point is the origin. Coordinates are multiples of 2^-32.
+    \param dims number of dimensions, from 1 to OMNIA_LOWDISC_MAX_DIMENSIONS
+    
+eturn a generator positioned at index 0, or NULL for invalid arguments or exhausted memory
+*/
+omnia_sobol_t * omnia_sobol_create(const size_t dims);
+
+// Create a scrambled Sobol sequence generator
+/*!
+    Applies a random linear matrix scramble and a random digital shift,
+    drawn from <i>seed</i>, to the sequence of omnia_sobol_create. The
+    points keep the stratification of the original sequence, but are
+    randomized, so independent seeds give independent error estimates.
+    \param dims number of dimensions, from 1 to OMNIA_LOWDISC_MAX_DIMENSIONS
+    \param seed selects the scramble; equal seeds give equal sequences
+    
+eturn a generator positioned at index 0, or NULL for invalid arguments or exhausted memory
+*/
+omnia_sobol_t * omnia_sobol_create_scrambled(const size_t dims, const uint64_t seed);
+
+// Release a Sobol sequence generator
+/*!
+    \param sobol the generator, or NULL
+*/
+void omnia_sobol_free(omnia_sobol_t * sobol);
+
+// Number of dimensions of a Sobol sequence
+/*!
+    \param sobol the generator
+    
+eturn the number of coordinates in each point
+*/
+size_t omnia_sobol_dimensions(const omnia_sobol_t * sobol);
+
+// Index of the next Sobol point
+/*!
+    \param sobol the generator
+    
+eturn the index of the point the next call will produce; OMNIA_LOWDISC_MAX_POINTS when exhausted
+*/
+uint64_t omnia_sobol_index(const omnia_sobol_t * sobol);
+
+// Move to any point of a Sobol sequence
+/*!
+    Positions the generator in time independent of the distance moved.
+    \param sobol the generator
+    \param index index of the next point to produce, up to OMNIA_LOWDISC_MAX_POINTS
+    
+eturn true on success, false if <i>index</i> is out of range
+*/
+bool omnia_sobol_seek(omnia_sobol_t * sobol, const uint64_t index);
+
+// Get the next Sobol point
+/*!
+    \param sobol the generator
+    \param point array of omnia_sobol_dimensions(sobol) elements to receive the coordinates
+    
+eturn true on success, false if the sequence is exhausted
+*/
+bool omnia_sobol_next(omnia_sobol_t * sobol, double * point);
+
+// Get a block of Sobol points
+/*!
+    Produces the next <i>n</i> points, exactly as <i>n</i> calls to
+    omnia_sobol_next would.
+    \param sobol the generator
+    \param points array of n * omnia_sobol_dimensions(sobol) elements to receive the points
+    \param n number of points
+    
+eturn the number of points stored, fewer than <i>n</i> only if the sequence runs out
+*/
+size_t omnia_sobol_fill(omnia_sobol_t * sobol, double * points, const size_t n);
+
+// Create a Halton sequence generator
+/*!
+    Coordinate j of point i is the radical inverse of i in the base of
+    the (j+1)-th prime. The first point is the origin.
+    \param dims number of dimensions, from 1 to OMNIA_LOWDISC_MAX_DIMENSIONS
+    
+eturn a generator positioned at index 0, or NULL for invalid arguments or exhausted memory
+*/
+omnia_halton_t * omnia_halton_create(const size_t dims);
+
+// Create a scrambled Halton sequence generator
+/*!
+    Replaces each digit d at each position of each radical inverse with
+    (a * d + c) mod b, for random a and c drawn from <i>seed</i>, with a
+    nonzero. This removes the correlation between the high dimensions of
+    the plain sequence, whose large bases make consecutive points move
+    in lockstep.
+    \param dims number of dimensions, from 1 to OMNIA_LOWDISC_MAX_DIMENSIONS
+    \param seed selects the scramble; equal seeds give equal sequences
+    
+eturn a generator positioned at index 0, or NULL for invalid arguments or exhausted memory
+*/
+omnia_halton_t * omnia_halton_create_scrambled(const size_t dims, const uint64_t seed);
+
+// Release a Halton sequence generator
+/*!
+    \param halton the generator, or NULL
+*/
+void omnia_halton_free(omnia_halton_t * halton);
+
+// Number of dimensions of a Halton sequence
+/*!
+    \param halton the generator
+    
+eturn the number of coordinates in each point
+*/
+size_t omnia_halton_dimensions(const omnia_halton_t * halton);
+
+// Index of the next Halton point
+/*!
+    \param halton the generator
+    
+eturn the index of the point the next call will produce; OMNIA_LOWDISC_MAX_POINTS when exhausted
+*/
+uint64_t omnia_halton_index(const omnia_halton_t * halton);
+
+// Move to any point of a Halton sequence
+/*!
+    \param halton the generator
+    \param index index of the next point to produce, up to OMNIA_LOWDISC_MAX_POINTS
+    
+eturn true on success, false if <i>index</i> is out of range
+*/
+bool omnia_halton_seek(omnia_halton_t * halton, const uint64_t index);
+
+// Get the next Halton point
+/*!
+    \param halton the generator
+    \param point array of omnia_halton_dimensions(halton) elements to receive the coordinates
+    
+eturn true on success, false if the sequence is exhausted
+*/
+bool omnia_halton_next(omnia_halton_t * halton, double * point);
+
+// Get a block of Halton points
+/*!
+    Produces the next <i>n</i> points, exactly as <i>n</i> calls to
+    omnia_halton_next would.
+    \param halton the generator
+    \param points array of n * omnia_halton_dimensions(halton) elements to receive the points
+    \param n number of points
+    
+eturn the number of points stored, fewer than <i>n</i> only if the sequence runs out
+*/
+size_t omnia_halton_fill(omnia_halton_t * halton, double * points, const size_t n);
+
+//-----------------------------------------------------------------------------
+// Monte Carlo integration
+//-----------------------------------------------------------------------------
+
+/*!
+    An integrand: the value of a function at a point of the unit
+    hypercube [0,1)^dims. The engine calls it from the library's threads,
+    concurrently with itself; an integrand that cannot run concurrently
+    should be used with omnia_set_threads(1).
+*/
+typedef double (* omnia_mc_fn_t)(const double * point, void * data);
+
+/*!
+    A batched integrand: stores the values at <i>n</i> points in
+    <i>values</i>. The points are stored one after another, with the
+    coordinates of each point consecutive. Called concurrently, like
+    omnia_mc_fn_t.
+*/
+typedef void (* omnia_mc_batch_fn_t)(const double * points, double * values, const size_t n, void * data);
+
+//! Settings for a Monte Carlo integration
+typedef struct
+{
+    size_t dims;            //! dimensions of the integration domain
+    uint64_t seed;          //! selects the random points; equal seeds give equal results
+    double target_error;    //! stop once the standard error is at most this; 0 runs to max_samples
+    uint64_t min_samples;   //! samples to take before testing target_error
+    uint64_t max_samples;   //! stop after this many samples whether or not the target is met
+    size_t batch;           //! points per call of a batched integrand
+}
+omnia_mc_options_t;
+
+//! Outcome of a Monte Carlo integration
+typedef struct
+{
+    double estimate;    //! estimated integral over the unit hypercube
+    double error;       //! standard error of the estimate
+    double variance;    //! sample variance of the integrand's values
+    uint64_t samples;   //! number of points evaluated
+    bool converged;     //! true if the target error was met
+}
+omnia_mc_result_t;
+
+// Default Monte Carlo settings
+/*!
+    Sets a fixed seed, no target error, no minimum, a maximum of 2^24
+    samples, and batches of 256 points.
+    \param options settings to initialize
+    \param dims dimensions of the integration domain
+*/
+void omnia_mc_options_init(omnia_mc_options_t * options, const size_t dims);
+
+// Integrate a function by Monte Carlo
+/*!
+    Averages <i>fn</i> over uniformly distributed random points of the
+    unit hypercube. Samples are drawn in rounds from 64 streams, each a
+    separate subsequence of an xorshift+ generator; rounds run on the
+    library's threads, and the statistics of the streams are merged in
+    a fixed order, so the result depends on the seed but not on the
+    number of threads. After each round, the engine stops if it has taken
+    at least <i>min_samples</i> and the standard error is at most
+    <i>target_error</i>, or if it has taken <i>max_samples</i>.
+    \param options settings
+    \param fn the integrand
+    \param data passed to <i>fn</i>
+    \param result receives the estimate and its error
+    \return true on success, false for invalid arguments or if memory is exhausted
+*/
+bool omnia_mc_integrate(const omnia_mc_options_t * options, omnia_mc_fn_t fn, void * data, omnia_mc_result_t * result);
+
+// Integrate a batched function by Monte Carlo
+/*!
+    As omnia_mc_integrate, giving the integrand up to <i>batch</i>
+    points at a time. The points, and so the result, are the same as for
+    omnia_mc_integrate with an equivalent scalar integrand.
+    \param options settings
+    \param fn the integrand
+    \param data passed to <i>fn</i>
+    \param result receives the estimate and its error
+    \return true on success, false for invalid arguments or if memory is exhausted
+*/
+bool omnia_mc_integrate_batch(const omnia_mc_options_t * options, omnia_mc_batch_fn_t fn, void * data, omnia_mc_result_t * result);
+
+//-----------------------------------------------------------------------------
+// Weighted sampling
+//-----------------------------------------------------------------------------
+
+/*!
+    An alias table, for choosing among categories with given weights in
+    constant time. Each draw takes one 64-bit random value and reads one
+    8-byte entry: the value picks a column, and a threshold in the column
+    decides between its own category and its alias. A table is not
+    changed by drawing, so threads may share one.
+*/
+typedef struct omnia_alias_s omnia_alias_t;
+
+// Create an alias table
+/*!
+    Builds the table with Vose's method, in time proportional to the
+    number of categories. Categories of weight zero are never drawn; the
+    others are drawn with probability proportional to their weights, to
+    within 2^-32 of each column.
+    \param weights non-negative, finite weight of each category
+    \param n number of categories, at most 2^32 - 1
+    \return a new table, or NULL if the weights are invalid or all zero, or memory is exhausted
+*/
+omnia_alias_t * omnia_alias_create(const double * weights, const size_t n);
+
+// Release an alias table
+/*!
+    \param table the table, or NULL
+*/
+void omnia_alias_free(omnia_alias_t * table);
+
+// Number of categories in an alias table
+/*!
+    \param table the table
+    \return the number of categories
+*/
+size_t omnia_alias_size(const omnia_alias_t * table);
+
+// Choose a category with a given random value
+/*!
+    Maps a uniformly distributed 64-bit value to a category, so that any
+    generator can drive the table.
+    \param table the table
+    \param random a random value
+    \return the chosen category
+*/
+size_t omnia_alias_pick(const omnia_alias_t * table, const uint64_t random);
+
+// Choose categories for an array of random values
+/*!
+    \param table the table
+    \param random uniformly distributed 64-bit values
+    \param result array of at least n elements to receive the categories
+    \param n number of values
+*/
+void omnia_alias_map(const omnia_alias_t * table, const uint64_t * random, size_t * result, const size_t n);
+
+// Draw a category
+/*!
+    Uses the library's xorshift+ generator, as omnia_xs128p_next does.
+    \param table the table
+    \return the chosen category
+*/
+size_t omnia_alias_sample(const omnia_alias_t * table);
+
+// Draw a category with a caller-owned generator
+/*!
+    \param table the table
+    \param state generator
+    \return the chosen category
+*/
+size_t omnia_alias_sample_r(const omnia_alias_t * table, omnia_xs128p_t * state);
+
+// Draw an array of categories
+/*!
+    Draws exactly as <i>n</i> calls to omnia_alias_sample would.
+    \param table the table
+    \param result array of at least n elements to receive the categories
+    \param n number of draws
+*/
+void omnia_alias_fill(const omnia_alias_t * table, size_t * result, const size_t n);
+
+// Draw an array of categories with a caller-owned generator
+/*!
+    \param table the table
+    \param state generator
+    \param result array of at least n elements to receive the categories
+    \param n number of draws
+*/
+void omnia_alias_fill_r(const omnia_alias_t * table, omnia_xs128p_t * state, size_t * result, const size_t n);
+
+//-----------------------------------------------------------------------------
+// Rounding
+//-----------------------------------------------------------------------------
+
+#if !defined(OMNIA_INLINE)
+
+//! Round to nearest value
+/*!
+    Rounds a value to nearest integer, rounding to even for exact fractions of 0.5.
+*/
+double omnia_round_nearest(const double x);
+
+#endif
+
+// Set number of significant digits in a floating-point value
+/*!
+    Returns the given value rounded for the number of specified decimal
+    digits of precision.
+    \param x - Original value to be rounded
+    \param n - Number of significant digits
+    \return The value <i>x</i> rounded to <i>n</i> digits of precision
+*/
+double omnia_sigdig(const double x, const uint16_t n);
+
+//! Round each element of an array to the nearest integer
+/*!
+    Array form of omnia_round_nearest, producing identical results under
+    the default floating-point rounding mode. The loop vectorizes.
+    \param x array of values to be rounded
+    \param result receives <i>n</i> rounded values; may be the same array as <i>x</i>
+    \param n number of elements
+*/
+void omnia_round_nearest_array(const double * x, double * result, const size_t n);
+
+// Round each element of an array to a number of significant digits
+/*!
+    Array form of omnia_sigdig, producing identical results. Decimal
+    exponents and scale factors come from a table of powers of ten
+    rather than calls to log10, floor and pow.
+    \param x array of values to be rounded
+    \param result receives <i>n</i> rounded values; may be the same array as <i>x</i>
+    \param n number of elements
+    \param digits number of significant digits
+*/
+void omnia_sigdig_array(const double * x, double * result, const size_t n, const uint16_t digits);
+
+// Decimal exponent of a value
+/*!
+    Returns the exponent <i>e</i> such that 10<sup>e</sup> <= |x| < 10<sup>e+1</sup>,
+    i.e., the exponent of <i>x</i> in scientific notation, without calls to
+    log10. A value within half an ULP of a power of ten may be counted as
+    that power.
+    \param x a value
+    \return the decimal exponent of <i>x</i>; zero if <i>x</i> is zero, infinite or NaN
+*/
+int omnia_decimal_exponent(const double x);
+
+//-----------------------------------------------------------------------------
+// Formatting
+//-----------------------------------------------------------------------------
+
+//! Buffer size sufficient for any value written by the formatting functions
+#define OMNIA_FORMAT_BUFFER_SIZE 32
+
+// Format a double as the shortest text that reads back to the same value
+/*!
+    Writes the shortest decimal text that strtod converts back to exactly
+    <i>x</i>, using the Ryu algorithm. The layout follows printf's %g
+    with 17 digits of precision: plain notation for exponents from -5 to
+    16, scientific notation otherwise. The decimal point is always '.',
+    regardless of locale.
+    \param x value to be formatted
+    \param buffer receives the null-terminated text; at least OMNIA_FORMAT_BUFFER_SIZE characters
+    \return the number of characters written, excluding the terminating null
+*/
+size_t omnia_format_double(const double x, char * buffer);
+
+// Format a double with a number of significant digits
+/*!
+    Writes <i>x</i> with at most <i>digits</i> significant digits, laid out
+    like printf's %.<i>digits</i>g. The digits are the exact binary value
+    rounded half-to-even, as printf rounds it, so 0.15 gives "0.1" with one
+    digit. Most values are rounded from their shortest representation;
+    the rest are computed exactly, which is slower.
+    \param x value to be formatted
+    \param digits number of significant digits; 0 or 17 and above select the shortest representation
+    \param buffer receives the null-terminated text; at least OMNIA_FORMAT_BUFFER_SIZE characters
+    \return the number of characters written, excluding the terminating null
+*/
+size_t omnia_format_sigdig(const double x, const uint16_t digits, char * buffer);
+
+// Format an array of doubles as delimited text
+/*!
+    Writes as many elements of an array as fit in a buffer, separated by
+    a delimiter, as for a row of a CSV file. Each value is formatted as
+    by omnia_format_sigdig.
+    \param x array of values
+    \param n number of elements in x
+    \param digits number of significant digits; 0 selects the shortest representation
+    \param separator character placed between values
+    \param buffer receives the null-terminated text
+    \param size capacity of buffer, in characters
+    \param written if not NULL, receives the number of characters written, excluding the terminating null
+    \return the number of elements written; less than <i>n</i> if the buffer filled
+*/
+size_t omnia_format_array(const double * x, const size_t n, const uint16_t digits, const char separator, char * buffer, const size_t size, size_t * written);
+
+//-----------------------------------------------------------------------------
+// Lowest Common Multple (LCM) and Lowest Common Denominator (GCD)
+//-----------------------------------------------------------------------------
+
+// Lowest common multiple
+/*!
+    Calculates the lowest common multiple for two values.
+    \param x first value
+    \param y second value
+    \return The lowest common multiple for <i>x</i> and <i>y</i>
+*/
+uint64_t omnia_lcm(const uint64_t x, const uint64_t y);
+
+#if !defined(OMNIA_INLINE)
+
+// Greatest common factor (denominator)
+/*!
+    Calculates the greatest common factor for two values.
+    \param x first value
+    \param y second value
+    \return The greatest common factor for <i>x</i> and <i>y</i>
+*/
+uint64_t omnia_gcf(uint64_t x, uint64_t y);
+
+#endif
+
+// Lowest common multiple with overflow detection
+/*!
+    Calculates the lowest common multiple for two values, detecting
+    results that do not fit in 64 bits.
+    \param x first value
+    \param y second value
+    \param overflow if not NULL, set to true if the result overflowed and false otherwise
+    \return The lowest common multiple for <i>x</i> and <i>y</i>; 0 on overflow
+*/
+uint64_t omnia_lcm_checked(const uint64_t x, const uint64_t y, bool * overflow);
+
+// Greatest common factor of an array of values
+/*!
+    Calculates the greatest common factor of all elements of an array,
+    returning as soon as the running result reaches 1.
+    \param a array of values
+    \param n number of elements in a
+    \return The greatest common factor of the elements of <i>a</i>; 0 for an empty array
+*/
+uint64_t omnia_gcf_array(const uint64_t * a, const size_t n);
+
+// Lowest common multiple of an array of values
+/*!
+    Calculates the lowest common multiple of all elements of an array,
+    stopping at the first overflow.
+    \param a array of values
+    \param n number of elements in a
+    \param overflow if not NULL, set to true if the result overflowed and false otherwise
+    \return The lowest common multiple of the elements of <i>a</i>; 0 on overflow, or if any element is 0
+*/
+uint64_t omnia_lcm_array(const uint64_t * a, const size_t n, bool * overflow);
+
+// Greatest common factors of corresponding elements of two arrays
+/*!
+    Calculates result[i] = gcf(a[i], b[i]) for each element.
+    \param a first array of values
+    \param b second array of values
+    \param result receives <i>n</i> greatest common factors
+    \param n number of elements in each array
+*/
+void omnia_gcf_pairwise(const uint64_t * a, const uint64_t * b, uint64_t * result, const size_t n);
+
+//-----------------------------------------------------------------------------
+// Modular arithmetic
+//-----------------------------------------------------------------------------
+
+// Extended greatest common factor
+/*!
+    Calculates the greatest common factor of two values, along with
+    Bezout coefficients such that a * x + b * y = gcf(a, b).
+    \param a first value
+    \param b second value
+    \param x if not NULL, receives the coefficient of <i>a</i>
+    \param y if not NULL, receives the coefficient of <i>b</i>
+    \return The greatest common factor of <i>a</i> and <i>b</i>
+*/
+uint64_t omnia_gcf_extended(const uint64_t a, const uint64_t b, int64_t * x, int64_t * y);
+
+// Modular inverse
+/*!
+    Calculates the multiplicative inverse of a value modulo m.
+    \param a value to be inverted
+    \param m modulus
+    \return The value x in [1, m) for which a * x = 1 (mod m), or 0 if <i>a</i> and <i>m</i> are not coprime or m < 2
+*/
+uint64_t omnia_modinv(const uint64_t a, const uint64_t m);
+
+// Modular multiplication
+/*!
+    Calculates a * b mod m without overflow.
+    \param a first factor
+    \param b second factor
+    \param m modulus; must not be 0
+    \return a * b mod m, or 0 if m is 0
+*/
+uint64_t omnia_mulmod(const uint64_t a, const uint64_t b, const uint64_t m);
+
+// Modular exponentiation
+/*!
+    Calculates base raised to exponent, mod m, using Montgomery
+    multiplication when m is odd.
+    \param base value to be raised
+    \param exponent power
+    \param m modulus; must not be 0
+    \return base ^ exponent mod m, or 0 if m is 0
+*/
+uint64_t omnia_powmod(const uint64_t base, uint64_t exponent, const uint64_t m);
+
+/*!
+    Precomputed constants for repeated arithmetic with one modulus.
+    Odd moduli use Montgomery reduction, which replaces 128-bit
+    division with multiplications; even moduli fall back to division.
+*/
+typedef struct
+{
+    uint64_t modulus;   //! the modulus
+    uint64_t inverse;   //! modulus^-1 mod 2^64 (odd moduli)
+    uint64_t r2;        //! 2^128 mod modulus (odd moduli)
+    uint64_t one;       //! 2^64 mod modulus (odd moduli)
+    bool     odd;       //! true if Montgomery reduction applies
+}
+omnia_montgomery_t;
+
+// Prepare a modulus for repeated arithmetic
+/*!
+    Computes the per-modulus constants used by the omnia_montgomery
+    functions.
+    \param ctx receives the constants
+    \param m modulus
+    \return true on success, false if m is 0
+*/
+bool omnia_montgomery_init(omnia_montgomery_t * ctx, const uint64_t m);
+
+// Modular multiplication with a prepared modulus
+/*!
+    Calculates a * b mod m, where m is the modulus of <i>ctx</i>.
+    \param ctx prepared modulus
+    \param a first factor
+    \param b second factor
+    \return a * b mod m
+*/
+uint64_t omnia_montgomery_mul(const omnia_montgomery_t * ctx, const uint64_t a, const uint64_t b);
+
+// Modular exponentiation with a prepared modulus
+/*!
+    Calculates base ^ exponent mod m, where m is the modulus of <i>ctx</i>.
+    \param ctx prepared modulus
+    \param base value to be raised
+    \param exponent power
+    \return base ^ exponent mod m
+*/
+uint64_t omnia_montgomery_pow(const omnia_montgomery_t * ctx, const uint64_t base, const uint64_t exponent);
+
+// Modular multiplication of corresponding elements of two arrays
+/*!
+    Calculates result[i] = a[i] * b[i] mod m for each element. The
+    result may be the same array as either input.
+    \param ctx prepared modulus
+    \param a first array of factors
+    \param b second array of factors
+    \param result receives <i>n</i> products
+    \param n number of elements in each array
+*/
+void omnia_montgomery_mul_array(const omnia_montgomery_t * ctx, const uint64_t * a, const uint64_t * b, uint64_t * result, const size_t n);
+
+// Modular exponentiation of an array of bases
+/*!
+    Calculates result[i] = base[i] ^ exponent mod m for each element.
+    Several bases share each pass over the exponent bits. The result may
+    be the same array as the input.
+    \param ctx prepared modulus
+    \param base array of values to be raised
+    \param exponent power
+    \param result receives <i>n</i> powers
+    \param n number of elements in each array
+*/
+void omnia_montgomery_pow_array(const omnia_montgomery_t * ctx, const uint64_t * base, const uint64_t exponent, uint64_t * result, const size_t n);
+
+//-----------------------------------------------------------------------------
+// Prime numbers
+//-----------------------------------------------------------------------------
+
+//! Largest number of prime factors, with multiplicity, of a 64-bit value
+#define OMNIA_FACTOR_MAX 64
+
+// Test a value for primality
+/*!
+    Determines whether a value is prime, using trial division and a
+    Miller-Rabin test with a set of bases that is deterministic for all
+    64-bit values.
+    \param n value to be tested
+    \return true if <i>n</i> is prime
+*/
+bool omnia_is_prime(const uint64_t n);
+
+// Test an array of values for primality
+/*!
+    Determines whether each of an array of values is prime.
+    \param n array of values to be tested
+    \param result receives <i>count</i> results
+    \param count number of elements in each array
+*/
+void omnia_is_prime_array(const uint64_t * n, bool * result, const size_t count);
+
+// Prime factorization
+/*!
+    Finds the prime factors of a value, using trial division for small
+    factors and Pollard's rho method, with Brent's cycle detection, for
+    large ones.
+    \param n value to be factored
+    \param factors receives the prime factors, with multiplicity, in ascending order; must have room for OMNIA_FACTOR_MAX values
+    \return number of factors stored; 0 if n < 2
+*/
+size_t omnia_factor(uint64_t n, uint64_t * factors);
+
+//! Receives a batch of primes, in ascending order; return false to stop
+typedef bool (*omnia_prime_callback_t)(const uint64_t * primes, const size_t count, void * data);
+
+// Stream the primes in a range
+/*!
+    Finds the primes in [start, limit] with a segmented, multi-threaded
+    Sieve of Eratosthenes, and passes them to a callback in batches.
+    Batches arrive in ascending order, one at a time, although not
+    necessarily on the calling thread. Memory use is proportional to
+    the square root of the limit and the number of threads, not to the
+    size of the range.
+    \param start smallest value to consider
+    \param limit largest value to consider
+    \param callback receives each batch of primes; may return false to stop the sieve
+    \param data passed to each call of <i>callback</i>
+    \param threads number of threads to use; 0 uses omnia_get_threads()
+    \return true on success, false for a NULL callback or memory exhaustion
+*/
+bool omnia_sieve_primes(const uint64_t start, const uint64_t limit, omnia_prime_callback_t callback, void * data, const size_t threads);
+
+// Count the primes up to a limit
+/*!
+    Counts the primes in [2, limit] with the segmented sieve used by
+    omnia_sieve_primes.
+    \param limit largest value to consider
+    \param threads number of threads to use; 0 uses omnia_get_threads()
+    \return the number of primes less than or equal to <i>limit</i>, or 0 on memory exhaustion
+*/
+uint64_t omnia_prime_count(const uint64_t limit, const size_t threads);
+
+//-----------------------------------------------------------------------------
+// Rational numbers
+//-----------------------------------------------------------------------------
+
+/*!
+    An exact ratio of two 64-bit integers. The denominator is always
+    positive. Arithmetic reduces a result to lowest terms only when that
+    is needed for it to fit, so equal values may have different
+    representations; use omnia_rational_normalize for a canonical form.
+*/
+typedef struct
+{
+    int64_t num;    //! numerator
+    int64_t den;    //! denominator, greater than zero
+}
+omnia_rational_t;
+
+// Create a rational number
+/*!
+    Sets a rational number from a numerator and denominator.
+    \param r receives the rational number
+    \param num numerator
+    \param den denominator
+    \return true on success, false if den is 0 or the value cannot be represented
+*/
+bool omnia_rational_set(omnia_rational_t * r, const int64_t num, const int64_t den);
+
+// Reduce a rational number to lowest terms
+/*!
+    Divides the numerator and denominator by their greatest common factor.
+    \param a rational number
+    \return <i>a</i> in lowest terms; zero is 0/1
+*/
+omnia_rational_t omnia_rational_normalize(const omnia_rational_t a);
+
+// Add two rational numbers
+/*!
+    Calculates a + b exactly.
+    \param a first operand
+    \param b second operand
+    \param result receives the sum
+    \return true on success, false if the result cannot be represented
+*/
+bool omnia_rational_add(const omnia_rational_t a, const omnia_rational_t b, omnia_rational_t * result);
+
+// Subtract two rational numbers
+/*!
+    Calculates a - b exactly.
+    \param a first operand
+    \param b second operand
+    \param result receives the difference
+    \return true on success, false if the result cannot be represented
+*/
+bool omnia_rational_sub(const omnia_rational_t a, const omnia_rational_t b, omnia_rational_t * result);
+
+// Multiply two rational numbers
+/*!
+    Calculates a * b exactly.
+    \param a first operand
+    \param b second operand
+    \param result receives the product
+    \return true on success, false if the result cannot be represented
+*/
+bool omnia_rational_mul(const omnia_rational_t a, const omnia_rational_t b, omnia_rational_t * result);
+
+// Divide two rational numbers
+/*!
+    Calculates a / b exactly.
+    \param a first operand
+    \param b second operand
+    \param result receives the quotient
+    \return true on success, false if b is 0 or the result cannot be represented
+*/
+bool omnia_rational_div(const omnia_rational_t a, const omnia_rational_t b, omnia_rational_t * result);
+
+// Compare two rational numbers
+/*!
+    Compares two rational numbers, which need not be in lowest terms.
+    \param a first operand
+    \param b second operand
+    \return -1 if a < b, 0 if a = b, 1 if a > b
+*/
+int omnia_rational_compare(const omnia_rational_t a, const omnia_rational_t b);
+
+// Convert a rational number to floating-point
+/*!
+    Converts a rational number to floating-point.
+    \param a rational number
+    \return <i>a</i> as a double
+*/
+double omnia_rational_to_double(const omnia_rational_t a);
+
+// Reduce each element of an array of rational numbers to lowest terms
+/*!
+    Normalizes an array of rational numbers in place.
+    \param a array of rational numbers
+    \param n number of elements in a
+*/
+void omnia_rational_normalize_array(omnia_rational_t * a, const size_t n);
+
+// Sum an array of rational numbers
+/*!
+    Calculates the exact sum of an array of rational numbers, working
+    over a common denominator so that terms are not reduced one by one.
+    \param a array of rational numbers
+    \param n number of elements in a
+    \param result receives the sum
+    \return true on success, false if the sum or an intermediate denominator cannot be represented
+*/
+bool omnia_rational_sum(const omnia_rational_t * a, const size_t n, omnia_rational_t * result);
+
+//-----------------------------------------------------------------------------
+// Integer bit math
+//-----------------------------------------------------------------------------
+
+/*
+    These functions are defined here so that they inline; each compiles
+    to a handful of instructions, using count-leading-zeros and
+    population-count instructions where the compiler provides them.
+*/
+
+// Number of leading zero bits in a 32-bit value
+/*!
+    Counts the zero bits above the highest set bit.
+    \param x value
+    \return number of leading zero bits; 32 if <i>x</i> is 0
+*/
+static inline unsigned int omnia_clz_u32(const uint32_t x)
+{
+#if defined(__GNUC__)
+    return (x == 0) ? 32 : (unsigned int)__builtin_clz(x);
+#else
+    unsigned int n = 32;
+
+    for (uint32_t y = x; y != 0; y >>= 1)
+        --n;
+
+    return n;
+#endif
+}
+
+// Number of leading zero bits in a 64-bit value
+/*!
+    Counts the zero bits above the highest set bit.
+    \param x value
+    \return number of leading zero bits; 64 if <i>x</i> is 0
+*/
+static inline unsigned int omnia_clz_u64(const uint64_t x)
+{
+#if defined(__GNUC__)
+    return (x == 0) ? 64 : (unsigned int)__builtin_clzll(x);
+#else
+    unsigned int n = 64;
+
+    for (uint64_t y = x; y != 0; y >>= 1)
+        --n;
+
+    return n;
+#endif
+}
+
+// Number of trailing zero bits in a 32-bit value
+/*!
+    Counts the zero bits below the lowest set bit.
+    \param x value
+    \return number of trailing zero bits; 32 if <i>x</i> is 0
+*/
+static inline unsigned int omnia_ctz_u32(const uint32_t x)
+{
+#if defined(__GNUC__)
+    return (x == 0) ? 32 : (unsigned int)__builtin_ctz(x);
+#else
+    unsigned int n = 0;
+
+    for (uint32_t y = x; (n < 32) && ((y & 1) == 0); y >>= 1)
+        ++n;
+
+    return n;
+#endif
+}
+
+// Number of trailing zero bits in a 64-bit value
+/*!
+    Counts the zero bits below the lowest set bit.
+    \param x value
+    \return number of trailing zero bits; 64 if <i>x</i> is 0
+*/
+static inline unsigned int omnia_ctz_u64(const uint64_t x)
+{
+#if defined(__GNUC__)
+    return (x == 0) ? 64 : (unsigned int)__builtin_ctzll(x);
+#else
+    unsigned int n = 0;
+
+    for (uint64_t y = x; (n < 64) && ((y & 1) == 0); y >>= 1)
+        ++n;
+
+    return n;
+#endif
+}
+
+// Integer base-2 logarithm of a 32-bit value
+/*!
+    Calculates floor(log2(x)), the index of the highest set bit.
+    \param x value
+    \return floor(log2(<i>x</i>)); 0 if <i>x</i> is 0
+*/
+static inline unsigned int omnia_ilog2_u32(const uint32_t x)
+{
+    return 31 - omnia_clz_u32(x | 1);
+}
+
+// Integer base-2 logarithm of a 64-bit value
+/*!
+    Calculates floor(log2(x)), the index of the highest set bit.
+    \param x value
+    \return floor(log2(<i>x</i>)); 0 if <i>x</i> is 0
+*/
+static inline unsigned int omnia_ilog2_u64(const uint64_t x)
+{
+    return 63 - omnia_clz_u64(x | 1);
+}
+
+// Integer base-10 logarithm of a 32-bit value
+/*!
+    Calculates floor(log10(x)), one less than the number of decimal digits.
+    \param x value
+    \return floor(log10(<i>x</i>)); 0 if <i>x</i> is 0
+*/
+static inline unsigned int omnia_ilog10_u32(const uint32_t x)
+{
+    static const uint32_t powers[] =
+    {
+        1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+    };
+
+    // log10(2) is about 1233 / 4096; the estimate is exact or one too high
+    const unsigned int t = ((omnia_ilog2_u32(x) + 1) * 1233) >> 12;
+
+    return t - ((x | 1) < powers[t]);
+}
+
+// Integer base-10 logarithm of a 64-bit value
+/*!
+    Calculates floor(log10(x)), one less than the number of decimal digits.
+    \param x value
+    \return floor(log10(<i>x</i>)); 0 if <i>x</i> is 0
+*/
+static inline unsigned int omnia_ilog10_u64(const uint64_t x)
+{
+    static const uint64_t powers[] =
+    {
+        UINT64_C(1), UINT64_C(10), UINT64_C(100), UINT64_C(1000), UINT64_C(10000),
+        UINT64_C(100000), UINT64_C(1000000), UINT64_C(10000000), UINT64_C(100000000),
+        UINT64_C(1000000000), UINT64_C(10000000000), UINT64_C(100000000000),
+        UINT64_C(1000000000000), UINT64_C(10000000000000), UINT64_C(100000000000000),
+        UINT64_C(1000000000000000), UINT64_C(10000000000000000), UINT64_C(100000000000000000),
+        UINT64_C(1000000000000000000), UINT64_C(10000000000000000000)
+    };
+
+    const unsigned int t = ((omnia_ilog2_u64(x) + 1) * 1233) >> 12;
+
+    return t - ((x | 1) < powers[t]);
+}
+
+// Smallest power of 2 greater than or equal to a 32-bit value
+/*!
+    Rounds a value up to a power of two.
+    \param x value
+    \return the smallest power of 2 that is at least <i>x</i>; 1 if <i>x</i> is 0, and 0 if the result does not fit
+*/
+static inline uint32_t omnia_next_pow2_u32(const uint32_t x)
+{
+    if (x <= 1)
+        return 1;
+
+    if (x > (UINT32_C(1) << 31))
+        return 0;
+
+    return UINT32_C(1) << (32 - omnia_clz_u32(x - 1));
+}
+
+// Smallest power of 2 greater than or equal to a 64-bit value
+/*!
+    Rounds a value up to a power of two.
+    \param x value
+    \return the smallest power of 2 that is at least <i>x</i>; 1 if <i>x</i> is 0, and 0 if the result does not fit
+*/
+static inline uint64_t omnia_next_pow2_u64(const uint64_t x)
+{
+    if (x <= 1)
+        return 1;
+
+    if (x > (UINT64_C(1) << 63))
+        return 0;
+
+    return UINT64_C(1) << (64 - omnia_clz_u64(x - 1));
+}
+
+// Largest power of 2 less than or equal to a 32-bit value
+/*!
+    Rounds a value down to a power of two.
+    \param x value
+    \return the largest power of 2 that is at most <i>x</i>; 0 if <i>x</i> is 0
+*/
+static inline uint32_t omnia_prev_pow2_u32(const uint32_t x)
+{
+    return (x == 0) ? 0 : UINT32_C(1) << omnia_ilog2_u32(x);
+}
+
+// Largest power of 2 less than or equal to a 64-bit value
+/*!
+    Rounds a value down to a power of two.
+    \param x value
+    \return the largest power of 2 that is at most <i>x</i>; 0 if <i>x</i> is 0
+*/
+static inline uint64_t omnia_prev_pow2_u64(const uint64_t x)
+{
+    return (x == 0) ? 0 : UINT64_C(1) << omnia_ilog2_u64(x);
+}
+
+// Number of set bits in a 32-bit value
+/*!
+    Counts the bits that are 1.
+    \param x value
+    \return population count of <i>x</i>
+*/
+static inline unsigned int omnia_popcount_u32(const uint32_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_popcount(x);
+#else
+    uint32_t y = x - ((x >> 1) & 0x55555555u);
+    y = (y & 0x33333333u) + ((y >> 2) & 0x33333333u);
+    return (unsigned int)((((y + (y >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24);
+#endif
+}
+
+// Number of set bits in a 64-bit value
+/*!
+    Counts the bits that are 1.
+    \param x value
+    \return population count of <i>x</i>
+*/
+static inline unsigned int omnia_popcount_u64(const uint64_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_popcountll(x);
+#else
+    return omnia_popcount_u32((uint32_t)x) + omnia_popcount_u32((uint32_t)(x >> 32));
+#endif
+}
+
+// size_t forms, for sizing buffers and tables
+#if SIZE_MAX > UINT32_MAX
+
+//! Integer base-2 logarithm of a size_t
+static inline unsigned int omnia_ilog2_size(const size_t x)
+{
+    return omnia_ilog2_u64(x);
+}
+
+//! Integer base-10 logarithm of a size_t
+static inline unsigned int omnia_ilog10_size(const size_t x)
+{
+    return omnia_ilog10_u64(x);
+}
+
+//! Smallest power of 2 greater than or equal to a size_t; 0 if the result does not fit
+static inline size_t omnia_next_pow2_size(const size_t x)
+{
+    return (size_t)omnia_next_pow2_u64(x);
+}
+
+//! Largest power of 2 less than or equal to a size_t
+static inline size_t omnia_prev_pow2_size(const size_t x)
+{
+    return (size_t)omnia_prev_pow2_u64(x);
+}
+
+//! Number of set bits in a size_t
+static inline unsigned int omnia_popcount_size(const size_t x)
+{
+    return omnia_popcount_u64(x);
+}
+
+#else
+
+//! Integer base-2 logarithm of a size_t
+static inline unsigned int omnia_ilog2_size(const size_t x)
+{
+    return omnia_ilog2_u32((uint32_t)x);
+}
+
+//! Integer base-10 logarithm of a size_t
+static inline unsigned int omnia_ilog10_size(const size_t x)
+{
+    return omnia_ilog10_u32((uint32_t)x);
+}
+
+//! Smallest power of 2 greater than or equal to a size_t; 0 if the result does not fit
+static inline size_t omnia_next_pow2_size(const size_t x)
+{
+    return (size_t)omnia_next_pow2_u32((uint32_t)x);
+}
+
+//! Largest power of 2 less than or equal to a size_t
+static inline size_t omnia_prev_pow2_size(const size_t x)
+{
+    return (size_t)omnia_prev_pow2_u32((uint32_t)x);
+}
+
+//! Number of set bits in a size_t
+static inline unsigned int omnia_popcount_size(const size_t x)
+{
+    return omnia_popcount_u32((uint32_t)x);
+}
+
+#endif
+
+/*
+    Constant-expression forms, for array dimensions, case labels and
+    static initializers. Arguments are evaluated many times, so they
+    should be constants; use the functions above for run-time values.
+    Each works for unsigned values of up to 64 bits.
+*/
+
+#define OMNIA_ILOG2_1_(x)  (((x) >= 2) ? 1 : 0)
+#define OMNIA_ILOG2_2_(x)  (((x) >= 4) ? 2 + OMNIA_ILOG2_1_((x) >> 2) : OMNIA_ILOG2_1_(x))
+#define OMNIA_ILOG2_4_(x)  (((x) >= 16) ? 4 + OMNIA_ILOG2_2_((x) >> 4) : OMNIA_ILOG2_2_(x))
+#define OMNIA_ILOG2_8_(x)  (((x) >= 256) ? 8 + OMNIA_ILOG2_4_((x) >> 8) : OMNIA_ILOG2_4_(x))
+#define OMNIA_ILOG2_16_(x) (((x) >= 65536) ? 16 + OMNIA_ILOG2_8_((x) >> 16) : OMNIA_ILOG2_8_(x))
+
+//! floor(log2(x)) as a constant expression; 0 for 0
+#define OMNIA_ILOG2_CONST(x) ((unsigned int)(((uint64_t)(x) >= UINT64_C(4294967296)) \
+    ? 32 + OMNIA_ILOG2_16_((uint64_t)(x) >> 32) : OMNIA_ILOG2_16_((uint64_t)(x))))
+
+#define OMNIA_SMEAR_1_(x)  ((x) | ((x) >> 1))
+#define OMNIA_SMEAR_2_(x)  (OMNIA_SMEAR_1_(x) | (OMNIA_SMEAR_1_(x) >> 2))
+#define OMNIA_SMEAR_4_(x)  (OMNIA_SMEAR_2_(x) | (OMNIA_SMEAR_2_(x) >> 4))
+#define OMNIA_SMEAR_8_(x)  (OMNIA_SMEAR_4_(x) | (OMNIA_SMEAR_4_(x) >> 8))
+#define OMNIA_SMEAR_16_(x) (OMNIA_SMEAR_8_(x) | (OMNIA_SMEAR_8_(x) >> 16))
+#define OMNIA_SMEAR_(x)    (OMNIA_SMEAR_16_(x) | (OMNIA_SMEAR_16_(x) >> 32))
+
+//! Smallest power of 2 greater than or equal to x, as a constant expression; 1 for 0
+#define OMNIA_NEXT_POW2_CONST(x) (((uint64_t)(x) <= 1) ? UINT64_C(1) : OMNIA_SMEAR_((uint64_t)(x) - 1) + 1)
+
+//! Largest power of 2 less than or equal to x, as a constant expression; 0 for 0
+#define OMNIA_PREV_POW2_CONST(x) (OMNIA_SMEAR_((uint64_t)(x)) - (OMNIA_SMEAR_((uint64_t)(x)) >> 1))
+
+//-----------------------------------------------------------------------------
+// Vector math
+//-----------------------------------------------------------------------------
+
 /*!
-    Initializes a psuedo-random number generator using a specified seed.
-    \param seed Initialization seed
+    Accuracy tiers for the array kernels. Lower accuracy uses shorter
+    polynomials and runs faster.
 */
-void omnia_kiss32_set_seed(const uint32_t seed);
+typedef enum
+{
+    OMNIA_ACCURACY_ULP,     //! within about one unit in the last place
+    OMNIA_ACCURACY_1E7,     //! relative error below 1e-7 (single precision)
+    OMNIA_ACCURACY_1E4      //! relative error below 1e-4
+}
+omnia_accuracy_t;
 
-//!  Get the next integer
+// Natural logarithm of each element of an array
 /*!
-    Returns the next uint32_t in sequence.
-    \return A pseudorandom uint32_t value
+    Calculates result[i] = log(x[i]) with a vectorized kernel. Zero,
+    negative, subnormal and non-finite elements produce the same results
+    as the C library's log. The result may be the same array as the input.
+    \param x array of values
+    \param result receives <i>n</i> logarithms
+    \param n number of elements in each array
+    \param accuracy accuracy tier
 */
-uint32_t omnia_kiss32_next();
+void omnia_log_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
 
-//! Get the next integer in the range [lo,hi]
+// Exponential of each element of an array
 /*!
-    Returns the next int_value between lo and hi, inclusive.
-    \param lo - Minimum value of result
-    \param hi - Maximum value of result
-    \return A pseudorandom uint32_t value
+    Calculates result[i] = exp(x[i]) with a vectorized kernel. Elements
+    whose results overflow, underflow or are not finite produce the same
+    results as the C library's exp. The result may be the same array as
+    the input.
+    \param x array of values
+    \param result receives <i>n</i> exponentials
+    \param n number of elements in each array
+    \param accuracy accuracy tier
 */
-uint32_t omnia_kiss32_range(const uint32_t lo, const uint32_t hi);
+void omnia_exp_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
 
-//! Get the next random value as a size_t index
+// Sine of each element of an array
 /*!
-    Returns the next value as a size_t "index" in the range [0,length).
-    \param length - Maximum value of result
-    \return A pseudorandom size_t value
+    Calculates result[i] = sin(x[i]) with a vectorized kernel. Arguments
+    are reduced accurately for magnitudes below 2<sup>20</sup>; larger
+    and non-finite elements produce the same results as the C library's
+    sin. The lower tiers bound the absolute rather than the relative
+    error. The result may be the same array as the input.
+    \param x array of values, in radians
+    \param result receives <i>n</i> sines
+    \param n number of elements in each array
+    \param accuracy accuracy tier
 */
-size_t omnia_kiss32_index(const size_t length);
+void omnia_sin_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
 
-//! Get the next number in the range [0,1)
+// Cosine of each element of an array
 /*!
-    Returns the next real number in the range [0,1], i.e., a number
-    greater than or equal to 0 and less than or equal to 1.
-    Provides 32-bit precision.
-    \return A pseudorandom double value
+    Calculates result[i] = cos(x[i]) with a vectorized kernel, on the
+    same terms as omnia_sin_array.
+    \param x array of values, in radians
+    \param result receives <i>n</i> cosines
+    \param n number of elements in each array
+    \param accuracy accuracy tier
 */
-double omnia_kiss32_real();
+void omnia_cos_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
+
+// Sine and cosine of each element of an array
+/*!
+    Calculates both sin(x[i]) and cos(x[i]), sharing the argument
+    reduction, on the same terms as omnia_sin_array. Either output may
+    be NULL, and either may be the same array as the input.
+    \param x array of values, in radians
+    \param sines receives <i>n</i> sines, or NULL
+    \param cosines receives <i>n</i> cosines, or NULL
+    \param n number of elements in each array
+    \param accuracy accuracy tier
+*/
+void omnia_sincos_array(const double * x, double * sines, double * cosines, const size_t n, const omnia_accuracy_t accuracy);
 
 //-----------------------------------------------------------------------------
-// Rounding
+// Logarithms
 //-----------------------------------------------------------------------------
 
-//! Round to nearest value
 /*!
-    Rounds a value to nearest integer, rounding to even for exact fractions of 0.5.
+    Precomputed constants for logarithms to one base.
 */
-double omnia_round_nearest(const double x);
+typedef struct
+{
+    double base;    //! logarithm base
+    double scale;   //! 1 / ln(base)
+}
+omnia_log_base_t;
 
-// Set number of significant digits in a floating-point value
+// Prepare a logarithm base
 /*!
-    Returns the given value rounded for the number of specified decimal
-    digits of precision.
-    \param x - Original value to be rounded
-    \param n - Number of significant digits
-    \return The value <i>x</i> rounded to <i>n</i> digits of precision
+    Computes the constants for logarithms to a given base.
+    \param ctx receives the constants
+    \param base logarithm base; must be positive, finite and not 1
+    \return true on success, false for an invalid base
 */
-double omnia_sigdig(const double x, const uint16_t n);
+bool omnia_log_base_init(omnia_log_base_t * ctx, const double base);
 
-//-----------------------------------------------------------------------------
-// Lowest Common Multple (LCM) and Lowest Common Denominator (GCD)
-//-----------------------------------------------------------------------------
+// Logarithm to a prepared base
+/*!
+    Calculates the logarithm of x to the base of <i>ctx</i>.
+    \param ctx prepared base
+    \param x value for which logarithm is required
+    \return logarithm of <i>x</i>; NAN for x < 0
+*/
+double omnia_log_base(const omnia_log_base_t * ctx, const double x);
 
-// Lowest common multiple
+// Logarithm to a prepared base of each element of an array
 /*!
-    Calculates the lowest common multiple for two values.
-    \param x first value
-    \param y second value
-    \return The lowest common multiple for <i>x</i> and <i>y</i>
+    Calculates the logarithm of each element of an array to the base of
+    <i>ctx</i>. The result may be the same array as the input.
+    \param ctx prepared base
+    \param x array of values
+    \param result receives <i>n</i> logarithms
+    \param n number of elements in each array
+    \param accuracy accuracy tier
 */
-uint64_t omnia_lcm(const uint64_t x, const uint64_t y);
+void omnia_log_base_array(const omnia_log_base_t * ctx, const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
 
-// Greatest common factor (denominator)
+// Convert an array of power ratios to decibels
 /*!
-    Calculates the greatest common factor for two values.
-    \param x first value
-    \param y second value
-    \return The greatest common factor for <i>x</i> and <i>y</i>
+    Calculates result[i] = 10 * log10(x[i]). The result may be the same
+    array as the input.
+    \param x array of power ratios
+    \param result receives <i>n</i> levels in decibels
+    \param n number of elements in each array
+    \param accuracy accuracy tier
 */
-uint64_t omnia_gcf(uint64_t x, uint64_t y);
+void omnia_power_to_db_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
 
-//-----------------------------------------------------------------------------
-// Logarithms
-//-----------------------------------------------------------------------------
+// Convert an array of amplitude ratios to decibels
+/*!
+    Calculates result[i] = 20 * log10(x[i]). The result may be the same
+    array as the input.
+    \param x array of amplitude ratios
+    \param result receives <i>n</i> levels in decibels
+    \param n number of elements in each array
+    \param accuracy accuracy tier
+*/
+void omnia_amplitude_to_db_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
 
 // Logarithm to a specified base
 /*!
     Calculates the base-n logarithm for a given value. If a range
-    error occurs, the return value equals NaN.
+    error occurs, the return value equals NaN. When many values share a
+    base, omnia_log_base avoids recomputing the logarithm of the base.
     \param x value for which logarithm is required
     \param base lagarithm base
-    \return logarithm of <i>x</i> to base <i>base</i>; NAN on range error
+    \return logarithm of <i>x</i> to base <i>base</i>; NAN for x < 0 or a base that is not positive or is 1
 */
 double omnia_log2base(const double x, const double base);
 
 // Smallest power of 2 that includes a given value
 /*!
-    Returns the smallest power of 2 that includes n in its range
-    \param n number that must be less than the result
-    \return the lowest power of 2 that is greater than <i>n</i>, or
+    Returns the smallest power of 2 that includes n in its range. See
+    omnia_next_pow2_size for an inline version for sizes.
+    \param n number that must not be greater than the result
+    \return the lowest power of 2 that is greater than or equal to <i>n</i>, or 0 if n < 1 or the result does not fit in an int
 */
+#if !defined(OMNIA_INLINE)
 int omnia_sizepow2(const int n);
+#endif
 
 //-----------------------------------------------------------------------------
 // Statistical functions
@@ -232,7 +2070,7 @@ int omnia_sizepow2(const int n);
 // Moving average
 /*!
     Computes the moving average for an array. The returned buffer
-    must be freed by the calling code.
+    must be released with omnia_free.
     \param data array of double values to be averaged
     \param n number of elements in data
     \param distance number elements to average before and after an element in <i>data</i>
@@ -240,6 +2078,19 @@ int omnia_sizepow2(const int n);
 */
 double * omnia_moving_average(const double * data, const int n, const int distance);
 
+// Moving average into a caller's buffer
+/*!
+    Computes the moving average for an array without allocating. Each
+    result averages the elements within <i>distance</i> of it that lie
+    inside the array.
+    \param data array of double values to be averaged
+    \param n number of elements in data
+    \param distance number elements to average before and after an element in <i>data</i>
+    \param result receives <i>n</i> averages; must not overlap <i>data</i>
+    \return true on success, false for invalid arguments
+*/
+bool omnia_moving_average_into(const double * data, const size_t n, const size_t distance, double * result);
+
 //! index of average in array returned from omnia_basic_stats
 #define OMNI_STAT_AVG 0;
 
@@ -249,16 +2100,88 @@ double * omnia_moving_average(const double * data, const int n, const int distan
 //! index of standard deviation in array returned from omnia_basic_stats
 #define OMNI_STAT_DEV 2;
 
-// Moving average
+// Basic statistics
 /*!
     Computes basic statistics for an array. The returned buffer
-    must be freed by the calling code.
+    must be released with omnia_free.
     \param a array of double values to be analyzed
     \param n number of elements in data
     \return an allocated 3-element array containing the average, variance, and standard deviation of the elements in <i>a</i>
 */
 double * omnia_basic_stats(const double * a, size_t n);
 
+// Basic statistics into a caller's buffer
+/*!
+    Computes the average, variance and standard deviation of an array
+    without allocating.
+    \param a array of double values to be analyzed
+    \param n number of elements in data
+    \param result receives the average, variance and standard deviation, in that order
+    \return true on success, false for invalid arguments
+*/
+bool omnia_basic_stats_into(const double * a, const size_t n, double result[3]);
+
+/*!
+    Running statistics of a stream of values. Statistics of separate
+    streams, such as those of different threads, can be merged into the
+    statistics of the combined stream.
+*/
+typedef struct
+{
+    uint64_t count; //! number of values
+    double mean;    //! mean of the values
+    double m2;      //! sum of squared differences from the mean
+}
+omnia_running_stats_t;
+
+// Clear running statistics
+/*!
+    \param stats statistics to reset to an empty stream
+*/
+void omnia_running_stats_init(omnia_running_stats_t * stats);
+
+// Add a value to running statistics
+/*!
+    Updates the statistics with Welford's method.
+    \param stats statistics to update
+    \param x the new value
+*/
+void omnia_running_stats_add(omnia_running_stats_t * stats, const double x);
+
+// Add an array of values to running statistics
+/*!
+    Computes the statistics of the array in two passes, and merges them
+    into <i>stats</i>; faster and as accurate as adding the values one by
+    one.
+    \param stats statistics to update
+    \param a values to add
+    \param n number of elements in <i>a</i>
+*/
+void omnia_running_stats_add_array(omnia_running_stats_t * stats, const double * a, const size_t n);
+
+// Merge running statistics
+/*!
+    Combines the statistics of two streams, using the pairwise formula
+    of Chan, Golub and LeVeque.
+    \param stats statistics to update; afterward they describe both streams
+    \param other statistics of the other stream
+*/
+void omnia_running_stats_merge(omnia_running_stats_t * stats, const omnia_running_stats_t * other);
+
+// Sample variance of running statistics
+/*!
+    \param stats the statistics
+    \return the variance, dividing by count - 1; NaN for fewer than two values
+*/
+double omnia_running_stats_variance(const omnia_running_stats_t * stats);
+
+// Standard error of the mean of running statistics
+/*!
+    \param stats the statistics
+    \return the estimated standard deviation of the mean; NaN for fewer than two values
+*/
+double omnia_running_stats_error(const omnia_running_stats_t * stats);
+
 //-----------------------------------------------------------------------------
 // Sine Wave Generation
 //-----------------------------------------------------------------------------
@@ -277,8 +2200,8 @@ omnia_wave_factor_t;
 /*!
     Generates an array of doubles by combining sine waves. The primary
     purpose is to produce an artificial signal with known properties,
-    for testing signal analysis applications. The caller is responsible
-    for freeing the memory used by the array returned by this function.
+    for testing signal analysis applications. The caller releases the
+    returned array with omnia_free.
     \param factors defines properties of the sine waves to be combined
     \param factor_n number of elements in factors
     \param array_n number of elements in the output array
@@ -286,6 +2209,17 @@ omnia_wave_factor_t;
 */
 double * omnia_make_sinusoid(const omnia_wave_factor_t * factors, const size_t factor_n, const size_t array_n);
 
+// Sine wave based signal generator, into a caller's buffer
+/*!
+    Generates the same signal as omnia_make_sinusoid without allocating.
+    \param factors defines properties of the sine waves to be combined
+    \param factor_n number of elements in factors
+    \param result receives <i>array_n</i> samples
+    \param array_n number of elements in the output array
+    \return true on success, false for invalid arguments
+*/
+bool omnia_make_sinusoid_into(const omnia_wave_factor_t * factors, const size_t factor_n, double * result, const size_t array_n);
+
 // Apply noise to a signal
 /*!
     Adds a percentage of noise to a signal. If "noise" is set to 0.1 (for example)
@@ -297,6 +2231,286 @@ double * omnia_make_sinusoid(const omnia_wave_factor_t * factors, const size_t f
 */
 void omnia_add_noise(double * a, const size_t n, double noise);
 
+//-----------------------------------------------------------------------------
+// Spectral analysis
+//-----------------------------------------------------------------------------
+
+// Goertzel power for a set of target frequencies
+/*!
+    Computes the power of the DFT term for each target frequency using
+    the Goertzel algorithm. All frequencies are evaluated in a single
+    vectorized pass over the data, which is far cheaper than a full FFT
+    when only a few dozen frequencies are of interest.
+    \param data array of samples
+    \param n number of elements in data
+    \param frequencies target frequencies, in cycles per sample (0 to 0.5)
+    \param freq_n number of elements in frequencies
+    \param power receives <i>freq_n</i> values; the squared magnitude of each DFT term
+    \return true on success, false if any pointer is NULL
+*/
+bool omnia_goertzel(const double * data, const size_t n, const double * frequencies, const size_t freq_n, double * power);
+
+// Estimate the amplitudes of the sine waves described by a set of wave factors
+/*!
+    Uses the Goertzel algorithm to estimate the amplitude of each wave
+    in a signal, where the frequencies are taken from the same wave
+    factors given to omnia_make_sinusoid. Estimates are exact when a
+    whole number of half-wavelengths fit in the signal, and subject
+    to spectral leakage otherwise.
+    \param data array of samples
+    \param n number of elements in data
+    \param factors wave factors whose wavelengths are to be measured
+    \param factor_n number of elements in factors
+    \param amplitudes receives <i>factor_n</i> estimated amplitudes
+    \return true on success, false if any pointer is NULL or <i>n</i> is zero
+*/
+bool omnia_goertzel_waves(const double * data, const size_t n, const omnia_wave_factor_t * factors, const size_t factor_n, double * amplitudes);
+
+/*!
+     Describes a peak located in a magnitude spectrum.
+*/
+typedef struct
+{
+    double bin;         //! interpolated bin index of the peak
+    double magnitude;   //! interpolated magnitude of the peak
+}
+omnia_spectral_peak_t;
+
+// Find the largest peaks in a magnitude spectrum
+/*!
+    Locates local maxima in a magnitude spectrum (such as the magnitudes
+    of FFT output) and refines each with quadratic interpolation. For a
+    spectrum of an N-point transform, a bin <i>b</i> corresponds to
+    <i>b</i>/N cycles per sample.
+    \param magnitude array of spectral magnitudes
+    \param n number of elements in magnitude
+    \param threshold minimum magnitude of a reported peak
+    \param peaks receives up to <i>max_peaks</i> peaks, in descending order of magnitude
+    \param max_peaks capacity of peaks
+    \return the number of peaks stored in <i>peaks</i>
+*/
+size_t omnia_find_peaks(const double * magnitude, const size_t n, const double threshold, omnia_spectral_peak_t * peaks, const size_t max_peaks);
+
+//-----------------------------------------------------------------------------
+// Fast Fourier transform
+//-----------------------------------------------------------------------------
+
+//! Precomputed tables for transforms of one length
+typedef struct omnia_fft_plan_s omnia_fft_plan_t;
+
+// Create a plan for transforms of a given length
+/*!
+    Precomputes the bit-reversal permutation and twiddle factors for
+    transforms of length <i>n</i>. Plans are read-only once created and
+    may be shared between threads.
+    \param n transform length; must be a power of 2
+    \return an allocated plan, or NULL if <i>n</i> is invalid or memory is exhausted
+*/
+omnia_fft_plan_t * omnia_fft_plan_create(const size_t n);
+
+// Release a plan
+/*!
+    Frees all memory associated with a plan.
+    \param plan plan to be released; may be NULL
+*/
+void omnia_fft_plan_free(omnia_fft_plan_t * plan);
+
+// Length of the transforms performed by a plan
+/*!
+    \param plan a plan
+    \return the transform length of <i>plan</i>
+*/
+size_t omnia_fft_plan_length(const omnia_fft_plan_t * plan);
+
+// Perform an in-place transform using a plan
+/*!
+    Computes the discrete Fourier transform of complex data held in
+    separate real and imaginary arrays. The inverse transform includes
+    the 1/n scaling, so a forward transform followed by an inverse
+    transform restores the original data.
+    \param plan plan for the length of the data
+    \param re real parts; replaced by the real parts of the result
+    \param im imaginary parts; replaced by the imaginary parts of the result
+    \param inverse true for the inverse transform
+*/
+void omnia_fft_execute(const omnia_fft_plan_t * plan, double * re, double * im, const bool inverse);
+
+// Fast Fourier transform
+/*!
+    Computes an in-place transform without a persistent plan. Code that
+    performs many transforms of the same length should create a plan.
+    \param re real parts; replaced by the real parts of the result
+    \param im imaginary parts; replaced by the imaginary parts of the result
+    \param n number of elements in each array; must be a power of 2
+    \param inverse true for the inverse transform
+    \return true on success, false for invalid arguments or memory exhaustion
+*/
+bool omnia_fft(double * re, double * im, const size_t n, const bool inverse);
+
+//-----------------------------------------------------------------------------
+// Digital filters
+//-----------------------------------------------------------------------------
+
+/*!
+     Filter response types.
+*/
+typedef enum
+{
+    OMNIA_FILTER_LOWPASS,   //! pass frequencies below a cutoff
+    OMNIA_FILTER_HIGHPASS,  //! pass frequencies above a cutoff
+    OMNIA_FILTER_BANDPASS   //! pass frequencies within a band
+}
+omnia_filter_type_t;
+
+//! Streaming finite impulse response filter
+typedef struct omnia_fir_s omnia_fir_t;
+
+// Create a FIR filter
+/*!
+    Creates a finite impulse response filter for the given kernel. Short
+    kernels are applied in a vectorized direct form; long kernels use
+    overlap-save FFT convolution. Either way, the filter keeps enough
+    history that input may be supplied in chunks of any size.
+    \param taps filter coefficients (impulse response)
+    \param ntaps number of elements in taps
+    \return an allocated filter, or NULL on invalid arguments or memory exhaustion
+*/
+omnia_fir_t * omnia_fir_create(const double * taps, const size_t ntaps);
+
+// Release a FIR filter
+/*!
+    Frees all memory associated with a filter.
+    \param fir filter to be released; may be NULL
+*/
+void omnia_fir_free(omnia_fir_t * fir);
+
+// Clear the history of a FIR filter
+/*!
+    Resets a filter as though all previous input had been zero.
+    \param fir filter to be reset
+*/
+void omnia_fir_reset(omnia_fir_t * fir);
+
+// Apply a FIR filter to a block of samples
+/*!
+    Filters the next <i>n</i> samples of a stream. <i>in</i> and <i>out</i> may
+    be the same array.
+    \param fir filter to be applied
+    \param in input samples
+    \param out receives <i>n</i> filtered samples
+    \param n number of samples
+*/
+void omnia_fir_process(omnia_fir_t * fir, const double * in, double * out, const size_t n);
+
+// Design a windowed-sinc FIR filter
+/*!
+    Computes the coefficients of a linear-phase FIR filter using a
+    Blackman-windowed sinc. Frequencies are in cycles per sample.
+    \param taps receives <i>ntaps</i> coefficients
+    \param ntaps number of coefficients; must be odd for a high-pass filter
+    \param type response type
+    \param f1 cutoff frequency, or lower edge of the pass band
+    \param f2 upper edge of the pass band; ignored except for band-pass filters
+    \return true on success, false for invalid arguments
+*/
+bool omnia_fir_design(double * taps, const size_t ntaps, const omnia_filter_type_t type, const double f1, const double f2);
+
+/*!
+     Coefficients of a second-order IIR section, normalized so that a0 is 1.
+*/
+typedef struct
+{
+    double b0;  //! feed-forward coefficient for x[n]
+    double b1;  //! feed-forward coefficient for x[n-1]
+    double b2;  //! feed-forward coefficient for x[n-2]
+    double a1;  //! feedback coefficient for y[n-1]
+    double a2;  //! feedback coefficient for y[n-2]
+}
+omnia_biquad_t;
+
+// Design a biquad section
+/*!
+    Computes a second-order low-pass, high-pass or band-pass section.
+    Sections can be cascaded for steeper responses.
+    \param bq receives the coefficients
+    \param type response type
+    \param frequency cutoff or center frequency, in cycles per sample
+    \param q quality factor; 0.7071 gives a Butterworth response
+    \return true on success, false for invalid arguments
+*/
+bool omnia_biquad_design(omnia_biquad_t * bq, const omnia_filter_type_t type, const double frequency, const double q);
+
+//! Streaming cascade of biquad sections
+typedef struct omnia_iir_s omnia_iir_t;
+
+// Create a cascade of biquad sections
+/*!
+    Creates an infinite impulse response filter from a series of
+    second-order sections, applied in order.
+    \param sections section coefficients
+    \param nsections number of elements in sections
+    \return an allocated filter, or NULL on invalid arguments or memory exhaustion
+*/
+omnia_iir_t * omnia_iir_create(const omnia_biquad_t * sections, const size_t nsections);
+
+// Release a biquad cascade
+/*!
+    Frees all memory associated with a filter.
+    \param iir filter to be released; may be NULL
+*/
+void omnia_iir_free(omnia_iir_t * iir);
+
+// Clear the state of a biquad cascade
+/*!
+    Resets a filter as though all previous input had been zero.
+    \param iir filter to be reset
+*/
+void omnia_iir_reset(omnia_iir_t * iir);
+
+// Apply a biquad cascade to a block of samples
+/*!
+    Filters the next <i>n</i> samples of a stream. <i>in</i> and <i>out</i> may
+    be the same array.
+    \param iir filter to be applied
+    \param in input samples
+    \param out receives <i>n</i> filtered samples
+    \param n number of samples
+*/
+void omnia_iir_process(omnia_iir_t * iir, const double * in, double * out, const size_t n);
+
+//-----------------------------------------------------------------------------
+// Correlation
+//-----------------------------------------------------------------------------
+
+// Autocorrelation
+/*!
+    Computes the autocorrelation r[k] = sum x[i] * x[i+k] for lags 0
+    through <i>max_lag</i>. Uses direct summation when few lags are
+    requested, and zero-padded FFTs otherwise.
+    \param x array of samples
+    \param n number of elements in x
+    \param max_lag largest lag to be computed; lags of <i>n</i> or more are zero
+    \param normalize if true, divide the result by r[0]
+    \param result receives <i>max_lag</i> + 1 values
+    \return true on success, false for invalid arguments or memory exhaustion
+*/
+bool omnia_autocorrelation(const double * x, const size_t n, const size_t max_lag, const bool normalize, double * result);
+
+// Cross-correlation
+/*!
+    Computes the cross-correlation r[k] = sum x[i] * y[i+k] for lags
+    -<i>max_lag</i> through <i>max_lag</i>. Uses direct summation when few
+    lags are requested, and zero-padded FFTs otherwise.
+    \param x first array of samples
+    \param y second array of samples
+    \param n number of elements in x and y
+    \param max_lag largest absolute lag to be computed; lags of <i>n</i> or more are zero
+    \param normalize if true, divide the result by sqrt(sum x<sup>2</sup> * sum y<sup>2</sup>)
+    \param result receives 2 * <i>max_lag</i> + 1 values; lag zero is at index <i>max_lag</i>
+    \return true on success, false for invalid arguments or memory exhaustion
+*/
+bool omnia_cross_correlation(const double * x, const double * y, const size_t n, const size_t max_lag, const bool normalize, double * result);
+
 //-----------------------------------------------------------------------------
 // Trigonometry
 //-----------------------------------------------------------------------------
@@ -324,6 +2538,45 @@ double omnia_acosh(const double x);
 */
 double omnia_atanh(const double x);
 
+//! Hyperbolic arcsine of each element of an array
+/*!
+    Calculates result[i] = sinh<sup>-1</sup>(x[i]) with a vectorized
+    kernel. At OMNIA_ACCURACY_ULP results are within 2 ULP; the other
+    tiers bound the relative error as for omnia_log_array. The result
+    may be the same array as the input.
+    \param x array of values
+    \param result receives <i>n</i> results
+    \param n number of elements in each array
+    \param accuracy accuracy tier
+*/
+void omnia_asinh_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
+
+//! Hyperbolic arccosine of each element of an array
+/*!
+    Calculates result[i] = cosh<sup>-1</sup>(x[i]) with a vectorized
+    kernel. At OMNIA_ACCURACY_ULP results are within 2 ULP. Elements
+    less than one produce NaN. The result may be the same array as the
+    input.
+    \param x array of values
+    \param result receives <i>n</i> results
+    \param n number of elements in each array
+    \param accuracy accuracy tier
+*/
+void omnia_acosh_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
+
+//! Hyperbolic arctangent of each element of an array
+/*!
+    Calculates result[i] = tanh<sup>-1</sup>(x[i]) with a vectorized
+    kernel. At OMNIA_ACCURACY_ULP results are within 2 ULP. Elements
+    of magnitude one produce infinities, and greater magnitudes NaN.
+    The result may be the same array as the input.
+    \param x array of values
+    \param result receives <i>n</i> results
+    \param n number of elements in each array
+    \param accuracy accuracy tier
+*/
+void omnia_atanh_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy);
+
 //-----------------------------------------------------------------------------
 // Constants
 //-----------------------------------------------------------------------------
@@ -407,6 +2660,115 @@ double omnia_atanh(const double x);
 //! Euler constant
 #define OMNIA_EULER           0.57721566490153286060651209008
 
+//-----------------------------------------------------------------------------
+// Inline definitions
+//-----------------------------------------------------------------------------
+
+#if defined(OMNIA_INLINE_API)
+
+OMNIA_INLINE_API void omnia_xs128p_seed_r(omnia_xs128p_t * state, const uint64_t seed[2])
+{
+    state->s[0] = seed[0];
+    state->s[1] = seed[1];
+}
+
+OMNIA_INLINE_API uint64_t omnia_xs128p_next_r(omnia_xs128p_t * state)
+{
+    uint64_t x = state->s[0];
+    const uint64_t y = state->s[1];
+
+    state->s[0] = y;
+    x ^= x << 23;
+    state->s[1] = x ^ y ^ (x >> 17) ^ (y >> 26);
+
+    return state->s[1] + y;
+}
+
+OMNIA_INLINE_API double omnia_xs128p_real_r(omnia_xs128p_t * state)
+{
+    return (double)omnia_xs128p_next_r(state) / 18446744073709551615.0;
+}
+
+OMNIA_INLINE_API uint64_t omnia_xs128p_range_r(omnia_xs128p_t * state, uint64_t lo, uint64_t hi)
+{
+    if (hi == lo)
+        return hi;
+
+    if (hi < lo)
+    {
+        const uint64_t tt = hi;
+        hi = lo;
+        lo = tt;
+    }
+
+    const double range = hi - lo + 1.0;
+    return lo + (uint64_t)(floor(range * omnia_xs128p_real_r(state)));
+}
+
+OMNIA_INLINE_API size_t omnia_xs128p_index_r(omnia_xs128p_t * state, const size_t length)
+{
+    return (size_t)((double)length * omnia_xs128p_real_r(state));
+}
+
+/*
+    Stein's binary GCD. Each step strips all factors of two with a single
+    count-trailing-zeros instruction and subtracts, avoiding the 64-bit
+    division of Euclid's algorithm. The minimum and the difference are
+    written as selects, so the loop has no unpredictable branches.
+*/
+OMNIA_INLINE_API uint64_t omnia_gcf(uint64_t x, uint64_t y)
+{
+    if (x == 0)
+        return y;
+
+    if (y == 0)
+        return x;
+
+    // common factors of two
+    const unsigned int shift = omnia_ctz_u64(x | y);
+
+    x >>= omnia_ctz_u64(x);
+    y >>= omnia_ctz_u64(y);
+
+    // both values are odd, so their difference is even
+    while (x != y)
+    {
+        const uint64_t diff = (x > y) ? x - y : y - x;
+
+        x = (x < y) ? x : y;
+        y = diff >> omnia_ctz_u64(diff);
+    }
+
+    return x << shift;
+}
+
+OMNIA_INLINE_API double omnia_round_nearest(const double x)
+{
+    double result, dummy;
+    const double fraction = fabs(modf(x, &result));
+
+    // exact halves go to the even neighbour, others to the nearer one
+    if ((fraction > 0.5) || ((fraction == 0.5) && (modf(result / 2.0, &dummy) != 0.0)))
+    {
+        if (x < 0.0)
+            result -= 1.0;
+        else
+            result += 1.0;
+    }
+
+    return result;
+}
+
+OMNIA_INLINE_API int omnia_sizepow2(const int n)
+{
+    if ((n > 0) && (n <= (INT_MAX / 2) + 1))
+        return (int)omnia_next_pow2_u32((uint32_t)n);
+
+    return 0;
+}
+
+#endif
+
 #if defined(__cplusplus)
 }
 #endif
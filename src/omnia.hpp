@@ -0,0 +1,738 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+    
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide 
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD 
+    License), the text of which is available at the website above. 
+*/
+
+#if !defined(LIBOMNIA_HPP)
+#define LIBOMNIA_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "omnia.h"
+
+/*
+    Header-only C++ versions of the library's pseudorandom number
+    generators. Each generator is a small class holding its own state,
+    so calls inline into the caller's loop instead of going through the
+    shared library, and separate objects give independent streams.
+
+    The classes satisfy the UniformRandomBitGenerator requirements of
+    C++11 and can drive the std:: distributions. Seeded alike, each
+    produces the same sequence as its C counterpart.
+*/
+
+namespace omnia
+{
+
+//-----------------------------------------------------------------------------
+// xorshift+ 64 bits
+//-----------------------------------------------------------------------------
+
+//! xorshift128+ generator; equivalent to omnia_xs128p_next
+class xs128p
+{
+public:
+    typedef uint64_t result_type;
+
+    //! Construct with a fixed default seed
+    constexpr xs128p()
+      : s0_(0x9e3779b97f4a7c15ULL), s1_(0xbf58476d1ce4e5b9ULL)
+    {
+    }
+
+    //! Construct from a 128-bit seed, which must not be all zero
+    /*!
+        \param seed0 first word, as seed[0] for omnia_xs128p_set_seed
+        \param seed1 second word, as seed[1] for omnia_xs128p_set_seed
+    */
+    constexpr xs128p(const uint64_t seed0, const uint64_t seed1)
+      : s0_(seed0), s1_(seed1)
+    {
+    }
+
+    //! Reseed the generator
+    void seed(const uint64_t seed0, const uint64_t seed1)
+    {
+        s0_ = seed0;
+        s1_ = seed1;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    //! Get the next integer
+    result_type operator()()
+    {
+        uint64_t x = s0_;
+        const uint64_t y = s1_;
+
+        s0_ = y;
+        x ^= x << 23;
+        s1_ = x ^ y ^ (x >> 17) ^ (y >> 26);
+
+        return s1_ + y;
+    }
+
+    //! Fill an array with the next n integers
+    void fill(uint64_t * result, const size_t n)
+    {
+        xs128p local(*this);
+
+        for (size_t i = 0; i < n; ++i)
+            result[i] = local();
+
+        *this = local;
+    }
+
+    //! Jump ahead by 2^64 values, as omnia_xs128p_jump
+    void jump()
+    {
+        static const uint64_t JUMP[2] = { 0x8c405782bca686adULL, 0xc44f35946fef49c6ULL };
+
+        uint64_t j0 = 0;
+        uint64_t j1 = 0;
+
+        for (int i = 0; i < 2; ++i)
+        {
+            for (int b = 0; b < 64; ++b)
+            {
+                if (JUMP[i] & (1ULL << b))
+                {
+                    j0 ^= s0_;
+                    j1 ^= s1_;
+                }
+
+                (*this)();
+            }
+        }
+
+        s0_ = j0;
+        s1_ = j1;
+    }
+
+    //! Advance by n values without returning them
+    void discard(unsigned long long n)
+    {
+        for (; n != 0; --n)
+            (*this)();
+    }
+
+    friend bool operator==(const xs128p & a, const xs128p & b)
+    {
+        return (a.s0_ == b.s0_) && (a.s1_ == b.s1_);
+    }
+
+    friend bool operator!=(const xs128p & a, const xs128p & b)
+    {
+        return !(a == b);
+    }
+
+private:
+    uint64_t s0_;
+    uint64_t s1_;
+};
+
+//-----------------------------------------------------------------------------
+// Kiss 64 bits
+//-----------------------------------------------------------------------------
+
+//! 64-bit KISS generator; equivalent to omnia_kiss64_next
+class kiss64
+{
+public:
+    typedef uint64_t result_type;
+
+    //! Construct with the library's initial state
+    constexpr kiss64()
+      : x_(1234567890987654321ULL), c_(123456123456123456ULL), y_(362436362436362436ULL),
+        z_(1066149217761810ULL), t_(29979245822353888ULL)
+    {
+    }
+
+    //! Construct from a seed, as omnia_kiss64_set_seed
+    explicit constexpr kiss64(const uint64_t seed)
+      : x_(1234567890987654321ULL ^ seed), c_(123456123456123456ULL),
+        y_(((362436362436362436ULL ^ seed) != 0) ? (362436362436362436ULL ^ seed) : 362436362436362436ULL),
+        z_(1066149217761810ULL ^ seed), t_(29979245822353888ULL)
+    {
+    }
+
+    //! Reseed the generator
+    void seed(const uint64_t seed)
+    {
+        *this = kiss64(seed);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    //! Get the next integer
+    result_type operator()()
+    {
+        t_ = (x_ << 58) + c_;
+        c_ = x_ >> 6;
+        x_ += t_;
+        c_ += (x_ < t_);
+
+        y_ ^= y_ << 13;
+        y_ ^= y_ >> 17;
+        y_ ^= y_ << 43;
+
+        z_ = 6906969069ULL * z_ + 1234567;
+
+        t_ = x_ + y_ + z_;
+        return t_;
+    }
+
+    //! Fill an array with the next n integers
+    void fill(uint64_t * result, const size_t n)
+    {
+        kiss64 local(*this);
+
+        for (size_t i = 0; i < n; ++i)
+            result[i] = local();
+
+        *this = local;
+    }
+
+    //! Advance by n values without returning them
+    void discard(unsigned long long n)
+    {
+        for (; n != 0; --n)
+            (*this)();
+    }
+
+    friend bool operator==(const kiss64 & a, const kiss64 & b)
+    {
+        return (a.x_ == b.x_) && (a.c_ == b.c_) && (a.y_ == b.y_) && (a.z_ == b.z_);
+    }
+
+    friend bool operator!=(const kiss64 & a, const kiss64 & b)
+    {
+        return !(a == b);
+    }
+
+private:
+    uint64_t x_;
+    uint64_t c_;
+    uint64_t y_;
+    uint64_t z_;
+    uint64_t t_;
+};
+
+//-----------------------------------------------------------------------------
+// Kiss 32 bits
+//-----------------------------------------------------------------------------
+
+//! 32-bit KISS generator; equivalent to omnia_kiss32_next
+class kiss32
+{
+public:
+    typedef uint32_t result_type;
+
+    //! Construct with a fixed default seed
+    constexpr kiss32()
+      : kiss32(0)
+    {
+    }
+
+    //! Construct from a seed, as omnia_kiss32_set_seed
+    explicit constexpr kiss32(const uint32_t seed)
+      : m0_(step(seed, 1)), m1_(step(m0_, 2)), m2_(step(m1_, 3)), m3_(step(m2_, 5))
+    {
+    }
+
+    //! Reseed the generator
+    void seed(const uint32_t seed)
+    {
+        *this = kiss32(seed);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    //! Get the next integer
+    result_type operator()()
+    {
+        m1_ = 69069 * m1_ + 12345;
+        m2_ ^= m2_ << 13;
+        m2_ ^= m2_ >> 17;
+        m2_ ^= m2_ <<  5;
+
+        const uint64_t temp = 698769069ULL * m3_ + m0_;
+        m0_ = (uint32_t)(temp >> 32);
+        m3_ = (uint32_t)temp;
+
+        return m1_ + m2_ + m3_;
+    }
+
+    //! Fill an array with the next n integers
+    void fill(uint32_t * result, const size_t n)
+    {
+        kiss32 local(*this);
+
+        for (size_t i = 0; i < n; ++i)
+            result[i] = local();
+
+        *this = local;
+    }
+
+    //! Advance by n values without returning them
+    void discard(unsigned long long n)
+    {
+        for (; n != 0; --n)
+            (*this)();
+    }
+
+    friend bool operator==(const kiss32 & a, const kiss32 & b)
+    {
+        return (a.m0_ == b.m0_) && (a.m1_ == b.m1_) && (a.m2_ == b.m2_) && (a.m3_ == b.m3_);
+    }
+
+    friend bool operator!=(const kiss32 & a, const kiss32 & b)
+    {
+        return !(a == b);
+    }
+
+private:
+    // one step of the seeding recurrence
+    static constexpr uint32_t step(const uint32_t v, const uint32_t k)
+    {
+        return 1812433253U * (v ^ (v >> 30)) + k;
+    }
+
+    uint32_t m0_;
+    uint32_t m1_;
+    uint32_t m2_;
+    uint32_t m3_;
+};
+
+//-----------------------------------------------------------------------------
+// xoshiro256** and xoshiro256++
+//-----------------------------------------------------------------------------
+
+//! xoshiro256 generator with either output function; see the typedefs below
+template <bool StarStar>
+class xoshiro256_engine
+{
+public:
+    typedef uint64_t result_type;
+
+    //! Construct with a fixed default seed
+    xoshiro256_engine()
+    {
+        seed(0);
+    }
+
+    //! Construct from a seed, as omnia_xoshiro256_seed_r
+    explicit xoshiro256_engine(const uint64_t seed_value)
+    {
+        seed(seed_value);
+    }
+
+    //! Construct from a 256-bit state, which must not be all zero
+    xoshiro256_engine(const uint64_t s0, const uint64_t s1, const uint64_t s2, const uint64_t s3)
+      : s_{ s0, s1, s2, s3 }
+    {
+    }
+
+    //! Reseed the generator, as omnia_xoshiro256_seed_r
+    void seed(const uint64_t seed_value)
+    {
+        uint64_t mix = seed_value;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            uint64_t v = (mix += 0x9e3779b97f4a7c15ULL);
+
+            v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            v = (v ^ (v >> 27)) * 0x94d049bb133111ebULL;
+            s_[i] = v ^ (v >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    //! Get the next integer
+    result_type operator()()
+    {
+        const uint64_t result = StarStar ? rotl(s_[1] * 5, 7) * 9 : rotl(s_[0] + s_[3], 23) + s_[0];
+        const uint64_t t = s_[1] << 17;
+
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+
+        return result;
+    }
+
+    //! Fill an array with the next n integers
+    void fill(uint64_t * result, const size_t n)
+    {
+        xoshiro256_engine local(*this);
+
+        for (size_t i = 0; i < n; ++i)
+            result[i] = local();
+
+        *this = local;
+    }
+
+    //! Jump ahead by 2^128 values, as omnia_xoshiro256_jump_r
+    void jump()
+    {
+        static const uint64_t JUMP[4] =
+        {
+            0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+        };
+
+        uint64_t j[4] = { 0, 0, 0, 0 };
+
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int b = 0; b < 64; ++b)
+            {
+                if (JUMP[i] & (1ULL << b))
+                {
+                    for (int k = 0; k < 4; ++k)
+                        j[k] ^= s_[k];
+                }
+
+                (*this)();
+            }
+        }
+
+        for (int k = 0; k < 4; ++k)
+            s_[k] = j[k];
+    }
+
+    //! Advance by n values without returning them
+    void discard(unsigned long long n)
+    {
+        for (; n != 0; --n)
+            (*this)();
+    }
+
+    friend bool operator==(const xoshiro256_engine & a, const xoshiro256_engine & b)
+    {
+        return (a.s_[0] == b.s_[0]) && (a.s_[1] == b.s_[1]) && (a.s_[2] == b.s_[2]) && (a.s_[3] == b.s_[3]);
+    }
+
+    friend bool operator!=(const xoshiro256_engine & a, const xoshiro256_engine & b)
+    {
+        return !(a == b);
+    }
+
+private:
+    static uint64_t rotl(const uint64_t x, const int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t s_[4];
+};
+
+//! xoshiro256** generator; equivalent to omnia_xoshiro256ss_next_r
+typedef xoshiro256_engine<true> xoshiro256ss;
+
+//! xoshiro256++ generator; equivalent to omnia_xoshiro256pp_next_r
+typedef xoshiro256_engine<false> xoshiro256pp;
+
+//-----------------------------------------------------------------------------
+// PCG64
+//-----------------------------------------------------------------------------
+
+//! PCG64 (XSL-RR 128/64) generator; equivalent to omnia_pcg64_next_r
+class pcg64
+{
+public:
+    typedef uint64_t result_type;
+
+    //! Construct with a fixed default seed and stream
+    pcg64()
+    {
+        seed(0, 0);
+    }
+
+    //! Construct from a seed and stream, as omnia_pcg64_seed_r with zero high words
+    pcg64(const uint64_t seed_value, const uint64_t stream)
+    {
+        seed(seed_value, stream);
+    }
+
+    //! Reseed the generator, as omnia_pcg64_seed_r with zero high words
+    void seed(const uint64_t seed_value, const uint64_t stream)
+    {
+        inc_ = ((wide_t)stream << 1) | 1;
+        state_ = inc_;
+        state_ += seed_value;
+        state_ = state_ * multiplier() + inc_;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    //! Get the next integer
+    result_type operator()()
+    {
+        state_ = state_ * multiplier() + inc_;
+
+        const uint64_t x = (uint64_t)(state_ >> 64) ^ (uint64_t)state_;
+        const unsigned r = (unsigned)(state_ >> 122);
+
+        return (x >> r) | (x << ((64 - r) & 63));
+    }
+
+    //! Fill an array with the next n integers
+    void fill(uint64_t * result, const size_t n)
+    {
+        pcg64 local(*this);
+
+        for (size_t i = 0; i < n; ++i)
+            result[i] = local();
+
+        *this = local;
+    }
+
+    //! Jump ahead by 2^64 values, as omnia_pcg64_jump_r
+    void jump()
+    {
+        wide_t m = multiplier();
+        wide_t c = inc_;
+
+        for (int i = 0; i < 64; ++i)
+        {
+            c *= m + 1;
+            m *= m;
+        }
+
+        state_ = state_ * m + c;
+    }
+
+    //! Advance by n values without returning them
+    void discard(unsigned long long n)
+    {
+        for (; n != 0; --n)
+            (*this)();
+    }
+
+    friend bool operator==(const pcg64 & a, const pcg64 & b)
+    {
+        return (a.state_ == b.state_) && (a.inc_ == b.inc_);
+    }
+
+    friend bool operator!=(const pcg64 & a, const pcg64 & b)
+    {
+        return !(a == b);
+    }
+
+private:
+    __extension__ typedef unsigned __int128 wide_t;
+
+    static wide_t multiplier()
+    {
+        return ((wide_t)0x2360ed051fc65da4ULL << 64) | 0x4385df649fccf645ULL;
+    }
+
+    wide_t state_;
+    wide_t inc_;
+};
+
+//-----------------------------------------------------------------------------
+// wyrand
+//-----------------------------------------------------------------------------
+
+//! wyrand generator; equivalent to omnia_wyrand_next_r
+class wyrand
+{
+public:
+    typedef uint64_t result_type;
+
+    //! Construct from a seed; any value is valid
+    explicit constexpr wyrand(const uint64_t seed = 0)
+      : s_(seed)
+    {
+    }
+
+    //! Reseed the generator
+    void seed(const uint64_t seed)
+    {
+        s_ = seed;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    //! Get the next integer
+    result_type operator()()
+    {
+        __extension__ typedef unsigned __int128 wide_t;
+
+        s_ += 0x2d358dccaa6c78a5ULL;
+
+        const wide_t t = (wide_t)s_ * (s_ ^ 0x8bb84b93962eacc9ULL);
+        return (uint64_t)(t >> 64) ^ (uint64_t)t;
+    }
+
+    //! Fill an array with the next n integers
+    void fill(uint64_t * result, const size_t n)
+    {
+        wyrand local(*this);
+
+        for (size_t i = 0; i < n; ++i)
+            result[i] = local();
+
+        *this = local;
+    }
+
+    //! Jump ahead by 2^32 values, as omnia_wyrand_jump_r
+    void jump()
+    {
+        s_ += 0x2d358dccaa6c78a5ULL << 32;
+    }
+
+    //! Advance by n values without returning them
+    void discard(unsigned long long n)
+    {
+        s_ += 0x2d358dccaa6c78a5ULL * n;
+    }
+
+    friend bool operator==(const wyrand & a, const wyrand & b)
+    {
+        return a.s_ == b.s_;
+    }
+
+    friend bool operator!=(const wyrand & a, const wyrand & b)
+    {
+        return !(a == b);
+    }
+
+private:
+    uint64_t s_;
+};
+
+//-----------------------------------------------------------------------------
+// Helpers for any UniformRandomBitGenerator
+//-----------------------------------------------------------------------------
+
+//! Get the next integer in the range [lo,hi]
+/*!
+    Uses Lemire's multiply-and-shift method with rejection, so every
+    value in the range is equally likely and no division or floating
+    point is involved in the common case. The results differ from those
+    of the C range functions, which scale a floating-point value.
+    \param engine a generator whose full range is 32 or 64 bits
+    \param lo minimum value of result
+    \param hi maximum value of result
+    \return a pseudorandom value in [lo,hi]
+*/
+template <typename Engine>
+inline typename Engine::result_type range(Engine & engine, typename Engine::result_type lo, typename Engine::result_type hi)
+{
+    typedef typename Engine::result_type value_type;
+
+    static_assert((Engine::min() == 0) && ((Engine::max() == UINT32_MAX) || (Engine::max() == UINT64_MAX)),
+                  "range needs a generator of 32 or 64 full bits");
+
+    if (hi < lo)
+    {
+        const value_type tt = hi;
+        hi = lo;
+        lo = tt;
+    }
+
+    // the span, less one, so that the full range does not overflow
+    const value_type span = hi - lo;
+
+    if (span == Engine::max())
+        return engine();
+
+    const value_type n = span + 1;
+
+    if (Engine::max() == UINT32_MAX)
+    {
+        uint64_t m = (uint64_t)(uint32_t)engine() * n;
+
+        if ((uint32_t)m < n)
+        {
+            const uint32_t threshold = (uint32_t)(-(uint32_t)n) % (uint32_t)n;
+
+            while ((uint32_t)m < threshold)
+                m = (uint64_t)(uint32_t)engine() * n;
+        }
+
+        return lo + (value_type)(m >> 32);
+    }
+    else
+    {
+        __extension__ typedef unsigned __int128 wide_t;
+
+        wide_t m = (wide_t)(uint64_t)engine() * n;
+
+        if ((uint64_t)m < n)
+        {
+            const uint64_t threshold = (uint64_t)(-(uint64_t)n) % (uint64_t)n;
+
+            while ((uint64_t)m < threshold)
+                m = (wide_t)(uint64_t)engine() * n;
+        }
+
+        return lo + (value_type)(m >> 64);
+    }
+}
+
+//! Get the next random value as an index in [0,length)
+/*!
+    \param engine a generator whose full range is 32 or 64 bits
+    \param length number of possible values; must not be zero
+    \return a pseudorandom index
+*/
+template <typename Engine>
+inline size_t index(Engine & engine, const size_t length)
+{
+    return (size_t)range(engine, 0, (typename Engine::result_type)(length - 1));
+}
+
+//! Get the next number in the range [0,1)
+/*!
+    Uses as many high bits of the generator as the floating-point type
+    has significand bits, so every result is a multiple of the type's
+    epsilon and 1 is never returned.
+    \param engine a generator whose full range is 32 or 64 bits
+    \return a pseudorandom value in [0,1)
+*/
+template <typename Real = double, typename Engine>
+inline Real real(Engine & engine)
+{
+    static_assert(std::is_floating_point<Real>::value, "real needs a floating-point type");
+
+    typedef typename Engine::result_type value_type;
+
+    const int bits = std::numeric_limits<value_type>::digits;
+    const int digits = (std::numeric_limits<Real>::digits < bits) ? std::numeric_limits<Real>::digits : bits;
+
+    return (Real)(engine() >> (bits - digits)) * std::ldexp((Real)1, -digits);
+}
+
+} // namespace omnia
+
+#endif
@@ -0,0 +1,202 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+/*
+    Helpers shared by the library's source files; internal to the library
+    and not installed.
+*/
+
+#if !defined(LIBOMNIA_INTERNAL_H)
+#define LIBOMNIA_INTERNAL_H
+
+// the library's own calls to the small functions inline too
+#if !defined(OMNIA_INLINE) && !defined(OMNIA_INLINE_EXPORT)
+#define OMNIA_INLINE
+#endif
+
+#include "omnia.h"
+#include <string.h>
+
+__extension__ typedef unsigned __int128 uint128_t;
+
+/*
+    Array kernels marked with OMNIA_VECTOR_CLONES are compiled twice on
+    x86-64: once for the baseline instruction set, and once for AVX2 with
+    FMA. The dynamic loader picks the version that suits the processor.
+*/
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define OMNIA_VECTOR_CLONES __attribute__((target_clones("arch=haswell", "default")))
+#else
+#define OMNIA_VECTOR_CLONES
+#endif
+
+/*
+    Helpers called from inside vectorized loops must be inlined, or the
+    loop is left scalar; at -O2 the inliner may decline once a kernel
+    grows large.
+*/
+#if defined(__GNUC__)
+#define OMNIA_KERNEL_INLINE static inline __attribute__((always_inline))
+#else
+#define OMNIA_KERNEL_INLINE static inline
+#endif
+
+/*
+    OMNIA_PROFILE_SCOPE(id, count) at the top of a function counts one
+    call and <i>count</i> elements against <i>id</i>, and the time until
+    the function returns. Without --enable-profile it expands to nothing.
+*/
+#if defined(OMNIA_PROFILE)
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+// a counted call in progress
+typedef struct
+{
+    omnia_profile_id_t id;
+    uint64_t count;
+    uint64_t start;
+}
+omnia_profile_scope_t;
+
+// read the time-stamp counter, or a nanosecond clock where there is none
+static inline uint64_t omnia_profile_clock(void)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+void omnia_profile_leave(const omnia_profile_scope_t * scope);
+
+static inline omnia_profile_scope_t omnia_profile_enter(const omnia_profile_id_t id, const uint64_t count)
+{
+    const omnia_profile_scope_t scope = { id, count, omnia_profile_clock() };
+    return scope;
+}
+
+#define OMNIA_PROFILE_SCOPE(id, count) \
+    const omnia_profile_scope_t omnia_profile_scope __attribute__((cleanup(omnia_profile_leave))) = omnia_profile_enter((id), (count))
+
+#else
+
+#define OMNIA_PROFILE_SCOPE(id, count) ((void)0)
+
+#endif
+
+// run [0, n) in chunks of grain elements on the library's threads
+void omnia_parallel_run(const size_t n, size_t grain, omnia_range_fn_t fn, void * data);
+
+// chunk size for a loop of n elements that keeps a result for each of at most max_chunks chunks
+size_t omnia_parallel_grain(const size_t n, const size_t max_chunks);
+
+// expand one seed into well-mixed values (SplitMix64)
+static inline uint64_t omnia_splitmix64(uint64_t * state)
+{
+    uint64_t v = (*state += 0x9e3779b97f4a7c15ULL);
+
+    v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    v = (v ^ (v >> 27)) * 0x94d049bb133111ebULL;
+    return v ^ (v >> 31);
+}
+
+// seed an xorshift+ generator from one value, so that nearby seeds give unrelated streams
+static inline void omnia_xs128p_expand_seed(omnia_xs128p_t * state, const uint64_t seed)
+{
+    uint64_t mix = seed;
+    const uint64_t s[2] = { omnia_splitmix64(&mix), omnia_splitmix64(&mix) };
+
+    // SplitMix64 outputs for consecutive counters differ, so s is never all zero
+    omnia_xs128p_seed_r(state, s);
+}
+
+//-----------------------------------------------------------------------------
+// Montgomery arithmetic, with R = 2^64
+//-----------------------------------------------------------------------------
+
+// m^-1 mod 2^64 for odd m, by Newton's iteration
+static inline uint64_t omnia_mont_inverse(const uint64_t m)
+{
+    // correct to 3 bits; each step doubles the number of correct bits
+    uint64_t inv = m;
+
+    for (int i = 0; i < 5; ++i)
+        inv *= 2 - m * inv;
+
+    return inv;
+}
+
+// t * R^-1 mod m, for t < m * R
+static inline uint64_t omnia_mont_reduce(const uint128_t t, const uint64_t m, const uint64_t inv)
+{
+    // q * m matches t in the low 64 bits, so t - q * m is exactly divisible by R
+    const uint64_t q = (uint64_t)t * inv;
+    const uint64_t h = (uint64_t)(((uint128_t)q * m) >> 64);
+    const uint64_t hi = (uint64_t)(t >> 64);
+
+    return (hi >= h) ? hi - h : hi - h + m;
+}
+
+// a * b * R^-1 mod m
+static inline uint64_t omnia_mont_mul(const uint64_t a, const uint64_t b, const uint64_t m, const uint64_t inv)
+{
+    return omnia_mont_reduce((uint128_t)a * b, m, inv);
+}
+
+// b^e in Montgomery form, for b in Montgomery form; one is R mod m
+static inline uint64_t omnia_mont_pow(uint64_t b, uint64_t e, const uint64_t one, const uint64_t m, const uint64_t inv)
+{
+    uint64_t result = one;
+
+    while (e != 0)
+    {
+        if (e & 1)
+            result = omnia_mont_mul(result, b, m, inv);
+
+        e >>= 1;
+
+        if (e != 0)
+            b = omnia_mont_mul(b, b, m, inv);
+    }
+
+    return result;
+}
+
+// allocate zeroed memory from the current allocator
+static inline void * omnia_alloc_zero(const size_t count, const size_t size)
+{
+    if ((size != 0) && (count > SIZE_MAX / size))
+        return NULL;
+
+    void * block = omnia_alloc(count * size);
+
+    if (block != NULL)
+        memset(block, 0, count * size);
+
+    return block;
+}
+
+#endif
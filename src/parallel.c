@@ -0,0 +1,364 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/*
+    A pool of worker threads, started the first time a loop is worth
+    splitting, runs one parallel loop at a time; the calling thread works
+    too. A loop of n elements is cut into chunks of the grain size, and
+    each participant is given a contiguous run of chunks. A participant
+    takes chunks from the front of its own run and, once that is empty,
+    steals from the back of the others', so uneven chunks balance out
+    without a shared queue. A run's bounds are packed into one word and
+    updated by compare-and-swap, which is the only synchronization while
+    a loop is running.
+
+    A parallel loop started from inside a chunk runs serially on the
+    thread that started it, as does one started by another thread while
+    the pool is busy, so that independent callers never wait for each
+    other.
+*/
+
+// elements per chunk unless the caller says otherwise
+#define DEFAULT_GRAIN 65536
+
+#define CACHE_LINE 64
+
+// a participant's run of chunks: first in the low half, end in the high half
+typedef struct
+{
+    uint64_t bounds;
+    char pad[CACHE_LINE - sizeof(uint64_t)];
+}
+__attribute__((aligned(CACHE_LINE))) run_t;
+
+// the loop being run
+typedef struct
+{
+    omnia_range_fn_t fn;
+    void * data;
+    size_t n;
+    size_t grain;
+}
+job_t;
+
+static pthread_mutex_t loop_lock = PTHREAD_MUTEX_INITIALIZER;  // held by the thread running a loop; also guards the pool's setup
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;  // protects generation, pending and stopping
+static pthread_cond_t start = PTHREAD_COND_INITIALIZER;        // signalled when a loop is posted
+static pthread_cond_t done = PTHREAD_COND_INITIALIZER;         // signalled when the last worker finishes
+
+static size_t thread_setting = 0;       // requested threads; 0 for one per online processor
+static size_t grain_setting = DEFAULT_GRAIN;
+
+static size_t online = 0;              // online processors, once known
+
+static pthread_t * workers = NULL;
+static size_t worker_count = 0;         // workers running
+static size_t pool_size = 0;            // workers asked for when the pool started
+static run_t * runs = NULL;             // worker_count + 1, the caller's last
+static job_t job;
+static uint64_t generation = 0;
+static size_t pending = 0;
+static bool stopping = false;
+
+static __thread bool inside = false;
+
+// take a chunk from the front or back of a run
+static bool take(run_t * run, const bool back, size_t * chunk)
+{
+    uint64_t old = __atomic_load_n(&run->bounds, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        const uint64_t first = old & 0xffffffffULL;
+        const uint64_t end = old >> 32;
+
+        if (first >= end)
+            return false;
+
+        const uint64_t update = back ? (((end - 1) << 32) | first) : ((end << 32) | (first + 1));
+
+        if (__atomic_compare_exchange_n(&run->bounds, &old, update, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            *chunk = (size_t)(back ? end - 1 : first);
+            return true;
+        }
+    }
+}
+
+// run chunks until none are left anywhere
+static void work(const size_t self)
+{
+    const size_t count = worker_count + 1;
+    size_t chunk;
+
+    for (;;)
+    {
+        bool found = take(&runs[self], false, &chunk);
+
+        for (size_t k = 1; !found && (k < count); ++k)
+            found = take(&runs[(self + k) % count], true, &chunk);
+
+        if (!found)
+            return;
+
+        const size_t begin = chunk * job.grain;
+        const size_t end = (job.n - begin < job.grain) ? job.n : begin + job.grain;
+
+        job.fn(begin, end, job.data);
+    }
+}
+
+static void * worker(void * arg)
+{
+    const size_t self = (size_t)(uintptr_t)arg;
+    uint64_t seen = 0;
+
+    inside = true;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&pool_lock);
+
+        while ((generation == seen) && !stopping)
+            pthread_cond_wait(&start, &pool_lock);
+
+        if (stopping)
+        {
+            pthread_mutex_unlock(&pool_lock);
+            return NULL;
+        }
+
+        seen = generation;
+        pthread_mutex_unlock(&pool_lock);
+
+        work(self);
+
+        pthread_mutex_lock(&pool_lock);
+
+        if (--pending == 0)
+            pthread_cond_signal(&done);
+
+        pthread_mutex_unlock(&pool_lock);
+    }
+}
+
+// threads to use under the current setting
+static size_t thread_target(void)
+{
+    const size_t threads = __atomic_load_n(&thread_setting, __ATOMIC_RELAXED);
+
+    if (threads != 0)
+        return threads;
+
+    size_t count = __atomic_load_n(&online, __ATOMIC_RELAXED);
+
+    if (count == 0)
+    {
+        const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+        count = (processors > 0) ? (size_t)processors : 1;
+        __atomic_store_n(&online, count, __ATOMIC_RELAXED);
+    }
+
+    return count;
+}
+
+// stop and release the workers; loop_lock must be held
+static void stop_pool(void)
+{
+    pthread_mutex_lock(&pool_lock);
+    stopping = true;
+    pthread_cond_broadcast(&start);
+    pthread_mutex_unlock(&pool_lock);
+
+    for (size_t i = 0; i < worker_count; ++i)
+        pthread_join(workers[i], NULL);
+
+    free(workers);
+    free(runs);
+
+    workers = NULL;
+    runs = NULL;
+    worker_count = 0;
+    pool_size = 0;
+    stopping = false;
+}
+
+// start the workers if needed; loop_lock must be held. False leaves no workers
+static bool start_pool(void)
+{
+    const size_t wanted = thread_target() - 1;
+
+    if ((runs != NULL) && (pool_size == wanted))
+        return true;
+
+    stop_pool();
+
+    // the pool is internal, so it uses the system allocator rather than the library's
+    void * memory = NULL;
+
+    if (posix_memalign(&memory, CACHE_LINE, sizeof(run_t) * (wanted + 1)) != 0)
+        return false;
+
+    runs = (run_t *)memory;
+    workers = (pthread_t *)malloc(sizeof(pthread_t) * (wanted + 1));
+
+    if (workers == NULL)
+    {
+        free(runs);
+        runs = NULL;
+        return false;
+    }
+
+    for (size_t i = 0; i <= wanted; ++i)
+        runs[i].bounds = 0;
+
+    pool_size = wanted;
+
+    // with fewer workers than asked for, the loop just has fewer participants
+    while (worker_count < wanted)
+    {
+        if (pthread_create(&workers[worker_count], NULL, worker, (void *)(uintptr_t)worker_count) != 0)
+            break;
+
+        ++worker_count;
+    }
+
+    return true;
+}
+
+// Run a loop in chunks of a given size
+void omnia_parallel_run(const size_t n, size_t grain, omnia_range_fn_t fn, void * data)
+{
+    if (n == 0)
+        return;
+
+    if (grain == 0)
+        grain = 1;
+
+    // chunk numbers must fit in half of a run's bounds
+    if ((n - 1) / grain >= UINT32_MAX)
+        grain = (n - 1) / (UINT32_MAX - 1) + 1;
+
+    const size_t chunks = (n - 1) / grain + 1;
+
+    if ((chunks > 1) && !inside && (thread_target() > 1) && (pthread_mutex_trylock(&loop_lock) == 0))
+    {
+        if (start_pool() && (worker_count > 0))
+        {
+            const size_t count = worker_count + 1;
+
+            job.fn = fn;
+            job.data = data;
+            job.n = n;
+            job.grain = grain;
+
+            // contiguous runs, the first (chunks % count) one longer
+            for (size_t i = 0, first = 0; i < count; ++i)
+            {
+                const size_t length = chunks / count + ((i < chunks % count) ? 1 : 0);
+
+                runs[i].bounds = ((uint64_t)(first + length) << 32) | (uint64_t)first;
+                first += length;
+            }
+
+            pthread_mutex_lock(&pool_lock);
+            ++generation;
+            pending = worker_count;
+            pthread_cond_broadcast(&start);
+            pthread_mutex_unlock(&pool_lock);
+
+            inside = true;
+            work(worker_count);
+            inside = false;
+
+            pthread_mutex_lock(&pool_lock);
+
+            while (pending > 0)
+                pthread_cond_wait(&done, &pool_lock);
+
+            pthread_mutex_unlock(&pool_lock);
+            pthread_mutex_unlock(&loop_lock);
+            return;
+        }
+
+        pthread_mutex_unlock(&loop_lock);
+    }
+
+    // the same chunks, in order, on this thread
+    for (size_t begin = 0; begin < n; begin += grain)
+        fn(begin, (n - begin < grain) ? n : begin + grain, data);
+}
+
+// Chunk size for a loop that keeps a result per chunk
+size_t omnia_parallel_grain(const size_t n, const size_t max_chunks)
+{
+    const size_t grain = omnia_get_grain();
+    const size_t least = (n + max_chunks - 1) / max_chunks;
+
+    return (least > grain) ? least : grain;
+}
+
+// Set the number of threads
+void omnia_set_threads(const size_t threads)
+{
+    __atomic_store_n(&thread_setting, threads, __ATOMIC_RELAXED);
+
+    // inside a loop, loop_lock is held by this thread or by the one that
+    // started the loop; start_pool restarts a pool of the wrong size
+    if (inside)
+        return;
+
+    // release the workers now rather than when the next loop is run
+    pthread_mutex_lock(&loop_lock);
+
+    if (runs != NULL)
+        stop_pool();
+
+    pthread_mutex_unlock(&loop_lock);
+}
+
+// Get the number of threads
+size_t omnia_get_threads(void)
+{
+    return thread_target();
+}
+
+// Set the grain size
+void omnia_set_grain(const size_t grain)
+{
+    __atomic_store_n(&grain_setting, (grain == 0) ? DEFAULT_GRAIN : grain, __ATOMIC_RELAXED);
+}
+
+// Get the grain size
+size_t omnia_get_grain(void)
+{
+    return __atomic_load_n(&grain_setting, __ATOMIC_RELAXED);
+}
+
+// Run a loop on the library's threads
+void omnia_parallel_for(const size_t n, omnia_range_fn_t fn, void * data)
+{
+    if (fn != NULL)
+        omnia_parallel_run(n, omnia_get_grain(), fn, data);
+}
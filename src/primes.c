@@ -0,0 +1,309 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+
+/*
+    Primality is decided by Miller-Rabin with the seven bases found by
+    Jim Sinclair, which together have no strong pseudoprime below 2^64;
+    the test is therefore deterministic for every uint64_t. All modular
+    arithmetic is done in Montgomery form.
+
+    Small factors are removed by trial division, using the multiplicative
+    inverse of each prime: n is divisible by odd p exactly when
+    n * p^-1 mod 2^64 <= (2^64 - 1) / p, which needs no division.
+
+    Larger factors are found by Pollard's rho method with Brent's cycle
+    detection. Differences are multiplied together and a GCD is taken
+    only once per batch; if a batch overshoots to a GCD of n, the batch
+    is replayed one step at a time.
+*/
+
+// odd primes below 256, with their inverses mod 2^64 and divisibility limits
+static const struct
+{
+    uint64_t prime;
+    uint64_t inverse;
+    uint64_t limit;
+}
+small_primes[] =
+{
+    {   3, UINT64_C(0xaaaaaaaaaaaaaaab), UINT64_C(0x5555555555555555) },
+    {   5, UINT64_C(0xcccccccccccccccd), UINT64_C(0x3333333333333333) },
+    {   7, UINT64_C(0x6db6db6db6db6db7), UINT64_C(0x2492492492492492) },
+    {  11, UINT64_C(0x2e8ba2e8ba2e8ba3), UINT64_C(0x1745d1745d1745d1) },
+    {  13, UINT64_C(0x4ec4ec4ec4ec4ec5), UINT64_C(0x13b13b13b13b13b1) },
+    {  17, UINT64_C(0xf0f0f0f0f0f0f0f1), UINT64_C(0x0f0f0f0f0f0f0f0f) },
+    {  19, UINT64_C(0x86bca1af286bca1b), UINT64_C(0x0d79435e50d79435) },
+    {  23, UINT64_C(0xd37a6f4de9bd37a7), UINT64_C(0x0b21642c8590b216) },
+    {  29, UINT64_C(0x34f72c234f72c235), UINT64_C(0x08d3dcb08d3dcb08) },
+    {  31, UINT64_C(0xef7bdef7bdef7bdf), UINT64_C(0x0842108421084210) },
+    {  37, UINT64_C(0x14c1bacf914c1bad), UINT64_C(0x06eb3e45306eb3e4) },
+    {  41, UINT64_C(0x8f9c18f9c18f9c19), UINT64_C(0x063e7063e7063e70) },
+    {  43, UINT64_C(0x82fa0be82fa0be83), UINT64_C(0x05f417d05f417d05) },
+    {  47, UINT64_C(0x51b3bea3677d46cf), UINT64_C(0x0572620ae4c415c9) },
+    {  53, UINT64_C(0x21cfb2b78c13521d), UINT64_C(0x04d4873ecade304d) },
+    {  59, UINT64_C(0xcbeea4e1a08ad8f3), UINT64_C(0x0456c797dd49c341) },
+    {  61, UINT64_C(0x4fbcda3ac10c9715), UINT64_C(0x04325c53ef368eb0) },
+    {  67, UINT64_C(0xf0b7672a07a44c6b), UINT64_C(0x03d226357e16ece5) },
+    {  71, UINT64_C(0x193d4bb7e327a977), UINT64_C(0x039b0ad12073615a) },
+    {  73, UINT64_C(0x7e3f1f8fc7e3f1f9), UINT64_C(0x0381c0e070381c0e) },
+    {  79, UINT64_C(0x9b8b577e613716af), UINT64_C(0x033d91d2a2067b23) },
+    {  83, UINT64_C(0xa3784a062b2e43db), UINT64_C(0x03159721ed7e7534) },
+    {  89, UINT64_C(0xf47e8fd1fa3f47e9), UINT64_C(0x02e05c0b81702e05) },
+    {  97, UINT64_C(0xa3a0fd5c5f02a3a1), UINT64_C(0x02a3a0fd5c5f02a3) },
+    { 101, UINT64_C(0x3a4c0a237c32b16d), UINT64_C(0x0288df0cac5b3f5d) },
+    { 103, UINT64_C(0xdab7ec1dd3431b57), UINT64_C(0x027c45979c95204f) },
+    { 107, UINT64_C(0x77a04c8f8d28ac43), UINT64_C(0x02647c69456217ec) },
+    { 109, UINT64_C(0xa6c0964fda6c0965), UINT64_C(0x02593f69b02593f6) },
+    { 113, UINT64_C(0x90fdbc090fdbc091), UINT64_C(0x0243f6f0243f6f02) },
+    { 127, UINT64_C(0x7efdfbf7efdfbf7f), UINT64_C(0x0204081020408102) },
+    { 131, UINT64_C(0x03e88cb3c9484e2b), UINT64_C(0x01f44659e4a42715) },
+    { 137, UINT64_C(0xe21a291c077975b9), UINT64_C(0x01de5d6e3f8868a4) },
+    { 139, UINT64_C(0x3aef6ca970586723), UINT64_C(0x01d77b654b82c339) },
+    { 149, UINT64_C(0xdf5b0f768ce2cabd), UINT64_C(0x01b7d6c3dda338b2) },
+    { 151, UINT64_C(0x6fe4dfc9bf937f27), UINT64_C(0x01b2036406c80d90) },
+    { 157, UINT64_C(0x5b4fe5e92c0685b5), UINT64_C(0x01a16d3f97a4b01a) },
+    { 163, UINT64_C(0x1f693a1c451ab30b), UINT64_C(0x01920fb49d0e228d) },
+    { 167, UINT64_C(0x8d07aa27db35a717), UINT64_C(0x01886e5f0abb0499) },
+    { 173, UINT64_C(0x882383b30d516325), UINT64_C(0x017ad2208e0ecc35) },
+    { 179, UINT64_C(0xed6866f8d962ae7b), UINT64_C(0x016e1f76b4337c6c) },
+    { 181, UINT64_C(0x3454dca410f8ed9d), UINT64_C(0x016a13cd15372904) },
+    { 191, UINT64_C(0x1d7ca632ee936f3f), UINT64_C(0x01571ed3c506b39a) },
+    { 193, UINT64_C(0x70bf015390948f41), UINT64_C(0x015390948f40feac) },
+    { 197, UINT64_C(0xc96bdb9d3d137e0d), UINT64_C(0x014cab88725af6e7) },
+    { 199, UINT64_C(0x2697cc8aef46c0f7), UINT64_C(0x0149539e3b2d066e) },
+    { 211, UINT64_C(0xc0e8f2a76e68575b), UINT64_C(0x013698df3de07479) },
+    { 223, UINT64_C(0x687763dfdb43bb1f), UINT64_C(0x0125e22708092f11) },
+    { 227, UINT64_C(0x1b10ea929ba144cb), UINT64_C(0x0120b470c67c0d88) },
+    { 229, UINT64_C(0x1d10c4c0478bbced), UINT64_C(0x011e2ef3b3fb8744) },
+    { 233, UINT64_C(0x63fb9aeb1fdcd759), UINT64_C(0x0119453808ca29c0) },
+    { 239, UINT64_C(0x64afaa4f437b2e0f), UINT64_C(0x0112358e75d30336) },
+    { 241, UINT64_C(0xf010fef010fef011), UINT64_C(0x010fef010fef010f) },
+    { 251, UINT64_C(0x28cbfbeb9a020a33), UINT64_C(0x0105197f7d734041) }
+};
+
+#define SMALL_PRIME_COUNT (sizeof(small_primes) / sizeof(small_primes[0]))
+
+// primes checked before Miller-Rabin (3 through 53)
+#define SCREEN_COUNT 15
+
+// squarings of Pollard's rho between GCDs
+#define RHO_BATCH 128
+
+// deterministic Miller-Rabin bases for 64-bit values
+static const uint64_t witnesses[] =
+{
+    2, 325, 9375, 28178, 450775, 9780504, 1795265022
+};
+
+// true if n is divisible by the small prime with index i
+static inline bool divisible(const uint64_t n, const size_t i)
+{
+    return n * small_primes[i].inverse <= small_primes[i].limit;
+}
+
+// Miller-Rabin for odd n > 3
+static bool miller_rabin(const uint64_t n)
+{
+    const uint64_t inv = omnia_mont_inverse(n);
+    const uint64_t one = (0 - n) % n;
+    const uint64_t minus_one = n - one;
+    const uint64_t r2 = (uint64_t)(((uint128_t)one * one) % n);
+
+    // n - 1 = d * 2^s, with d odd
+    const int s = (int)omnia_ctz_u64(n - 1);
+    const uint64_t d = (n - 1) >> s;
+
+    for (size_t w = 0; w < sizeof(witnesses) / sizeof(witnesses[0]); ++w)
+    {
+        const uint64_t a = witnesses[w] % n;
+
+        if (a == 0)
+            continue;
+
+        uint64_t x = omnia_mont_pow(omnia_mont_mul(a, r2, n, inv), d, one, n, inv);
+
+        if ((x == one) || (x == minus_one))
+            continue;
+
+        int i;
+
+        for (i = 1; i < s; ++i)
+        {
+            x = omnia_mont_mul(x, x, n, inv);
+
+            if (x == minus_one)
+                break;
+        }
+
+        if (i == s)
+            return false;
+    }
+
+    return true;
+}
+
+// Test a value for primality
+bool omnia_is_prime(const uint64_t n)
+{
+    if (n < 4)
+        return n >= 2;
+
+    if ((n & 1) == 0)
+        return false;
+
+    for (size_t i = 0; i < SCREEN_COUNT; ++i)
+    {
+        if (divisible(n, i))
+            return n == small_primes[i].prime;
+    }
+
+    // no factor up to 53, so anything below 59^2 is prime
+    if (n < 59 * 59)
+        return true;
+
+    return miller_rabin(n);
+}
+
+// Test an array of values for primality
+void omnia_is_prime_array(const uint64_t * n, bool * result, const size_t count)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_IS_PRIME_ARRAY, count);
+
+    for (size_t i = 0; i < count; ++i)
+        result[i] = omnia_is_prime(n[i]);
+}
+
+// x^2 + c mod n, in Montgomery form
+static inline uint64_t rho_step(const uint64_t x, const uint64_t c, const uint64_t n, const uint64_t inv)
+{
+    const uint64_t y = omnia_mont_mul(x, x, n, inv);
+
+    return (y >= n - c) ? y - (n - c) : y + c;
+}
+
+// a non-trivial factor of an odd composite n
+static uint64_t pollard_brent(const uint64_t n)
+{
+    const uint64_t inv = omnia_mont_inverse(n);
+    const uint64_t one = (0 - n) % n;
+
+    for (uint64_t c = 1; ; ++c)
+    {
+        uint64_t x = 0, y = 2, ys = 2, q = one, g = 1;
+
+        for (uint64_t r = 1; g == 1; r <<= 1)
+        {
+            x = y;
+
+            for (uint64_t i = 0; i < r; ++i)
+                y = rho_step(y, c, n, inv);
+
+            for (uint64_t k = 0; (k < r) && (g == 1); k += RHO_BATCH)
+            {
+                const uint64_t steps = (r - k < RHO_BATCH) ? r - k : RHO_BATCH;
+
+                ys = y;
+
+                for (uint64_t i = 0; i < steps; ++i)
+                {
+                    y = rho_step(y, c, n, inv);
+                    q = omnia_mont_mul(q, (x > y) ? x - y : y - x, n, inv);
+                }
+
+                // Montgomery form does not change the GCD, since R is coprime to n
+                g = omnia_gcf(q, n);
+            }
+        }
+
+        // the batch overshot; replay it step by step
+        if (g == n)
+        {
+            do
+            {
+                ys = rho_step(ys, c, n, inv);
+                g = omnia_gcf((x > ys) ? x - ys : ys - x, n);
+            }
+            while (g == 1);
+        }
+
+        if (g != n)
+            return g;
+    }
+}
+
+// Prime factorization
+size_t omnia_factor(uint64_t n, uint64_t * factors)
+{
+    uint64_t pending[OMNIA_FACTOR_MAX];
+    size_t count = 0, npending = 0;
+
+    if ((factors == NULL) || (n < 2))
+        return 0;
+
+    // factors of two
+    const int twos = (int)omnia_ctz_u64(n);
+
+    for (int i = 0; i < twos; ++i)
+        factors[count++] = 2;
+
+    n >>= twos;
+
+    // small odd primes
+    for (size_t i = 0; (i < SMALL_PRIME_COUNT) && (n > 1); ++i)
+    {
+        while (divisible(n, i))
+        {
+            factors[count++] = small_primes[i].prime;
+            n *= small_primes[i].inverse;
+        }
+    }
+
+    // the remaining factors are all above 256
+    if (n > 1)
+        pending[npending++] = n;
+
+    while (npending > 0)
+    {
+        const uint64_t m = pending[--npending];
+
+        if ((m < 257 * 257) || omnia_is_prime(m))
+            factors[count++] = m;
+        else
+        {
+            const uint64_t d = pollard_brent(m);
+
+            pending[npending++] = d;
+            pending[npending++] = m / d;
+        }
+    }
+
+    // ascending order
+    for (size_t i = 1; i < count; ++i)
+    {
+        const uint64_t f = factors[i];
+        size_t j = i;
+
+        for (; (j > 0) && (factors[j - 1] > f); --j)
+            factors[j] = factors[j - 1];
+
+        factors[j] = f;
+    }
+
+    return count;
+}
@@ -0,0 +1,240 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+
+/*
+    Each thread counts into its own block of counters, aligned to a cache
+    line so that no two threads write the same line. A block is linked
+    into a global list the first time its thread records a call; when the
+    thread exits, the block is kept, with its counts, for reuse by a new
+    thread. Only registration, snapshots and resets take the lock.
+
+    A reset does not write the counters, which may be mid-update on their
+    own threads; it records the current values as a baseline, and
+    snapshots report counts above the baseline.
+*/
+
+#if defined(OMNIA_PROFILE)
+
+#include <stdlib.h>
+#include <pthread.h>
+
+typedef struct
+{
+    uint64_t calls;
+    uint64_t elements;
+    uint64_t cycles;
+}
+counter_t;
+
+typedef struct block
+{
+    counter_t counters[OMNIA_PROFILE_COUNT];    // written only by the owning thread
+    counter_t baseline[OMNIA_PROFILE_COUNT];    // values at the last reset; written under the lock
+    struct block * next;
+    bool in_use;                                // owned by a running thread
+}
+block_t;
+
+#define CACHE_LINE 64
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t key;
+static block_t * blocks = NULL;
+static __thread block_t * local = NULL;
+
+// a thread with a block has exited
+static void release_block(void * block)
+{
+    pthread_mutex_lock(&lock);
+    ((block_t *)block)->in_use = false;
+    pthread_mutex_unlock(&lock);
+}
+
+static void create_key(void)
+{
+    pthread_key_create(&key, release_block);
+}
+
+// find or make a block for this thread; NULL if out of memory
+static block_t * register_thread(void)
+{
+    block_t * block;
+
+    pthread_once(&key_once, create_key);
+    pthread_mutex_lock(&lock);
+
+    for (block = blocks; block != NULL; block = block->next)
+    {
+        if (!block->in_use)
+            break;
+    }
+
+    if (block == NULL)
+    {
+        // the library's allocator may be an arena that is reset, so use the system
+        void * memory = NULL;
+        const size_t size = (sizeof(block_t) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+        if (posix_memalign(&memory, CACHE_LINE, size) == 0)
+        {
+            block = (block_t *)memory;
+            memset(block, 0, size);
+            block->next = blocks;
+            blocks = block;
+        }
+    }
+
+    if (block != NULL)
+        block->in_use = true;
+
+    pthread_mutex_unlock(&lock);
+
+    if (block != NULL)
+        pthread_setspecific(key, block);
+
+    return block;
+}
+
+// add a finished call to this thread's counters
+void omnia_profile_leave(const omnia_profile_scope_t * scope)
+{
+    const uint64_t cycles = omnia_profile_clock() - scope->start;
+
+    if ((local == NULL) && ((local = register_thread()) == NULL))
+        return;
+
+    counter_t * c = &local->counters[scope->id];
+
+    // single writer; the relaxed stores only keep readers from seeing torn values
+    __atomic_store_n(&c->calls, c->calls + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&c->elements, c->elements + scope->count, __ATOMIC_RELAXED);
+    __atomic_store_n(&c->cycles, c->cycles + cycles, __ATOMIC_RELAXED);
+}
+
+#endif
+
+// names reported by snapshots, indexed by omnia_profile_id_t
+static const char * const NAMES[OMNIA_PROFILE_COUNT] =
+{
+    "omnia_xs128p_fill",
+    "omnia_kiss64_fill",
+    "omnia_kiss32_fill",
+    "omnia_xoshiro256ss_fill_r",
+    "omnia_xoshiro256pp_fill_r",
+    "omnia_pcg64_fill_r",
+    "omnia_wyrand_fill_r",
+    "omnia_sobol_fill",
+    "omnia_halton_fill",
+    "omnia_alias_fill",
+    "omnia_round_nearest_array",
+    "omnia_sigdig_array",
+    "omnia_format_array",
+    "omnia_gcf_array",
+    "omnia_lcm_array",
+    "omnia_gcf_pairwise",
+    "omnia_montgomery_mul_array",
+    "omnia_montgomery_pow_array",
+    "omnia_is_prime_array",
+    "omnia_sieve_primes",
+    "omnia_rational_normalize_array",
+    "omnia_rational_sum",
+    "omnia_log_array",
+    "omnia_log_base_array",
+    "omnia_exp_array",
+    "omnia_sin_array",
+    "omnia_cos_array",
+    "omnia_sincos_array",
+    "omnia_asinh_array",
+    "omnia_acosh_array",
+    "omnia_atanh_array",
+    "omnia_moving_average_into",
+    "omnia_basic_stats_into",
+    "omnia_make_sinusoid_into",
+    "omnia_add_noise",
+    "omnia_fft_execute",
+    "omnia_fir_process",
+    "omnia_iir_process",
+    "omnia_autocorrelation",
+    "omnia_cross_correlation",
+    "omnia_goertzel"
+};
+
+// Is profiling compiled in?
+bool omnia_profile_enabled(void)
+{
+#if defined(OMNIA_PROFILE)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Take a snapshot of the profile counters
+void omnia_profile_snapshot(omnia_profile_entry_t result[OMNIA_PROFILE_COUNT])
+{
+    for (size_t i = 0; i < OMNIA_PROFILE_COUNT; ++i)
+    {
+        result[i].name = NAMES[i];
+        result[i].calls = 0;
+        result[i].elements = 0;
+        result[i].cycles = 0;
+    }
+
+#if defined(OMNIA_PROFILE)
+    pthread_mutex_lock(&lock);
+
+    for (const block_t * block = blocks; block != NULL; block = block->next)
+    {
+        for (size_t i = 0; i < OMNIA_PROFILE_COUNT; ++i)
+        {
+            const counter_t * c = &block->counters[i];
+            const counter_t * b = &block->baseline[i];
+
+            result[i].calls += __atomic_load_n(&c->calls, __ATOMIC_RELAXED) - b->calls;
+            result[i].elements += __atomic_load_n(&c->elements, __ATOMIC_RELAXED) - b->elements;
+            result[i].cycles += __atomic_load_n(&c->cycles, __ATOMIC_RELAXED) - b->cycles;
+        }
+    }
+
+    pthread_mutex_unlock(&lock);
+#endif
+}
+
+// Reset the profile counters
+void omnia_profile_reset(void)
+{
+#if defined(OMNIA_PROFILE)
+    pthread_mutex_lock(&lock);
+
+    for (block_t * block = blocks; block != NULL; block = block->next)
+    {
+        for (size_t i = 0; i < OMNIA_PROFILE_COUNT; ++i)
+        {
+            const counter_t * c = &block->counters[i];
+
+            block->baseline[i].calls = __atomic_load_n(&c->calls, __ATOMIC_RELAXED);
+            block->baseline[i].elements = __atomic_load_n(&c->elements, __ATOMIC_RELAXED);
+            block->baseline[i].cycles = __atomic_load_n(&c->cycles, __ATOMIC_RELAXED);
+        }
+    }
+
+    pthread_mutex_unlock(&lock);
+#endif
+}
@@ -0,0 +1,241 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+
+/*
+    Rationals are kept with a positive denominator and a numerator whose
+    magnitude is at most INT64_MAX, so that negation never overflows.
+
+    Arithmetic is carried out exactly in 128 bits; products of two
+    64-bit values cannot overflow there. A result is reduced to lowest
+    terms only when it does not fit in 64 bits as it stands, which skips
+    the GCD entirely for most operations on small values. Comparisons
+    use cross-multiplication and do not care whether their operands are
+    reduced.
+*/
+
+__extension__ typedef __int128 int128_t;
+
+// count trailing zero bits of a non-zero 128-bit value
+static inline int ctz128(const uint128_t x)
+{
+    const uint64_t low = (uint64_t)x;
+
+    return (int)((low != 0) ? omnia_ctz_u64(low) : 64 + omnia_ctz_u64((uint64_t)(x >> 64)));
+}
+
+// binary GCD of 128-bit values, finishing in 64 bits
+static uint128_t gcd128(uint128_t x, uint128_t y)
+{
+    if (x == 0)
+        return y;
+
+    if (y == 0)
+        return x;
+
+    const int shift = ctz128(x | y);
+
+    x >>= ctz128(x);
+    y >>= ctz128(y);
+
+    while ((x >> 64) | (y >> 64))
+    {
+        if (x == y)
+            return x << shift;
+
+        const uint128_t diff = (x > y) ? x - y : y - x;
+
+        x = (x < y) ? x : y;
+        y = diff >> ctz128(diff);
+    }
+
+    return (uint128_t)omnia_gcf((uint64_t)x, (uint64_t)y) << shift;
+}
+
+// store num / den, reducing only if needed; den must be positive
+static bool fit(const int128_t num, const uint128_t den, omnia_rational_t * result)
+{
+    uint128_t n = (num < 0) ? -(uint128_t)num : (uint128_t)num;
+    uint128_t d = den;
+
+    if ((n > INT64_MAX) || (d > INT64_MAX))
+    {
+        const uint128_t g = gcd128(n, d);
+
+        n /= g;
+        d /= g;
+
+        if ((n > INT64_MAX) || (d > INT64_MAX))
+            return false;
+    }
+
+    result->num = (num < 0) ? -(int64_t)n : (int64_t)n;
+    result->den = (int64_t)d;
+    return true;
+}
+
+// Create a rational number
+bool omnia_rational_set(omnia_rational_t * r, const int64_t num, const int64_t den)
+{
+    if ((r == NULL) || (den == 0))
+        return false;
+
+    // the sign goes in the numerator
+    if (den < 0)
+        return fit(-(int128_t)num, -(int128_t)den, r);
+
+    return fit(num, (uint128_t)den, r);
+}
+
+// Reduce a rational number to lowest terms
+omnia_rational_t omnia_rational_normalize(const omnia_rational_t a)
+{
+    omnia_rational_t result = a;
+    const uint64_t n = (a.num < 0) ? -(uint64_t)a.num : (uint64_t)a.num;
+    const uint64_t g = omnia_gcf(n, (uint64_t)a.den);
+
+    if (g > 1)
+    {
+        result.num = a.num / (int64_t)g;
+        result.den = a.den / (int64_t)g;
+    }
+    else if (a.num == 0)
+        result.den = 1;
+
+    return result;
+}
+
+// Add two rational numbers
+bool omnia_rational_add(const omnia_rational_t a, const omnia_rational_t b, omnia_rational_t * result)
+{
+    // common denominators need no cross-multiplication
+    if (a.den == b.den)
+        return fit((int128_t)a.num + b.num, (uint128_t)a.den, result);
+
+    return fit((int128_t)a.num * b.den + (int128_t)b.num * a.den, (uint128_t)a.den * (uint128_t)b.den, result);
+}
+
+// Subtract two rational numbers
+bool omnia_rational_sub(const omnia_rational_t a, const omnia_rational_t b, omnia_rational_t * result)
+{
+    if (a.den == b.den)
+        return fit((int128_t)a.num - b.num, (uint128_t)a.den, result);
+
+    return fit((int128_t)a.num * b.den - (int128_t)b.num * a.den, (uint128_t)a.den * (uint128_t)b.den, result);
+}
+
+// Multiply two rational numbers
+bool omnia_rational_mul(const omnia_rational_t a, const omnia_rational_t b, omnia_rational_t * result)
+{
+    return fit((int128_t)a.num * b.num, (uint128_t)a.den * (uint128_t)b.den, result);
+}
+
+// Divide two rational numbers
+bool omnia_rational_div(const omnia_rational_t a, const omnia_rational_t b, omnia_rational_t * result)
+{
+    if (b.num == 0)
+        return false;
+
+    const int128_t num = (int128_t)a.num * b.den;
+    const uint128_t den = (uint128_t)a.den * (uint128_t)((b.num < 0) ? -(uint64_t)b.num : (uint64_t)b.num);
+
+    return fit((b.num < 0) ? -num : num, den, result);
+}
+
+// Compare two rational numbers
+int omnia_rational_compare(const omnia_rational_t a, const omnia_rational_t b)
+{
+    const int128_t left = (int128_t)a.num * b.den;
+    const int128_t right = (int128_t)b.num * a.den;
+
+    return (left > right) - (left < right);
+}
+
+// Convert a rational number to floating-point
+double omnia_rational_to_double(const omnia_rational_t a)
+{
+    return (double)a.num / (double)a.den;
+}
+
+// Reduce each element of an array of rational numbers to lowest terms
+void omnia_rational_normalize_array(omnia_rational_t * a, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_RATIONAL_NORMALIZE_ARRAY, n);
+
+    for (size_t i = 0; i < n; ++i)
+        a[i] = omnia_rational_normalize(a[i]);
+}
+
+/*
+    Sums are accumulated over the least common multiple of the
+    denominators, with a 128-bit numerator, so that no reduction is
+    needed until the end. Repeated denominators, the usual case, skip the
+    GCD. Only when the common denominator would outgrow 64 bits is the
+    running total reduced, in case the terms so far cancel.
+*/
+
+// Sum an array of rational numbers
+bool omnia_rational_sum(const omnia_rational_t * a, const size_t n, omnia_rational_t * result)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_RATIONAL_SUM, n);
+
+    int128_t num = 0;
+    uint64_t den = 1;
+
+    if ((a == NULL) || (result == NULL))
+        return false;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint64_t d = (uint64_t)a[i].den;
+        int128_t term = a[i].num;
+
+        if (d != den)
+        {
+            uint64_t g = omnia_gcf(den, d);
+            uint128_t common = (uint128_t)(den / g) * d;
+
+            if (common > INT64_MAX)
+            {
+                // reduce the running total and try again
+                const uint128_t mag = (num < 0) ? -(uint128_t)num : (uint128_t)num;
+                const uint64_t r = (uint64_t)gcd128(mag, den);
+
+                num /= r;
+                den /= r;
+                g = omnia_gcf(den, d);
+                common = (uint128_t)(den / g) * d;
+
+                if (common > INT64_MAX)
+                    return false;
+            }
+
+            // scale the total and the new term to the common denominator
+            if (__builtin_mul_overflow(num, (int128_t)(d / g), &num))
+                return false;
+
+            term *= (int128_t)(den / g);
+            den = (uint64_t)common;
+        }
+
+        if (__builtin_add_overflow(num, term, &num))
+            return false;
+    }
+
+    return fit(num, den, result);
+}
@@ -15,41 +15,10 @@
     License), the text of which is available at the website above. 
 */
 
-#include "omnia.h"
-
-//  Rounds a value to nearest integer, rounding to even for exact fractions of 0.5.
-double omnia_round_nearest(const double x)
-{
-    double result, fraction, dummy;
-
-    fraction = fabs(modf(x,&result));
-
-    if (fraction == 0.0)
-        return result;
-
-    if (fraction == 0.5)
-    {
-        if (modf(result / 2.0, &dummy) != 0.0)
-        {
-            if (x < 0.0)
-                result -= 1.0;
-            else
-                result += 1.0;
-        }
-    }
-    else
-    {
-        if (fraction > 0.5)
-        {
-            if (x < 0.0)
-                result -= 1.0;
-            else
-                result += 1.0;
-        }
-    }
-
-    return result;
-}
+#include "omnia_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 
 //  Returns the given value rounded for the number of specified decimal digits of precision.
 double omnia_sigdig(const double x, const uint16_t n)
@@ -71,3 +40,196 @@ double omnia_sigdig(const double x, const uint16_t n)
 
     return result;
 }
+
+/*
+    Array forms. Adding and subtracting 2^52 rounds any smaller magnitude
+    to an integer in the current rounding mode, which by default is
+    round-half-even, the same rule used by omnia_round_nearest. Unlike
+    modf and its branches, this vectorizes into plain SSE2/AVX adds.
+
+    Magnitudes are compared and the sign restored with integer masks;
+    a floating-point compare would keep GCC from vectorizing the loop
+    unless -fno-trapping-math were given.
+*/
+
+#define TWO52 4503599627370496.0
+#define TWO52_BITS 0x4330000000000000ULL
+#define SIGN_BIT 0x8000000000000000ULL
+
+static inline double round_even(const double x)
+{
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+    uint64_t xbits, abits, rbits;
+    double a, r;
+
+    memcpy(&xbits, &x, sizeof(xbits));
+    abits = xbits & ~SIGN_BIT;
+    memcpy(&a, &abits, sizeof(a));
+
+    r = (a + TWO52) - TWO52;
+    memcpy(&rbits, &r, sizeof(rbits));
+    rbits |= xbits & SIGN_BIT;
+
+    // all ones below 2^52; larger values are already integers (or not finite)
+    const uint64_t mask = (uint64_t)((int64_t)(abits - TWO52_BITS) >> 63);
+    rbits = (rbits & mask) | (xbits & ~mask);
+    memcpy(&r, &rbits, sizeof(r));
+
+    return r;
+#else
+    // excess precision in registers defeats the 2^52 trick
+    return rint(x);
+#endif
+}
+
+// Round each element of an array to the nearest integer
+void omnia_round_nearest_array(const double * x, double * result, const size_t n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_ROUND_NEAREST_ARRAY, n);
+
+    for (size_t i = 0; i < n; ++i)
+        result[i] = round_even(x[i]);
+}
+
+/*
+    omnia_sigdig needs floor(log10(|x|)) and a power of ten for every
+    value. The array form derives the decimal exponent from the binary
+    exponent and a table of powers of ten, and takes the scale factor
+    from the same table. Table entries are computed with pow(), exactly
+    as the scalar function computes its scale factor.
+
+    Values within a few ULPs of a power of ten, where log10 itself may
+    round across an integer, are handed to omnia_sigdig so that results
+    are always identical to the scalar function; so are zero, subnormal
+    and non-finite values.
+*/
+
+#define POW10_MIN (-330)
+#define POW10_MAX 330
+
+static double pow10_table[POW10_MAX - POW10_MIN + 1];
+static pthread_once_t pow10_once = PTHREAD_ONCE_INIT;
+
+static void pow10_fill(void)
+{
+    for (int k = POW10_MIN; k <= POW10_MAX; ++k)
+        pow10_table[k - POW10_MIN] = pow(10.0, (double)k);
+}
+
+// the array functions run on worker threads, so the table is filled exactly once
+static const double * pow10_init(void)
+{
+    pthread_once(&pow10_once, pow10_fill);
+    return pow10_table - POW10_MIN;
+}
+
+// decimal exponent of a normal, positive value; sets *exact to false near a power of ten
+static inline int decimal_exponent(const double a, const double * p10, bool * exact)
+{
+    uint64_t bits;
+    memcpy(&bits, &a, sizeof(bits));
+
+    // floor(e2 * log10(2)) is either the decimal exponent or one less
+    const int e2 = (int)(bits >> 52) - 1023;
+    int e10 = (e2 * 78913) >> 18;
+
+    if (a >= p10[e10 + 1])
+        ++e10;
+
+    // log10 has an absolute error of a few ULPs of its result
+    const double margin = 1.0 + (double)(abs(e10) + 2) * 16.0 * DBL_EPSILON;
+    *exact = (a * margin < p10[e10 + 1]) && (a > p10[e10] * margin);
+
+    return e10;
+}
+
+// Decimal exponent of a value
+int omnia_decimal_exponent(const double x)
+{
+    const double a = fabs(x);
+    uint64_t bits;
+    int e2;
+
+    // zero, infinities and NaN
+    if (!((a > 0.0) && (a <= DBL_MAX)))
+        return 0;
+
+    memcpy(&bits, &a, sizeof(bits));
+
+    if (a >= DBL_MIN)
+        e2 = (int)(bits >> 52) - 1023;
+    else
+        e2 = (63 - __builtin_clzll(bits)) - 1074;
+
+    const double * p10 = pow10_init();
+    int e10 = (e2 * 78913) >> 18;
+
+    if (a >= p10[e10 + 1])
+        ++e10;
+
+    return e10;
+}
+
+#define SIGDIG_BLOCK 256
+
+// Round each element of an array to a number of significant digits
+void omnia_sigdig_array(const double * x, double * result, const size_t n, const uint16_t digits)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_SIGDIG_ARRAY, n);
+
+    double scale[SIGDIG_BLOCK];
+    double fixed[SIGDIG_BLOCK];
+    bool slow[SIGDIG_BLOCK];
+
+    if ((digits == 0) || (digits > DBL_DIG))
+    {
+        if (result != x)
+            memmove(result, x, sizeof(double) * n);
+
+        return;
+    }
+
+    const double * p10 = pow10_init();
+
+    for (size_t base = 0; base < n; base += SIGDIG_BLOCK)
+    {
+        const size_t count = (n - base < SIGDIG_BLOCK) ? n - base : SIGDIG_BLOCK;
+        const double * xb = x + base;
+        double * rb = result + base;
+        size_t fallback = 0;
+
+        // exponents need integer work and a table lookup per element
+        for (size_t i = 0; i < count; ++i)
+        {
+            const double a = fabs(xb[i]);
+            bool exact = false;
+
+            if ((a >= DBL_MIN) && (a <= DBL_MAX))
+            {
+                const int e10 = decimal_exponent(a, p10, &exact);
+                scale[i] = p10[(int)digits - 1 - e10];
+            }
+
+            slow[i] = !exact;
+
+            // computed now, since result may be the same array as x
+            if (!exact)
+            {
+                scale[i] = 1.0;
+                fixed[i] = omnia_sigdig(xb[i], digits);
+                ++fallback;
+            }
+        }
+
+        // scale, round and unscale in a vectorizable loop
+        for (size_t i = 0; i < count; ++i)
+            rb[i] = round_even(xb[i] * scale[i]) / scale[i];
+
+        if (fallback > 0)
+        {
+            for (size_t i = 0; i < count; ++i)
+                if (slow[i])
+                    rb[i] = fixed[i];
+        }
+    }
+}
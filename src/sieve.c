@@ -0,0 +1,511 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/*
+    A segmented Sieve of Eratosthenes over odd numbers only, one bit per
+    odd number: bit i stands for 2i + 1.
+
+    The range is cut into chunks of several segments. Each segment is
+    the size of a typical L1 data cache, and is sieved completely before
+    moving to the next, so the crossing-off loops never leave the cache.
+    A chunk is the unit of work for a thread; it keeps the position of
+    the next multiple of every sieving prime from one segment to the
+    next, so only the first segment of a chunk pays for divisions.
+
+    Multiples of 3, 5, 7, 11 and 13 are not crossed off one by one;
+    instead, each segment starts as a copy of a precomputed pattern in
+    which they are already cleared. The pattern repeats every
+    3 * 5 * 7 * 11 * 13 = 15015 words.
+
+    Threads sieve chunks in parallel, but hand them to the callback
+    strictly in order, so the callback sees one ascending stream of
+    primes.
+*/
+
+// 64-bit words per segment (32 KiB)
+#define SEGMENT_WORDS 4096
+
+// segments per chunk
+#define CHUNK_SEGMENTS 16
+
+// words per chunk
+#define CHUNK_WORDS (SEGMENT_WORDS * CHUNK_SEGMENTS)
+
+// product of the primes in the pre-sieve pattern
+#define WHEEL_PERIOD 15015
+
+// first prime not in the pre-sieve pattern
+#define FIRST_SIEVING_PRIME 17
+
+// primes delivered per callback
+#define BATCH_SIZE 1024
+
+// state shared by the threads of one sieve
+typedef struct
+{
+    uint64_t   first_bit;   // bit for the first odd number in the range
+    uint64_t   last_bit;    // bit for the last odd number in the range
+    uint64_t   nchunks;     // number of chunks in the range
+    uint64_t   start;       // smallest value requested
+    uint64_t   limit;       // largest value requested
+
+    const uint32_t * primes;    // sieving primes, starting at 17
+    size_t     nprimes;         // number of sieving primes
+    const uint64_t * wheel;     // pre-sieve pattern
+
+    omnia_prime_callback_t callback;    // receives primes, or NULL to count
+    void *     data;                    // passed to callback
+
+    pthread_mutex_t work_lock;  // protects next_chunk and count
+    uint64_t   next_chunk;      // next chunk to be sieved
+    uint64_t   count;           // primes counted
+
+    pthread_mutex_t turn_lock;  // protects next_delivery, and serializes writes to stop
+    pthread_cond_t  turn;       // signalled when a chunk has been delivered
+    uint64_t   next_delivery;   // next chunk to be delivered
+    bool       stop;            // set when the callback asks to stop; read atomically outside turn_lock
+}
+sieve_t;
+
+// odd primes up to n, as 32-bit values
+static uint32_t * base_primes(const uint32_t n, size_t * count)
+{
+    const size_t nbits = n / 2 + 1;
+    uint8_t * composite = (uint8_t *)calloc(nbits, 1);
+    uint32_t * primes = NULL;
+    size_t k = 0;
+
+    if (composite == NULL)
+        return NULL;
+
+    for (uint64_t i = 1; 2 * i * (i + 1) < nbits; ++i)
+    {
+        if (!composite[i])
+        {
+            for (uint64_t j = 2 * i * (i + 1); j < nbits; j += 2 * i + 1)
+                composite[j] = 1;
+        }
+    }
+
+    for (size_t i = 1; i < nbits; ++i)
+    {
+        if (!composite[i] && (2 * i + 1 <= n))
+            ++k;
+    }
+
+    primes = (uint32_t *)malloc(sizeof(uint32_t) * (k + 1));
+
+    if (primes != NULL)
+    {
+        k = 0;
+
+        for (size_t i = 1; i < nbits; ++i)
+        {
+            if (!composite[i] && (2 * i + 1 <= n))
+                primes[k++] = (uint32_t)(2 * i + 1);
+        }
+
+        *count = k;
+    }
+
+    free(composite);
+    return primes;
+}
+
+// integer square root
+static uint64_t isqrt(const uint64_t n)
+{
+    uint64_t r = (uint64_t)sqrt((double)n);
+
+    if (r > UINT32_MAX)
+        r = UINT32_MAX;
+
+    while (r * r > n)
+        --r;
+
+    while ((r < UINT32_MAX) && ((r + 1) * (r + 1) <= n))
+        ++r;
+
+    return r;
+}
+
+// pattern with the odd multiples of 3, 5, 7, 11 and 13 cleared
+static uint64_t * make_wheel(void)
+{
+    static const uint64_t wheel_primes[] = { 3, 5, 7, 11, 13 };
+    uint64_t * wheel = (uint64_t *)malloc(sizeof(uint64_t) * WHEEL_PERIOD);
+
+    if (wheel == NULL)
+        return NULL;
+
+    for (size_t w = 0; w < WHEEL_PERIOD; ++w)
+        wheel[w] = UINT64_MAX;
+
+    // bit i is 2i + 1, a multiple of p when i = (p - 1) / 2 mod p
+    for (size_t k = 0; k < sizeof(wheel_primes) / sizeof(wheel_primes[0]); ++k)
+    {
+        const uint64_t p = wheel_primes[k];
+
+        for (uint64_t i = (p - 1) / 2; i < 64 * (uint64_t)WHEEL_PERIOD; i += p)
+            wheel[i >> 6] &= ~(UINT64_C(1) << (i & 63));
+    }
+
+    return wheel;
+}
+
+// fill a segment from the pre-sieve pattern; first_word is a global word index
+static void apply_wheel(const uint64_t * wheel, uint64_t * words, const uint64_t first_word, const size_t nwords)
+{
+    size_t phase = (size_t)(first_word % WHEEL_PERIOD);
+    size_t done = 0;
+
+    while (done < nwords)
+    {
+        size_t len = WHEEL_PERIOD - phase;
+
+        if (len > nwords - done)
+            len = nwords - done;
+
+        memcpy(words + done, wheel + phase, sizeof(uint64_t) * len);
+        done += len;
+        phase = 0;
+    }
+}
+
+// sieve one chunk into words; returns the number of valid words
+static size_t sieve_chunk(const sieve_t * s, const uint64_t chunk, uint64_t * words, uint64_t * next)
+{
+    const uint64_t chunk_word = s->first_bit / 64 + chunk * CHUNK_WORDS;
+    const uint64_t last_word = s->last_bit / 64;
+    const size_t nwords = (last_word - chunk_word + 1 < CHUNK_WORDS) ? (size_t)(last_word - chunk_word + 1) : CHUNK_WORDS;
+    const uint64_t chunk_bit = chunk_word * 64;
+    const uint64_t end_bit = chunk_bit + 64 * (uint64_t)nwords;
+
+    // largest requested value in this chunk, and the primes that can divide it
+    const uint64_t top = 2 * ((end_bit <= s->last_bit) ? end_bit - 1 : s->last_bit) + 1;
+    size_t nprimes = 0;
+
+    while ((nprimes < s->nprimes) && ((uint64_t)s->primes[nprimes] * s->primes[nprimes] <= top))
+        ++nprimes;
+
+    // first odd multiple of each prime within the chunk, starting no lower than p^2
+    for (size_t j = 0; j < nprimes; ++j)
+    {
+        const uint64_t p = s->primes[j];
+        const uint64_t low = 2 * chunk_bit + 1;
+        uint64_t m = (p * p >= low) ? p * p : low + (p - low % p) % p;
+
+        if ((m & 1) == 0)
+            m += p;
+
+        // a multiple beyond 2^64 cannot be in range
+        next[j] = (m >= low) ? (m - 1) / 2 : UINT64_MAX;
+    }
+
+    // sieve one cache-sized segment at a time
+    for (size_t seg = 0; seg < nwords; seg += SEGMENT_WORDS)
+    {
+        const size_t seg_words = (nwords - seg < SEGMENT_WORDS) ? nwords - seg : SEGMENT_WORDS;
+        uint64_t * w = words + seg;
+        const uint64_t seg_bit = chunk_bit + 64 * (uint64_t)seg;
+        const uint64_t seg_end = seg_bit + 64 * (uint64_t)seg_words;
+
+        apply_wheel(s->wheel, w, chunk_word + seg, seg_words);
+
+        for (size_t j = 0; j < nprimes; ++j)
+        {
+            const uint64_t p = s->primes[j];
+            uint64_t i = next[j];
+
+            for (; i < seg_end; i += p)
+            {
+                const uint64_t b = i - seg_bit;
+                w[b >> 6] &= ~(UINT64_C(1) << (b & 63));
+            }
+
+            next[j] = i;
+        }
+    }
+
+    // 1 is not prime; 3 through 13 were cleared by the pattern
+    if (chunk_bit == 0)
+        words[0] &= ~UINT64_C(1);
+
+    // discard bits outside the requested range
+    if (chunk == 0)
+        words[0] &= UINT64_MAX << (s->first_bit & 63);
+
+    if (end_bit > s->last_bit + 1)
+        words[nwords - 1] &= UINT64_MAX >> (end_bit - s->last_bit - 1);
+
+    return nwords;
+}
+
+// primes below the sieving primes that fall within the range
+static size_t wheel_primes_in_range(const sieve_t * s, uint64_t * batch)
+{
+    static const uint64_t small[] = { 2, 3, 5, 7, 11, 13 };
+    size_t k = 0;
+
+    for (size_t i = 0; i < sizeof(small) / sizeof(small[0]); ++i)
+    {
+        if ((small[i] >= s->start) && (small[i] <= s->limit))
+            batch[k++] = small[i];
+    }
+
+    return k;
+}
+
+// hand the primes in a sieved chunk to the callback; false to stop
+static bool deliver(sieve_t * s, const uint64_t chunk, const uint64_t * words, const size_t nwords, uint64_t * batch)
+{
+    const uint64_t chunk_bit = (s->first_bit / 64 + chunk * CHUNK_WORDS) * 64;
+    size_t k = 0;
+
+    if (chunk == 0)
+        k = wheel_primes_in_range(s, batch);
+
+    for (size_t w = 0; w < nwords; ++w)
+    {
+        uint64_t bits = words[w];
+
+        while (bits != 0)
+        {
+            batch[k++] = 2 * (chunk_bit + 64 * (uint64_t)w + (uint64_t)omnia_ctz_u64(bits)) + 1;
+            bits &= bits - 1;
+
+            if (k == BATCH_SIZE)
+            {
+                if (!s->callback(batch, k, s->data))
+                    return false;
+
+                k = 0;
+            }
+        }
+    }
+
+    if (k > 0)
+        return s->callback(batch, k, s->data);
+
+    return true;
+}
+
+// thread body: sieve chunks until none remain
+static void * worker(void * arg)
+{
+    sieve_t * s = (sieve_t *)arg;
+    uint64_t * words = (uint64_t *)malloc(sizeof(uint64_t) * CHUNK_WORDS);
+    uint64_t * next = (uint64_t *)malloc(sizeof(uint64_t) * (s->nprimes + 1));
+    uint64_t * batch = (uint64_t *)malloc(sizeof(uint64_t) * BATCH_SIZE);
+    uint64_t count = 0;
+
+    if ((words == NULL) || (next == NULL) || (batch == NULL))
+    {
+        free(words);
+        free(next);
+        free(batch);
+        return NULL;
+    }
+
+    for (;;)
+    {
+        pthread_mutex_lock(&s->work_lock);
+
+        const uint64_t chunk = s->next_chunk;
+        const bool done = __atomic_load_n(&s->stop, __ATOMIC_RELAXED) || (chunk >= s->nchunks);
+
+        if (!done)
+            ++s->next_chunk;
+
+        pthread_mutex_unlock(&s->work_lock);
+
+        if (done)
+            break;
+
+        const size_t nwords = sieve_chunk(s, chunk, words, next);
+
+        if (s->callback == NULL)
+        {
+            for (size_t w = 0; w < nwords; ++w)
+                count += omnia_popcount_u64(words[w]);
+
+            continue;
+        }
+
+        // wait for the chunks before this one to be delivered
+        pthread_mutex_lock(&s->turn_lock);
+
+        while (s->next_delivery != chunk)
+            pthread_cond_wait(&s->turn, &s->turn_lock);
+
+        if (!__atomic_load_n(&s->stop, __ATOMIC_RELAXED) && !deliver(s, chunk, words, nwords, batch))
+            __atomic_store_n(&s->stop, true, __ATOMIC_RELAXED);
+
+        ++s->next_delivery;
+        pthread_cond_broadcast(&s->turn);
+        pthread_mutex_unlock(&s->turn_lock);
+    }
+
+    pthread_mutex_lock(&s->work_lock);
+    s->count += count;
+    pthread_mutex_unlock(&s->work_lock);
+
+    free(words);
+    free(next);
+    free(batch);
+    return NULL;
+}
+
+// run a sieve over [start, limit]
+static bool run_sieve(const uint64_t start, const uint64_t limit, omnia_prime_callback_t callback, void * data, size_t threads, uint64_t * count)
+{
+    sieve_t s;
+
+    *count = 0;
+
+    if (limit < start)
+        return true;
+
+    // the wheel primes, and 2, are not in the bit array
+    if (limit < FIRST_SIEVING_PRIME)
+    {
+        uint64_t batch[6];
+
+        s.start = start;
+        s.limit = limit;
+
+        const size_t k = wheel_primes_in_range(&s, batch);
+
+        if ((callback != NULL) && (k > 0))
+            callback(batch, k, data);
+
+        *count = k;
+        return true;
+    }
+
+    s.start = start;
+    s.limit = limit;
+    s.first_bit = start / 2;
+    s.last_bit = (limit - 1) / 2;
+    s.nchunks = (s.last_bit / 64 - s.first_bit / 64) / CHUNK_WORDS + 1;
+    s.callback = callback;
+    s.data = data;
+    s.next_chunk = 0;
+    s.next_delivery = 0;
+    s.count = 0;
+    s.stop = false;
+
+    // sieving primes from 17 to sqrt(limit)
+    size_t nbase = 0;
+    uint32_t * primes = base_primes((uint32_t)isqrt(limit), &nbase);
+    uint64_t * wheel = make_wheel();
+
+    if ((primes == NULL) || (wheel == NULL))
+    {
+        free(primes);
+        free(wheel);
+        return false;
+    }
+
+    size_t skip = 0;
+
+    while ((skip < nbase) && (primes[skip] < FIRST_SIEVING_PRIME))
+        ++skip;
+
+    s.primes = primes + skip;
+    s.nprimes = nbase - skip;
+    s.wheel = wheel;
+
+    if (threads == 0)
+        threads = omnia_get_threads();
+
+    if (threads > s.nchunks)
+        threads = (size_t)s.nchunks;
+
+    pthread_mutex_init(&s.work_lock, NULL);
+    pthread_mutex_init(&s.turn_lock, NULL);
+    pthread_cond_init(&s.turn, NULL);
+
+    // the calling thread is one of the workers
+    pthread_t * ids = (pthread_t *)malloc(sizeof(pthread_t) * threads);
+    size_t started = 0;
+
+    if (ids != NULL)
+    {
+        for (size_t t = 1; t < threads; ++t)
+        {
+            if (pthread_create(&ids[started], NULL, worker, &s) != 0)
+                break;
+
+            ++started;
+        }
+    }
+
+    worker(&s);
+
+    for (size_t t = 0; t < started; ++t)
+        pthread_join(ids[t], NULL);
+
+    // a worker that cannot allocate its buffers takes no chunks; the
+    // sieve fails only if every worker did
+    const bool result = s.stop || (s.next_chunk >= s.nchunks);
+
+    pthread_cond_destroy(&s.turn);
+    pthread_mutex_destroy(&s.turn_lock);
+    pthread_mutex_destroy(&s.work_lock);
+
+    free(ids);
+    free(primes);
+    free(wheel);
+
+    if (callback == NULL)
+    {
+        uint64_t small[6];
+        *count = s.count + wheel_primes_in_range(&s, small);
+    }
+
+    return result;
+}
+
+// Stream the primes in a range
+bool omnia_sieve_primes(const uint64_t start, const uint64_t limit, omnia_prime_callback_t callback, void * data, const size_t threads)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_SIEVE_PRIMES, (limit >= start) ? limit - start + 1 : 0);
+
+    uint64_t count;
+
+    if (callback == NULL)
+        return false;
+
+    return run_sieve(start, limit, callback, data, threads, &count);
+}
+
+// Count the primes up to a limit
+uint64_t omnia_prime_count(const uint64_t limit, const size_t threads)
+{
+    uint64_t count = 0;
+
+    if (!run_sieve(0, limit, NULL, NULL, threads, &count))
+        return 0;
+
+    return count;
+}
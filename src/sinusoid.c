@@ -15,58 +15,171 @@
     License), the text of which is available at the website above. 
 */
 
-#include "omnia.h"
+#include "omnia_internal.h"
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <stdint.h>
 
+// samples generated per pass over the factors
+#define SINUSOID_BLOCK 256
+
+// a signal being generated
+typedef struct
+{
+    const omnia_wave_factor_t * factors;
+    size_t factor_n;
+    double * result;
+}
+sinusoid_job_t;
+
+// generate the samples [begin, end)
+static void sinusoid_range(const size_t begin, const size_t end, void * data)
+{
+    const sinusoid_job_t * job = (const sinusoid_job_t *)data;
+    double phase[SINUSOID_BLOCK];
+
+    memset(job->result + begin, 0, sizeof(double) * (end - begin));
+
+    // phases are computed from the sample index, not accumulated, and the sines taken a block at a time
+    for (size_t i = begin; i < end; i += SINUSOID_BLOCK)
+    {
+        const size_t len = (end - i < SINUSOID_BLOCK) ? end - i : SINUSOID_BLOCK;
+
+        for (size_t n = 0; n < job->factor_n; ++n)
+        {
+            const double f = OMNIA_PI / job->factors[n].wavelength;
+
+            for (size_t j = 0; j < len; ++j)
+                phase[j] = (double)(i + j) * f;
+
+            omnia_sin_array(phase, phase, len, OMNIA_ACCURACY_ULP);
+
+            for (size_t j = 0; j < len; ++j)
+                job->result[i + j] += phase[j] * job->factors[n].amplitude;
+        }
+    }
+}
+
+// Sine wave based signal generator, into a caller's buffer
+bool omnia_make_sinusoid_into(const omnia_wave_factor_t * factors, const size_t factor_n, double * result, const size_t array_n)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_MAKE_SINUSOID, array_n);
+
+    if ((array_n == 0) || (factor_n == 0) || (factors == NULL) || (result == NULL))
+        return false;
+
+    sinusoid_job_t job = { factors, factor_n, result };
+
+    // each sample is independent, so long signals are split across threads; more waves mean more work per sample
+    size_t grain = omnia_get_grain() / factor_n;
+
+    if (grain < SINUSOID_BLOCK)
+        grain = SINUSOID_BLOCK;
+
+    omnia_parallel_run(array_n, grain, sinusoid_range, &job);
+    return true;
+}
+
+// Sine wave based signal generator
 double * omnia_make_sinusoid(const omnia_wave_factor_t * factors, const size_t factor_n, const size_t array_n)
 {
     double * result = NULL;
 
     if ((array_n > 0) && (factor_n > 0) && (factors != NULL))
     {
-        result = (double *)malloc(sizeof(double) * array_n);
+        result = (double *)omnia_alloc(sizeof(double) * array_n);
 
         if (result != NULL)
-        {
-            double * f = (double *)malloc(sizeof(double) * factor_n);
-            double * a = (double *)malloc(sizeof(double) * factor_n);
-
-            for (int n = 0; n < factor_n; ++n)
-            {
-                f[n] = OMNIA_PI / factors[n].wavelength;
-                a[n] = 0.0;
-            }
-
-            for (size_t i = 0; i < array_n; ++i)
-            {
-                for (size_t n = 0; n < factor_n; ++n)
-                {
-                    result[i] += sin(a[n]) * factors[n].amplitude;
-                    a[n] += f[n];
-                }
-            }
-        }
+            omnia_make_sinusoid_into(factors, factor_n, result, array_n);
     }
 
     return result;
 }
 
+/*
+    Noise comes from a private xorshift+ generator, seeded from the clock
+    on first use. A long array is split into at most MAX_STREAMS chunks,
+    and each chunk draws from its own stream, 2^64 values after the
+    previous chunk's, so chunks can run on any thread without sharing a
+    generator. The next call starts beyond the last stream used.
+*/
+
+// most chunks, and so streams, for one call
+#define MAX_STREAMS 64
+
+static omnia_xs128p_t noise_state;
+static bool noise_seeded = false;
+
+// noise being added
+typedef struct
+{
+    double * a;
+    double noise;
+    size_t grain;
+    omnia_xs128p_t streams[MAX_STREAMS];
+}
+noise_job_t;
+
+// add noise to the elements [begin, end)
+static void noise_range(const size_t begin, const size_t end, void * data)
+{
+    noise_job_t * job = (noise_job_t *)data;
+    omnia_xs128p_t * g = &job->streams[begin / job->grain];
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        const double x = omnia_xs128p_real_r(g) * job->noise;
+
+        if (1 == omnia_xs128p_next_r(g) % 2)
+            job->a[i] += x;
+        else
+            job->a[i] -= x;
+    }
+}
+
 void omnia_add_noise(double * a, const size_t n, double noise)
 {
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_ADD_NOISE, n);
+
     if ((n > 0) && (a != NULL) && (noise > 0.0))
     {
-        omnia_kiss64_set_seed((uint64_t)time(NULL));
+        if (!noise_seeded)
+        {
+            const uint64_t now = (uint64_t)time(NULL);
+            const uint64_t seed[2] = { now ^ 0x9e3779b97f4a7c15ULL, now * 0xbf58476d1ce4e5b9ULL + 1 };
+
+            omnia_xs128p_seed_r(&noise_state, seed);
+            noise_seeded = true;
+        }
+
+        noise_job_t job;
+
+        job.a = a;
+        job.noise = noise;
+        job.grain = omnia_parallel_grain(n, MAX_STREAMS);
 
-        for (int i = 0; i < n; ++i)
+        const size_t chunks = (n - 1) / job.grain + 1;
+
+        // a single chunk continues the generator; more take a stream each
+        job.streams[0] = noise_state;
+
+        for (size_t i = 1; i < chunks; ++i)
         {
-            double x = omnia_kiss64_real() * noise;
+            job.streams[i] = job.streams[i - 1];
+            omnia_xs128p_jump_r(&job.streams[i]);
+        }
 
-            if (1 == omnia_kiss64_next() % 2)
-                a[i] += x;
-            else
-                a[i] -= x;
+        omnia_xs128p_t next = job.streams[chunks - 1];
+
+        omnia_parallel_run(n, job.grain, noise_range, &job);
+
+        if (chunks == 1)
+            noise_state = job.streams[0];
+        else
+        {
+            omnia_xs128p_jump_r(&next);
+            noise_state = next;
         }
     }
 }
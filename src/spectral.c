@@ -0,0 +1,158 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+
+/*
+    Goertzel filters evaluate single DFT terms. When many frequencies
+    are wanted, the recurrences are independent of each other; running
+    them side-by-side (frequency in the inner loop) lets the compiler
+    vectorize across frequencies while the data is read only once per
+    block. The block size keeps all filter state in L1 cache.
+*/
+
+#define GOERTZEL_BLOCK 64
+
+// Goertzel power for a set of target frequencies
+bool omnia_goertzel(const double * data, const size_t n, const double * frequencies, const size_t freq_n, double * power)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_GOERTZEL, n);
+
+    double coeff[GOERTZEL_BLOCK];
+    double s1[GOERTZEL_BLOCK];
+    double s2[GOERTZEL_BLOCK];
+
+    if ((data == NULL) || (frequencies == NULL) || (power == NULL))
+        return false;
+
+    for (size_t base = 0; base < freq_n; base += GOERTZEL_BLOCK)
+    {
+        size_t count = freq_n - base;
+
+        if (count > GOERTZEL_BLOCK)
+            count = GOERTZEL_BLOCK;
+
+        for (size_t k = 0; k < count; ++k)
+        {
+            coeff[k] = 2.0 * cos(2.0 * OMNIA_PI * frequencies[base + k]);
+            s1[k] = 0.0;
+            s2[k] = 0.0;
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const double x = data[i];
+
+            for (size_t k = 0; k < count; ++k)
+            {
+                const double s0 = x + coeff[k] * s1[k] - s2[k];
+                s2[k] = s1[k];
+                s1[k] = s0;
+            }
+        }
+
+        for (size_t k = 0; k < count; ++k)
+            power[base + k] = s1[k] * s1[k] + s2[k] * s2[k] - coeff[k] * s1[k] * s2[k];
+    }
+
+    return true;
+}
+
+// Estimate the amplitudes of the sine waves described by a set of wave factors
+bool omnia_goertzel_waves(const double * data, const size_t n, const omnia_wave_factor_t * factors, const size_t factor_n, double * amplitudes)
+{
+    double freq[GOERTZEL_BLOCK];
+    double power[GOERTZEL_BLOCK];
+
+    if ((data == NULL) || (factors == NULL) || (amplitudes == NULL) || (n == 0))
+        return false;
+
+    for (size_t base = 0; base < factor_n; base += GOERTZEL_BLOCK)
+    {
+        size_t count = factor_n - base;
+
+        if (count > GOERTZEL_BLOCK)
+            count = GOERTZEL_BLOCK;
+
+        // omnia_make_sinusoid advances the phase by pi / wavelength per sample
+        for (size_t k = 0; k < count; ++k)
+            freq[k] = 0.5 / factors[base + k].wavelength;
+
+        omnia_goertzel(data, n, freq, count, power);
+
+        for (size_t k = 0; k < count; ++k)
+            amplitudes[base + k] = 2.0 * sqrt(fabs(power[k])) / (double)n;
+    }
+
+    return true;
+}
+
+// Find the largest peaks in a magnitude spectrum
+size_t omnia_find_peaks(const double * magnitude, const size_t n, const double threshold, omnia_spectral_peak_t * peaks, const size_t max_peaks)
+{
+    size_t found = 0;
+
+    if ((magnitude == NULL) || (peaks == NULL) || (max_peaks == 0) || (n < 3))
+        return 0;
+
+    for (size_t i = 1; i < n - 1; ++i)
+    {
+        const double m = magnitude[i];
+
+        // a plateau reports its leftmost bin only
+        if ((m < threshold) || (m <= magnitude[i - 1]) || (m < magnitude[i + 1]))
+            continue;
+
+        // quadratic interpolation through the peak and its neighbors
+        omnia_spectral_peak_t peak;
+        const double a = magnitude[i - 1];
+        const double c = magnitude[i + 1];
+        const double d = a - 2.0 * m + c;
+
+        if (d < 0.0)
+        {
+            const double offset = 0.5 * (a - c) / d;
+            peak.bin = (double)i + offset;
+            peak.magnitude = m - 0.25 * (a - c) * offset;
+        }
+        else
+        {
+            peak.bin = (double)i;
+            peak.magnitude = m;
+        }
+
+        // insertion into the list, which is kept in descending order of magnitude
+        size_t j = found;
+
+        if (found < max_peaks)
+            ++found;
+        else if (peak.magnitude <= peaks[max_peaks - 1].magnitude)
+            continue;
+        else
+            j = max_peaks - 1;
+
+        while ((j > 0) && (peaks[j - 1].magnitude < peak.magnitude))
+        {
+            peaks[j] = peaks[j - 1];
+            --j;
+        }
+
+        peaks[j] = peak;
+    }
+
+    return found;
+}
@@ -15,53 +15,289 @@
     License), the text of which is available at the website above. 
 */
 
-#include "omnia.h"
+#include "omnia_internal.h"
 #include <math.h>
 #include <stdlib.h>
 
-// Moving average
-double * omnia_moving_average(const double * data, const int n, const int distance)
+/*
+    Both functions split long arrays into chunks for omnia_parallel_run.
+    Each chunk of a moving average starts its own window, so chunks are
+    independent. The window slides with a compensated (Neumaier) running
+    sum, so that a large value leaving the window does not wipe out the
+    small ones that remain, and the sum is recomputed from scratch every
+    few windows so that what error there is cannot build up. Sums for the statistics are kept per chunk and added in
+    order, and the chunks depend only on the length and the grain, so
+    the result does not depend on the number of threads.
+*/
+
+// most chunks a statistics sum is split into
+#define MAX_PARTIALS 256
+
+// a moving average resums its window after this many window lengths of results
+#define RESUM_WINDOWS 8
+
+// a moving average in progress
+typedef struct
+{
+    const double * data;
+    size_t n;
+    size_t distance;
+    double * result;
+}
+average_job_t;
+
+// add v to the compensated sum (*sum + *error)
+static inline void neumaier_add(double * sum, double * error, const double v)
+{
+    const double t = *sum + v;
+
+    if (fabs(*sum) >= fabs(v))
+        *error += (*sum - t) + v;
+    else
+        *error += (v - t) + *sum;
+
+    *sum = t;
+}
+
+// moving average for results [begin, end)
+static void average_range(const size_t begin, const size_t end, void * data)
 {
-    double * result = (double *)malloc(sizeof(double) * n);
+    const average_job_t * job = (const average_job_t *)data;
+    const size_t n = job->n;
+    const size_t distance = job->distance;
+    const size_t interval = (distance < SIZE_MAX / (2 * RESUM_WINDOWS)) ? (2 * distance + 1) * RESUM_WINDOWS : SIZE_MAX;
 
-    int m = n - distance;
+    // the window [lo, hi) slides along with a running sum
+    size_t lo = 0;
+    size_t hi = 0;
+    double sum = 0.0;
+    double error = 0.0;
 
-    for (int i = 0; i < n; ++i)
+    for (size_t i = begin; i < end; ++i)
     {
-        double count = 0.0;
+        const size_t first = (i > distance) ? i - distance : 0;
+        const size_t last = (n - 1 - i > distance) ? i + distance + 1 : n;
 
-        for (int x = i - distance; x <= i + distance; ++x)
+        if ((i - begin) % interval == 0)
+        {
+            sum = 0.0;
+            error = 0.0;
+
+            for (lo = first, hi = first; hi < last; ++hi)
+                neumaier_add(&sum, &error, job->data[hi]);
+        }
+        else
         {
-            if ((x >= 0) && (x <= m))
-            {
-                result[i] += data[x];
-                count += 1.0;
-            }
+            while (hi < last)
+                neumaier_add(&sum, &error, job->data[hi++]);
+
+            while (lo < first)
+                neumaier_add(&sum, &error, -job->data[lo++]);
         }
 
-        result[i] /= count;
+        job->result[i] = (sum + error) / (double)(hi - lo);
+    }
+}
+
+// Moving average into a caller's buffer
+bool omnia_moving_average_into(const double * data, const size_t n, const size_t distance, double * result)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_MOVING_AVERAGE, n);
+
+    if ((data == NULL) || (result == NULL) || (n == 0))
+        return false;
+
+    average_job_t job = { data, n, distance, result };
+
+    // each chunk sums a window before its first result, so keep chunks well above the window size
+    size_t grain = omnia_get_grain();
+
+    if ((distance <= SIZE_MAX / 8) && (grain < distance * 8))
+        grain = distance * 8;
+
+    omnia_parallel_run(n, grain, average_range, &job);
+    return true;
+}
+
+// Moving average
+double * omnia_moving_average(const double * data, const int n, const int distance)
+{
+    if ((n <= 0) || (distance < 0))
+        return NULL;
+
+    double * result = (double *)omnia_alloc(sizeof(double) * n);
+
+    if ((result != NULL) && !omnia_moving_average_into(data, (size_t)n, (size_t)distance, result))
+    {
+        omnia_free(result);
+        result = NULL;
     }
 
     return result;
 }
 
-double * omnia_basic_stats(const double * a, size_t n)
+// sums for the basic statistics
+typedef struct
+{
+    const double * a;
+    double mean;
+    size_t grain;
+    double partial[MAX_PARTIALS];
+}
+stats_job_t;
+
+// sum of the elements [begin, end)
+static void sum_range(const size_t begin, const size_t end, void * data)
+{
+    stats_job_t * job = (stats_job_t *)data;
+    double sum = 0.0;
+
+    for (size_t i = begin; i < end; ++i)
+        sum += job->a[i];
+
+    job->partial[begin / job->grain] = sum;
+}
+
+// sum of the squared deviations of the elements [begin, end)
+static void deviation_range(const size_t begin, const size_t end, void * data)
+{
+    stats_job_t * job = (stats_job_t *)data;
+    const double mean = job->mean;
+    double sum = 0.0;
+
+    for (size_t i = begin; i < end; ++i)
+        sum += (job->a[i] - mean) * (job->a[i] - mean);
+
+    job->partial[begin / job->grain] = sum;
+}
+
+// add the partial sums in order
+static double total(const stats_job_t * job, const size_t n)
+{
+    const size_t chunks = (n - 1) / job->grain + 1;
+    double sum = 0.0;
+
+    for (size_t i = 0; i < chunks; ++i)
+        sum += job->partial[i];
+
+    return sum;
+}
+
+// Basic statistics into a caller's buffer
+bool omnia_basic_stats_into(const double * a, const size_t n, double result[3])
 {
-    int i;
-    double sum1 = 0.0, sum2 = 0.0;
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_BASIC_STATS, n);
+
+    if ((a == NULL) || (result == NULL) || (n == 0))
+        return false;
 
-    double * result = malloc(sizeof(double) * 3);
+    stats_job_t job;
 
-    for (i = 0; i < n; ++i)
-        sum1 += a[i];
+    job.a = a;
+    job.grain = omnia_parallel_grain(n, MAX_PARTIALS);
 
-    result[0] = sum1 / (double)n;
+    omnia_parallel_run(n, job.grain, sum_range, &job);
+    job.mean = total(&job, n) / (double)n;
 
-    for (i = 0; i < n; ++i)
-        sum2 = sum2 + pow(a[i] - result[0], 2);
+    omnia_parallel_run(n, job.grain, deviation_range, &job);
 
-    result[1] = sum2 / (double)n;
+    result[0] = job.mean;
+    result[1] = total(&job, n) / (double)n;
     result[2] = sqrt(result[1]);
 
+    return true;
+}
+
+// Basic statistics
+double * omnia_basic_stats(const double * a, size_t n)
+{
+    double * result = (double *)omnia_alloc(sizeof(double) * 3);
+
+    if ((result != NULL) && !omnia_basic_stats_into(a, n, result))
+    {
+        omnia_free(result);
+        result = NULL;
+    }
+
     return result;
-}
\ No newline at end of file
+}
+
+// Clear running statistics
+void omnia_running_stats_init(omnia_running_stats_t * stats)
+{
+    stats->count = 0;
+    stats->mean = 0.0;
+    stats->m2 = 0.0;
+}
+
+// Add a value to running statistics
+void omnia_running_stats_add(omnia_running_stats_t * stats, const double x)
+{
+    const double delta = x - stats->mean;
+
+    stats->count += 1;
+    stats->mean += delta / (double)stats->count;
+    stats->m2 += delta * (x - stats->mean);
+}
+
+// Add an array of values to running statistics
+void omnia_running_stats_add_array(omnia_running_stats_t * stats, const double * a, const size_t n)
+{
+    omnia_running_stats_t block;
+    double sum = 0.0;
+    double m2 = 0.0;
+
+    if (n == 0)
+        return;
+
+    for (size_t i = 0; i < n; ++i)
+        sum += a[i];
+
+    const double mean = sum / (double)n;
+
+    for (size_t i = 0; i < n; ++i)
+        m2 += (a[i] - mean) * (a[i] - mean);
+
+    block.count = n;
+    block.mean = mean;
+    block.m2 = m2;
+
+    omnia_running_stats_merge(stats, &block);
+}
+
+// Merge running statistics
+void omnia_running_stats_merge(omnia_running_stats_t * stats, const omnia_running_stats_t * other)
+{
+    if (other->count == 0)
+        return;
+
+    if (stats->count == 0)
+    {
+        *stats = *other;
+        return;
+    }
+
+    const double na = (double)stats->count;
+    const double nb = (double)other->count;
+    const double n = na + nb;
+    const double delta = other->mean - stats->mean;
+
+    stats->count += other->count;
+    stats->mean += delta * (nb / n);
+    stats->m2 += other->m2 + delta * delta * (na * nb / n);
+}
+
+// Sample variance of running statistics
+double omnia_running_stats_variance(const omnia_running_stats_t * stats)
+{
+    if (stats->count < 2)
+        return NAN;
+
+    return stats->m2 / (double)(stats->count - 1);
+}
+
+// Standard error of the mean of running statistics
+double omnia_running_stats_error(const omnia_running_stats_t * stats)
+{
+    return sqrt(omnia_running_stats_variance(stats) / (double)stats->count);
+}
@@ -17,20 +17,75 @@
 
 #include "omnia.h"
 
+/*
+    The inverse hyperbolic functions follow fdlibm. Each is written in
+    terms of log1p wherever its argument can be near zero, so no
+    precision is lost to cancellation; large arguments are handled
+    without squaring them, which would overflow. Results are within
+    2 ULP.
+*/
+
+// 2^28; beyond this, x^2 + 1 == x^2
+#define HUGE_ARG 268435456.0
+
+// 2^-28; below this, asinh and atanh equal their arguments
+#define TINY_ARG 3.725290298461914e-09
+
 // hyperbolic arcsine
 double omnia_asinh(const double x)
 {
-    return log(x + sqrt(x * x + 1.0));
+    const double a = fabs(x);
+    double result;
+
+    if (!isfinite(x) || (a < TINY_ARG))
+        return x;
+
+    if (a > HUGE_ARG)
+        result = log(a) + OMNIA_LN_2;
+    else if (a > 2.0)
+        result = log(2.0 * a + 1.0 / (sqrt(x * x + 1.0) + a));
+    else
+        result = log1p(a + x * x / (1.0 + sqrt(1.0 + x * x)));
+
+    return copysign(result, x);
 }
 
 //  hyperbolic arccosine 
 double omnia_acosh(const double x)
 {
-    return log(x + sqrt(x * x - 1.0));
+    if (!(x >= 1.0))
+        return NAN;
+
+    if (x > HUGE_ARG)
+        return isinf(x) ? x : log(x) + OMNIA_LN_2;
+
+    if (x > 2.0)
+        return log(2.0 * x - 1.0 / (x + sqrt(x * x - 1.0)));
+
+    // x - 1 is exact here
+    const double t = x - 1.0;
+    return log1p(t + sqrt(2.0 * t + t * t));
 }
 
 //  hyperbolic arctangent 
 double omnia_atanh(const double x)
 {
-    return log((1.0 + x) / (1.0 - x)) / 2.0;
+    const double a = fabs(x);
+    double result;
+
+    if (!(a <= 1.0))
+        return NAN;
+
+    if (a == 1.0)
+        return x / 0.0;
+
+    if (a < TINY_ARG)
+        return x;
+
+    if (a < 0.5)
+        result = 0.5 * log1p(2.0 * a + 2.0 * a * a / (1.0 - a));
+    else
+        result = 0.5 * log1p(2.0 * a / (1.0 - a));
+
+    return copysign(result, x);
 }
@@ -0,0 +1,788 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "omnia_internal.h"
+#include <string.h>
+
+/*
+    Array kernels for elementary functions. Calls into libm cannot be
+    vectorized, so these loops compute the functions inline, with no
+    branches and no table lookups; the compiler turns each loop into
+    SIMD code. Exponents and mantissas are separated with integer
+    operations on the bit patterns, using only logical shifts, which
+    every SIMD instruction set supports for 64-bit lanes; 64-bit
+    comparisons, which SSE2 lacks, are replaced with arithmetic.
+
+    Arguments the fast path does not handle (zero, negative, subnormal
+    and non-finite values for log) are flagged in the same pass; a block
+    that contains any is patched afterward with libm results. Work is
+    done in blocks small enough to stay in L1, which also lets results
+    overwrite their inputs. On x86-64 the kernels are also built for AVX2
+    with FMA, selected at load time.
+*/
+
+// elements per block
+#define BLOCK_SIZE 256
+
+#define SIGN_BIT        UINT64_C(0x8000000000000000)
+#define MANTISSA_MASK   UINT64_C(0x000fffffffffffff)
+#define MIN_NORMAL_BITS UINT64_C(0x0010000000000000)
+#define NORMAL_RANGE    UINT64_C(0x7fe0000000000000)
+#define SQRT_HALF_BITS  UINT64_C(0x3fe6a09e667f3bcd)
+#define TWO52_BITS      UINT64_C(0x4330000000000000)
+#define TWO52           4503599627370496.0
+
+// ln(2), split so that k * LN2_HI is exact
+#define LN2_HI 6.93147180369123816490e-01
+#define LN2_LO 1.90821492927058770002e-10
+
+// fdlibm's minimax coefficients for log(1 + f)
+#define LG1 6.666666666666735130e-01
+#define LG2 3.999999999940941908e-01
+#define LG3 2.857142874366239149e-01
+#define LG4 2.222219843214978396e-01
+#define LG5 1.818357216161805012e-01
+#define LG6 1.531383769920937332e-01
+#define LG7 1.479819860511658591e-01
+
+// bit pattern of a double
+static inline uint64_t to_bits(const double x)
+{
+    uint64_t result;
+    memcpy(&result, &x, sizeof(result));
+    return result;
+}
+
+// double from a bit pattern
+static inline double from_bits(const uint64_t x)
+{
+    double result;
+    memcpy(&result, &x, sizeof(result));
+    return result;
+}
+
+// all ones if the top bit is set, else zero
+static inline uint64_t top_mask(const uint64_t x)
+{
+    return 0 - (x >> 63);
+}
+
+// a where mask is set, otherwise b
+static inline double select_bits(const uint64_t mask, const double a, const double b)
+{
+    return from_bits((to_bits(a) & mask) | (to_bits(b) & ~mask));
+}
+
+/*
+    Logarithm: x = 2^k * m with m in [sqrt(2)/2, sqrt(2)), then, with
+    f = m - 1 and s = f / (2 + f),
+
+        log(m) = f - f^2/2 + s * (f^2/2 + R(s^2))
+
+    where R approximates 2s^2/3 + 2s^4/5 + ... The tiers differ only in
+    the number of terms of R.
+*/
+
+// split x into k and m; the top bit of the result is set if x is not a positive normal number
+OMNIA_KERNEL_INLINE uint64_t log_reduce(const double x, double * k, double * m)
+{
+    uint64_t ix, mbits, kbits;
+
+    memcpy(&ix, &x, sizeof(ix));
+
+    // offsetting by 2^63 keeps the shifted exponent non-negative: k + 2048
+    const uint64_t t = ix - SQRT_HALF_BITS;
+    mbits = (t & MANTISSA_MASK) + SQRT_HALF_BITS;
+    kbits = TWO52_BITS | ((t + SIGN_BIT) >> 52);
+
+    memcpy(m, &mbits, sizeof(*m));
+    memcpy(k, &kbits, sizeof(*k));
+    *k -= TWO52 + 2048.0;
+
+    // an unsigned a >= NORMAL_RANGE test, without a 64-bit compare
+    const uint64_t a = ix - MIN_NORMAL_BITS;
+
+    return (a + (SIGN_BIT - NORMAL_RANGE)) | a;
+}
+
+// log over one block, full accuracy; returns true if any element needs libm
+OMNIA_VECTOR_CLONES
+static bool log_block_ulp(const double * x, double * r, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double k, m;
+
+        special |= log_reduce(x[i], &k, &m);
+
+        const double f = m - 1.0;
+        const double s = f / (2.0 + f);
+        const double z = s * s;
+        const double w = z * z;
+        const double t1 = w * (LG2 + w * (LG4 + w * LG6));
+        const double t2 = z * (LG1 + w * (LG3 + w * (LG5 + w * LG7)));
+        const double hfsq = 0.5 * f * f;
+
+        r[i] = s * (hfsq + t1 + t2) + k * LN2_LO - hfsq + f + k * LN2_HI;
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// log over one block, relative error below 1e-7
+OMNIA_VECTOR_CLONES
+static bool log_block_1e7(const double * x, double * r, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double k, m;
+
+        special |= log_reduce(x[i], &k, &m);
+
+        const double f = m - 1.0;
+        const double s = f / (2.0 + f);
+        const double z = s * s;
+        const double hfsq = 0.5 * f * f;
+
+        r[i] = s * (hfsq + z * (LG1 + z * (LG2 + z * LG3))) - hfsq + f + k * OMNIA_LN_2;
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// log over one block, relative error below 1e-4
+OMNIA_VECTOR_CLONES
+static bool log_block_1e4(const double * x, double * r, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double k, m;
+
+        special |= log_reduce(x[i], &k, &m);
+
+        const double f = m - 1.0;
+        const double s = f / (2.0 + f);
+        const double z = s * s;
+        const double hfsq = 0.5 * f * f;
+
+        r[i] = s * (hfsq + z * (LG1 + z * LG2)) - hfsq + f + k * OMNIA_LN_2;
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// log over one block at the given accuracy; returns true if any element needs libm
+static bool log_block(const double * x, double * r, const size_t n, const omnia_accuracy_t accuracy)
+{
+    switch (accuracy)
+    {
+        case OMNIA_ACCURACY_1E4:
+            return log_block_1e4(x, r, n);
+        case OMNIA_ACCURACY_1E7:
+            return log_block_1e7(x, r, n);
+        default:
+            return log_block_ulp(x, r, n);
+    }
+}
+
+// Natural logarithm of each element of an array
+void omnia_log_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_LOG_ARRAY, n);
+
+    double block[BLOCK_SIZE];
+
+    for (size_t i = 0; i < n; i += BLOCK_SIZE)
+    {
+        const size_t len = (n - i < BLOCK_SIZE) ? n - i : BLOCK_SIZE;
+
+        if (log_block(x + i, block, len, accuracy))
+        {
+            for (size_t j = 0; j < len; ++j)
+            {
+                uint64_t ix;
+
+                memcpy(&ix, x + i + j, sizeof(ix));
+
+                if ((ix - MIN_NORMAL_BITS) >= NORMAL_RANGE)
+                    block[j] = log(x[i + j]);
+            }
+        }
+
+        memcpy(result + i, block, sizeof(double) * len);
+    }
+}
+
+/*
+    Inverse hyperbolic functions. Each is log1p(y) for some y, or for
+    large arguments log(x) + ln(2). The log1p is computed as the log of
+    u = 1 + y, rounded, plus a correction for the rounding,
+
+        log1p(y) = log(u) + e / u,   e = (1 + y) - u
+
+    where e is found exactly with a two-sum. The correction also folds in
+    the rounding error of y, where it is known; acosh carries y in double
+    double precision, since near one log1p(y) passes y's error through
+    unreduced. A setup pass
+    finds u, a scale and an offset for each element, choosing between
+    the formulas with bit masks; the log kernel runs on u; a final pass
+    combines log(u) * scale + offset and restores the sign. Elements the
+    setup pass flags (non-finite or out of domain) send their block to
+    the scalar functions.
+*/
+
+#define ONE_BITS  UINT64_C(0x3ff0000000000000)
+#define HALF_BITS UINT64_C(0x3fe0000000000000)
+#define INF_BITS  UINT64_C(0x7ff0000000000000)
+#define HUGE_BITS UINT64_C(0x41b0000000000000)
+
+// setup pass for an inverse hyperbolic function
+typedef bool (* hyper_setup_t)(const double * x, double * u, double * scale, double * offset, const size_t n);
+
+// scale and offset giving log1p(y + tail) from log(u), u = 1 + y, times factor
+OMNIA_KERNEL_INLINE void log1p_terms(const double y, const double tail, const double u, const double factor, double * scale, double * offset)
+{
+    // the rounding error in forming u, exactly (Knuth's two-sum)
+    const double b = u - y;
+    const double e = (1.0 - b) + (y - (u - b)) + tail;
+
+    *scale  = factor;
+    *offset = factor * e / u;
+}
+
+// sqrt(w + w_lo) as a double double; w must be finite and non-negative
+OMNIA_KERNEL_INLINE double sqrt_tail(const double w, const double w_lo, double * lo)
+{
+    const double s = sqrt(w);
+
+    // s = hi + md exactly, with hi holding 26 bits, so s^2 is the sum of
+    // exact products; masking, unlike Veltkamp's split, survives FMA contraction
+    const double hi = from_bits(to_bits(s) & UINT64_C(0xfffffffff8000000));
+    const double md = s - hi;
+    const double r = ((w - hi * hi) - 2.0 * hi * md) - md * md + w_lo;
+
+    // Newton's correction, zero when s is
+    *lo = select_bits(top_mask(to_bits(s) - 1), 0.0, r / (2.0 * s));
+    return s;
+}
+
+// setup pass for asinh
+OMNIA_VECTOR_CLONES
+static bool asinh_setup(const double * x, double * u, double * scale, double * offset, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint64_t ia = to_bits(x[i]) & ~SIGN_BIT;
+        const double a = from_bits(ia);
+
+        // non-finite, and a >= 2^28
+        special |= ~(ia - INF_BITS);
+        const uint64_t huge = ~top_mask(ia - HUGE_BITS);
+
+        const double y = a + a * a / (1.0 + sqrt(1.0 + a * a));
+        const double v = 1.0 + y;
+        double s, o;
+
+        log1p_terms(y, 0.0, v, 1.0, &s, &o);
+
+        u[i] = select_bits(huge, a, v);
+        scale[i] = select_bits(huge, 1.0, s);
+        offset[i] = select_bits(huge, OMNIA_LN_2, o);
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// setup pass for acosh
+OMNIA_VECTOR_CLONES
+static bool acosh_setup(const double * x, double * u, double * scale, double * offset, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint64_t ix = to_bits(x[i]);
+
+        // negative, below one, and non-finite
+        special |= ix | (ix - ONE_BITS) | ~(ix - INF_BITS);
+        const uint64_t huge = ~top_mask(ix - HUGE_BITS);
+
+        // y = t + sqrt(2t + t^2), with t = x - 1 exact; near one only the
+        // roundings of the sum and the square root matter
+        const double t = x[i] - 1.0;
+        const double tt = t * t;
+        const double w = 2.0 * t + tt;
+        const double b = w - tt;
+        const double w_lo = (2.0 * t - b) + (tt - (w - b));
+
+        double r_lo;
+        const double r = sqrt_tail(w, w_lo, &r_lo);
+        const double y = r + t;
+        const double y_lo = (r - y) + t + r_lo;
+        const double v = 1.0 + y;
+        double s, o;
+
+        log1p_terms(y, y_lo, v, 1.0, &s, &o);
+
+        u[i] = select_bits(huge, x[i], v);
+        scale[i] = select_bits(huge, 1.0, s);
+        offset[i] = select_bits(huge, OMNIA_LN_2, o);
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// setup pass for atanh
+OMNIA_VECTOR_CLONES
+static bool atanh_setup(const double * x, double * u, double * scale, double * offset, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint64_t ia = to_bits(x[i]) & ~SIGN_BIT;
+        const double a = from_bits(ia);
+
+        // |x| >= 1, including non-finite
+        special |= ~(ia - ONE_BITS);
+        const uint64_t small = top_mask(ia - HALF_BITS);
+
+        // 2a / (1 - a), rearranged below 1/2 where 1 - a is inexact
+        const double y = select_bits(small, 2.0 * a + 2.0 * a * a / (1.0 - a), 2.0 * a / (1.0 - a));
+
+        u[i] = 1.0 + y;
+        log1p_terms(y, 0.0, u[i], 0.5, scale + i, offset + i);
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// final pass: r = log(u) * scale + offset, with the sign of x if odd
+OMNIA_VECTOR_CLONES
+static void hyper_finish(const double * x, double * r, const double * scale, const double * offset, const size_t n, const uint64_t sign_mask)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double v = r[i] * scale[i] + offset[i];
+        r[i] = from_bits(to_bits(v) | (to_bits(x[i]) & sign_mask));
+    }
+}
+
+// drive the passes for an inverse hyperbolic function
+static void hyper_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy,
+                        hyper_setup_t setup, double (* scalar)(const double), const uint64_t sign_mask)
+{
+    double u[BLOCK_SIZE];
+    double scale[BLOCK_SIZE];
+    double offset[BLOCK_SIZE];
+
+    for (size_t i = 0; i < n; i += BLOCK_SIZE)
+    {
+        const size_t len = (n - i < BLOCK_SIZE) ? n - i : BLOCK_SIZE;
+
+        if (setup(x + i, u, scale, offset, len))
+        {
+            for (size_t j = 0; j < len; ++j)
+                u[j] = scalar(x[i + j]);
+        }
+        else
+        {
+            // every u is a normal number of at least one
+            log_block(u, u, len, accuracy);
+            hyper_finish(x + i, u, scale, offset, len, sign_mask);
+        }
+
+        memcpy(result + i, u, sizeof(double) * len);
+    }
+}
+
+// Hyperbolic arcsine of each element of an array
+void omnia_asinh_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_ASINH_ARRAY, n);
+
+    hyper_array(x, result, n, accuracy, asinh_setup, omnia_asinh, SIGN_BIT);
+}
+
+// Hyperbolic arccosine of each element of an array
+void omnia_acosh_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_ACOSH_ARRAY, n);
+
+    hyper_array(x, result, n, accuracy, acosh_setup, omnia_acosh, 0);
+}
+
+// Hyperbolic arctangent of each element of an array
+void omnia_atanh_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_ATANH_ARRAY, n);
+
+    hyper_array(x, result, n, accuracy, atanh_setup, omnia_atanh, SIGN_BIT);
+}
+
+/*
+    Exponential: x = k * ln(2) + r with |r| <= ln(2)/2, then, with
+    c = r - r^2 * P(r^2),
+
+        exp(r) = 1 + r + r * c / (2 - c)
+
+    where P approximates the expansion of r * (exp(r) + 1) / (exp(r) - 1),
+    as in fdlibm. k is found by rounding with a shifter constant, which
+    leaves it in the low bits of the sum; 2^k is assembled directly in
+    the exponent field. Arguments beyond +-708, where the result may
+    overflow or be subnormal, go to libm.
+*/
+
+#define SHIFTER      6755399441055744.0
+#define SHIFTER_BITS UINT64_C(0x4338000000000000)
+#define EXP_LIMIT    708.0
+#define INV_LN2      1.44269504088896338700e+00
+
+#define P1  1.66666666666666019037e-01
+#define P2 -2.77777777770155933842e-03
+#define P3  6.61375632143793436117e-05
+#define P4 -1.65339022054652515390e-06
+#define P5  4.13813679705723846039e-08
+
+// split x into hi - lo = r and 2^k; the top bit of the result is set if x is out of range
+OMNIA_KERNEL_INLINE uint64_t exp_reduce(const double x, double * hi, double * lo, double * scale)
+{
+    const double kd = x * INV_LN2 + SHIFTER;
+    const uint64_t k = to_bits(kd) - SHIFTER_BITS;
+    const double kf = kd - SHIFTER;
+
+    *hi = x - kf * LN2_HI;
+    *lo = kf * LN2_LO;
+    *scale = from_bits((k + 1023) << 52);
+
+    return ~((to_bits(x) & ~SIGN_BIT) - to_bits(EXP_LIMIT));
+}
+
+// exp over one block, full accuracy; returns true if any element needs libm
+OMNIA_VECTOR_CLONES
+static bool exp_block_ulp(const double * x, double * r, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double hi, lo, scale;
+
+        special |= exp_reduce(x[i], &hi, &lo, &scale);
+
+        const double y = hi - lo;
+        const double t = y * y;
+        const double c = y - t * (P1 + t * (P2 + t * (P3 + t * (P4 + t * P5))));
+
+        r[i] = (1.0 - ((lo - (y * c) / (2.0 - c)) - hi)) * scale;
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// exp over one block, relative error below 1e-7
+OMNIA_VECTOR_CLONES
+static bool exp_block_1e7(const double * x, double * r, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double hi, lo, scale;
+
+        special |= exp_reduce(x[i], &hi, &lo, &scale);
+
+        const double y = hi - lo;
+        const double t = y * y;
+        const double c = y - t * (P1 + t * P2);
+
+        r[i] = (1.0 + y + (y * c) / (2.0 - c)) * scale;
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// exp over one block, relative error below 1e-4
+OMNIA_VECTOR_CLONES
+static bool exp_block_1e4(const double * x, double * r, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double hi, lo, scale;
+
+        special |= exp_reduce(x[i], &hi, &lo, &scale);
+
+        const double y = hi - lo;
+        const double c = y - y * y * P1;
+
+        r[i] = (1.0 + y + (y * c) / (2.0 - c)) * scale;
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// Exponential of each element of an array
+void omnia_exp_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_EXP_ARRAY, n);
+
+    double block[BLOCK_SIZE];
+
+    for (size_t i = 0; i < n; i += BLOCK_SIZE)
+    {
+        const size_t len = (n - i < BLOCK_SIZE) ? n - i : BLOCK_SIZE;
+        bool special;
+
+        switch (accuracy)
+        {
+            case OMNIA_ACCURACY_1E4:
+                special = exp_block_1e4(x + i, block, len);
+                break;
+            case OMNIA_ACCURACY_1E7:
+                special = exp_block_1e7(x + i, block, len);
+                break;
+            default:
+                special = exp_block_ulp(x + i, block, len);
+                break;
+        }
+
+        if (special)
+        {
+            for (size_t j = 0; j < len; ++j)
+            {
+                if (!(fabs(x[i + j]) < EXP_LIMIT))
+                    block[j] = exp(x[i + j]);
+            }
+        }
+
+        memcpy(result + i, block, sizeof(double) * len);
+    }
+}
+
+/*
+    Sine and cosine: x = k * pi/2 + r with |r| <= pi/4, using fdlibm's
+    three-part pi/2 so that the reduction stays accurate for |x| below
+    2^20; larger and non-finite arguments go to libm. The low two bits
+    of k pick the quadrant, which swaps sin(r) and cos(r) and sets the
+    signs with bit operations. The polynomials are fdlibm's; the lower
+    tiers truncate them.
+*/
+
+#define TRIG_LIMIT  1048576.0
+#define TRIG_TINY   UINT64_C(0x3e40000000000000)
+#define INV_PIO2    6.36619772367581382433e-01
+#define PIO2_1      1.57079632673412561417e+00
+#define PIO2_2      6.07710050630396597660e-11
+#define PIO2_2T     2.02226624879595063154e-21
+
+#define S1 -1.66666666666666324348e-01
+#define S2  8.33333333332248946124e-03
+#define S3 -1.98412698298579493134e-04
+#define S4  2.75573137070700676789e-06
+#define S5 -2.50507602534068634195e-08
+#define S6  1.58969099521155010221e-10
+
+#define C1  4.16666666666666019037e-02
+#define C2 -1.38888888888741095749e-03
+#define C3  2.48015872894767294178e-05
+#define C4 -2.75573143513906633035e-07
+#define C5  2.08757232129817482790e-09
+#define C6 -1.13596475577881948265e-11
+
+// reduce x to r + lo and quadrant q; the top bit of the result is set if x is out of range
+OMNIA_KERNEL_INLINE uint64_t trig_reduce(const double x, double * r, double * lo, uint64_t * q)
+{
+    const double kd = x * INV_PIO2 + SHIFTER;
+    const double kf = kd - SHIFTER;
+
+    // both products are exact, as is the first difference
+    const double r1 = x - kf * PIO2_1;
+    const double w = kf * PIO2_2;
+
+    const double t = r1 - w;
+    const double tail = ((r1 - t) - w) - kf * PIO2_2T;
+
+    // renormalize, so that lo is below half an ULP of r
+    *r = t + tail;
+    *lo = tail - (*r - t);
+    *q = to_bits(kd);
+
+    return ~((to_bits(x) & ~SIGN_BIT) - to_bits(TRIG_LIMIT));
+}
+
+// place sin(r) and cos(r) in quadrant q; below 2^-27, sin(x) is x, which keeps the sign of zero
+OMNIA_KERNEL_INLINE void trig_quadrant(const double x, const double sr, const double cr, const uint64_t q, double * s, double * c)
+{
+    const uint64_t swap = 0 - (q & 1);
+    const uint64_t tiny = top_mask((to_bits(x) & ~SIGN_BIT) - TRIG_TINY);
+
+    *s = select_bits(tiny, x, from_bits(to_bits(select_bits(swap, cr, sr)) ^ ((q & 2) << 62)));
+    *c = from_bits(to_bits(select_bits(swap, sr, cr)) ^ (((q + 1) & 2) << 62));
+}
+
+// sine and cosine over one block, full accuracy
+OMNIA_VECTOR_CLONES
+static bool trig_block_ulp(const double * x, double * s, double * c, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double r, lo;
+        uint64_t q;
+
+        special |= trig_reduce(x[i], &r, &lo, &q);
+
+        const double z = r * r;
+        const double hz = 0.5 * z;
+        const double w = 1.0 - hz;
+
+        // sin(r + lo) = sin(r) + lo * cos(r), and likewise for cos
+        const double sr = r + (r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6))))) + lo * w);
+        const double cr = w + (((1.0 - w) - hz) + (z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6))))) - r * lo));
+
+        trig_quadrant(x[i], sr, cr, q, s + i, c + i);
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// sine and cosine over one block, absolute error below 1e-7
+OMNIA_VECTOR_CLONES
+static bool trig_block_1e7(const double * x, double * s, double * c, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double r, lo;
+        uint64_t q;
+
+        special |= trig_reduce(x[i], &r, &lo, &q);
+
+        const double y = r + lo;
+        const double z = y * y;
+        const double sr = y + y * z * (S1 + z * (S2 + z * (S3 + z * S4)));
+        const double cr = 1.0 - 0.5 * z + z * z * (C1 + z * (C2 + z * C3));
+
+        trig_quadrant(x[i], sr, cr, q, s + i, c + i);
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// sine and cosine over one block, absolute error below 1e-4
+OMNIA_VECTOR_CLONES
+static bool trig_block_1e4(const double * x, double * s, double * c, const size_t n)
+{
+    uint64_t special = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double r, lo;
+        uint64_t q;
+
+        special |= trig_reduce(x[i], &r, &lo, &q);
+
+        const double y = r + lo;
+        const double z = y * y;
+        const double sr = y + y * z * (S1 + z * S2);
+        const double cr = 1.0 - 0.5 * z + z * z * (C1 + z * C2);
+
+        trig_quadrant(x[i], sr, cr, q, s + i, c + i);
+    }
+
+    return (special & SIGN_BIT) != 0;
+}
+
+// sines and cosines, either of which may be NULL
+static void sincos_array(const double * x, double * sines, double * cosines, const size_t n, const omnia_accuracy_t accuracy)
+{
+    double sblock[BLOCK_SIZE];
+    double cblock[BLOCK_SIZE];
+
+    for (size_t i = 0; i < n; i += BLOCK_SIZE)
+    {
+        const size_t len = (n - i < BLOCK_SIZE) ? n - i : BLOCK_SIZE;
+        bool special;
+
+        switch (accuracy)
+        {
+            case OMNIA_ACCURACY_1E4:
+                special = trig_block_1e4(x + i, sblock, cblock, len);
+                break;
+            case OMNIA_ACCURACY_1E7:
+                special = trig_block_1e7(x + i, sblock, cblock, len);
+                break;
+            default:
+                special = trig_block_ulp(x + i, sblock, cblock, len);
+                break;
+        }
+
+        if (special)
+        {
+            for (size_t j = 0; j < len; ++j)
+            {
+                if (!(fabs(x[i + j]) < TRIG_LIMIT))
+                {
+                    sblock[j] = sin(x[i + j]);
+                    cblock[j] = cos(x[i + j]);
+                }
+            }
+        }
+
+        if (sines != NULL)
+            memcpy(sines + i, sblock, sizeof(double) * len);
+
+        if (cosines != NULL)
+            memcpy(cosines + i, cblock, sizeof(double) * len);
+    }
+}
+
+// Sine and cosine of each element of an array
+void omnia_sincos_array(const double * x, double * sines, double * cosines, const size_t n, const omnia_accuracy_t accuracy)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_SINCOS_ARRAY, n);
+
+    sincos_array(x, sines, cosines, n, accuracy);
+}
+
+// Sine of each element of an array
+void omnia_sin_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_SIN_ARRAY, n);
+
+    sincos_array(x, result, NULL, n, accuracy);
+}
+
+// Cosine of each element of an array
+void omnia_cos_array(const double * x, double * result, const size_t n, const omnia_accuracy_t accuracy)
+{
+    OMNIA_PROFILE_SCOPE(OMNIA_PROFILE_COS_ARRAY, n);
+
+    sincos_array(x, NULL, result, n, accuracy);
+}
@@ -0,0 +1,279 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define TEST_SIZE 1000000
+
+int test_distribution(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    static const double WEIGHTS[] = { 1.0, 2.0, 3.0, 4.0, 0.0, 10.0, 0.5, 0.0, 19.5 };
+    const size_t n = sizeof(WEIGHTS) / sizeof(WEIGHTS[0]);
+    const double total = 40.0;
+
+    omnia_alias_t * table = omnia_alias_create(WEIGHTS, n);
+    size_t * draws = (size_t *)malloc(sizeof(size_t) * TEST_SIZE);
+    size_t count[9] = { 0 };
+
+    if ((table == NULL) || (draws == NULL) || (omnia_alias_size(table) != n))
+    {
+        omnia_alias_free(table);
+        free(draws);
+        return 1;
+    }
+
+    omnia_xs128p_t state = { { 0x9e3779b97f4a7c15ULL, 0x0123456789abcdefULL } };
+    omnia_alias_fill_r(table, &state, draws, TEST_SIZE);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        ++count[draws[i]];
+
+    // each frequency within five standard deviations of its probability
+    for (size_t k = 0; k < n; ++k)
+    {
+        const double p = WEIGHTS[k] / total;
+        const double expected = p * TEST_SIZE;
+        const double sigma = sqrt(TEST_SIZE * p * (1.0 - p));
+
+        if (fabs((double)count[k] - expected) > 5.0 * sigma)
+            ++errcnt;
+
+        if (verbose)
+            printf("category %zu: %zu draws, expected %.0f\n", k, count[k], expected);
+    }
+
+    // zero weights are never drawn
+    if ((count[4] != 0) || (count[7] != 0))
+        ++errcnt;
+
+    omnia_alias_free(table);
+
+    // a single category
+    const double one = 3.0;
+    table = omnia_alias_create(&one, 1);
+
+    if ((table == NULL) || (omnia_alias_pick(table, 0) != 0) || (omnia_alias_pick(table, UINT64_MAX) != 0))
+        ++errcnt;
+
+    omnia_alias_free(table);
+    free(draws);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_large(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    const size_t n = 100000;
+    double * weights = (double *)malloc(sizeof(double) * n);
+    size_t * draws = (size_t *)malloc(sizeof(size_t) * TEST_SIZE);
+    double total = 0.0;
+    double mean = 0.0;
+
+    // weights rising linearly, so the mean category is about 2n/3
+    for (size_t i = 0; i < n; ++i)
+    {
+        weights[i] = (double)i;
+        total += weights[i];
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        mean += (double)i * weights[i] / total;
+
+    omnia_alias_t * table = omnia_alias_create(weights, n);
+
+    if (table == NULL)
+    {
+        free(weights);
+        free(draws);
+        return 1;
+    }
+
+    omnia_xs128p_t state = { { 12345, 67890 } };
+    omnia_alias_fill_r(table, &state, draws, TEST_SIZE);
+
+    double sum = 0.0;
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if (draws[i] == 0)
+            ++errcnt;
+
+        sum += (double)draws[i];
+    }
+
+    // the standard deviation of the category is about n / 4.2
+    const double sampled = sum / TEST_SIZE;
+
+    if (fabs(sampled - mean) > 5.0 * (n / 4.2) / sqrt((double)TEST_SIZE))
+        ++errcnt;
+
+    if (verbose)
+        printf("mean category %.1f, expected %.1f\n", sampled, mean);
+
+    omnia_alias_free(table);
+
+    // equal weights choose the column directly
+    for (size_t i = 0; i < n; ++i)
+        weights[i] = 1.0;
+
+    table = omnia_alias_create(weights, n);
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        const uint64_t r = omnia_xs128p_next_r(&state);
+        __extension__ const unsigned __int128 product = (unsigned __int128)r * n;
+
+        if (omnia_alias_pick(table, r) != (size_t)(product >> 64))
+            ++errcnt;
+    }
+
+    omnia_alias_free(table);
+    free(weights);
+    free(draws);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_forms(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    static const double WEIGHTS[] = { 5.0, 1.0, 0.25, 7.0, 3.0 };
+    omnia_alias_t * table = omnia_alias_create(WEIGHTS, 5);
+
+    size_t expected[1000];
+    size_t result[1000];
+    uint64_t random[1000];
+
+    // fill draws as sample does, from the library's generator
+    const uint64_t seed[2] = { 42, 4242 };
+
+    omnia_xs128p_set_seed(seed);
+
+    for (size_t i = 0; i < 1000; ++i)
+        expected[i] = omnia_alias_sample(table);
+
+    omnia_xs128p_set_seed(seed);
+    omnia_alias_fill(table, result, 300);
+    omnia_alias_fill(table, result + 300, 700);
+
+    if (memcmp(expected, result, sizeof(expected)) != 0)
+        ++errcnt;
+
+    // and from the same values given directly
+    omnia_xs128p_set_seed(seed);
+    omnia_xs128p_fill(random, 1000);
+    omnia_alias_map(table, random, result, 1000);
+
+    if (memcmp(expected, result, sizeof(expected)) != 0)
+        ++errcnt;
+
+    for (size_t i = 0; i < 1000; ++i)
+        if (omnia_alias_pick(table, random[i]) != expected[i])
+            ++errcnt;
+
+    // caller-owned generators
+    omnia_xs128p_t a = { { seed[0], seed[1] } };
+    omnia_xs128p_t b = a;
+
+    for (size_t i = 0; i < 1000; ++i)
+        expected[i] = omnia_alias_sample_r(table, &a);
+
+    omnia_alias_fill_r(table, &b, result, 1000);
+
+    if ((memcmp(expected, result, sizeof(expected)) != 0) || (a.s[0] != b.s[0]) || (a.s[1] != b.s[1]))
+        ++errcnt;
+
+    omnia_alias_free(table);
+
+    // a subnormal total weight; the zero weight is never drawn
+    static const double tiny[3] = { 4.9e-324, 0.0, 1.5e-323 };
+    table = omnia_alias_create(tiny, 3);
+
+    if (table == NULL)
+        ++errcnt;
+    else
+    {
+        size_t tiny_count[3] = { 0, 0, 0 };
+
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            const size_t k = omnia_alias_pick(table, random[i]);
+
+            if (k < 3)
+                ++tiny_count[k];
+            else
+                ++errcnt;
+        }
+
+        if ((tiny_count[1] != 0) || (tiny_count[0] == 0) || (tiny_count[2] <= tiny_count[0]))
+            ++errcnt;
+
+        omnia_alias_free(table);
+    }
+
+    // invalid weights
+    const double negative[2] = { 1.0, -1.0 };
+    const double zero[2] = { 0.0, 0.0 };
+    const double bad[2] = { NAN, INFINITY };
+
+    if ((omnia_alias_create(NULL, 2) != NULL) || (omnia_alias_create(WEIGHTS, 0) != NULL)
+    ||  (omnia_alias_create(negative, 2) != NULL) || (omnia_alias_create(zero, 2) != NULL)
+    ||  (omnia_alias_create(bad, 1) != NULL) || (omnia_alias_create(bad + 1, 1) != NULL))
+        ++errcnt;
+
+    if (verbose)
+        printf("forms: %d error(s)\n", (int)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_distribution(verbose);
+    errcnt += test_large(verbose);
+    errcnt += test_forms(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -0,0 +1,172 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// constant forms must be usable as array dimensions
+static const char table_bits[OMNIA_ILOG2_CONST(1000)] = { 0 };
+static const char table_size[OMNIA_NEXT_POW2_CONST(1000)] = { 0 };
+
+int test_logs(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+    unsigned int b, d;
+
+    // every power of two, and its neighbors
+    for (b = 0; b < 64; ++b)
+    {
+        const uint64_t p = UINT64_C(1) << b;
+
+        if ((omnia_ilog2_u64(p) != b) || (omnia_ilog2_u64(p + p - 1) != b))
+            ++errcnt;
+
+        if ((omnia_next_pow2_u64(p) != p) || (omnia_prev_pow2_u64(p) != p))
+            ++errcnt;
+
+        if ((b > 1) && ((omnia_next_pow2_u64(p - 1) != p) || (omnia_prev_pow2_u64(p + 1) != p)))
+            ++errcnt;
+
+        if (OMNIA_ILOG2_CONST(p) != b)
+            ++errcnt;
+
+        if ((b < 32) && ((omnia_ilog2_u32((uint32_t)p) != b) || (omnia_next_pow2_u32((uint32_t)p) != p)))
+            ++errcnt;
+    }
+
+    // every power of ten, and its neighbors
+    uint64_t p = 1;
+
+    for (d = 0; d < 20; ++d, p *= 10)
+    {
+        if ((omnia_ilog10_u64(p) != d) || ((d > 0) && (omnia_ilog10_u64(p - 1) != d - 1)))
+            ++errcnt;
+
+        if ((d < 10) && ((omnia_ilog10_u32((uint32_t)p) != d) || ((d > 0) && (omnia_ilog10_u32((uint32_t)p - 1) != d - 1))))
+            ++errcnt;
+    }
+
+    if ((omnia_ilog10_u64(UINT64_MAX) != 19) || (omnia_ilog10_u32(UINT32_MAX) != 9))
+        ++errcnt;
+
+    // edges
+    if ((omnia_ilog2_u64(0) != 0) || (omnia_ilog10_u64(0) != 0) || (omnia_next_pow2_u64(0) != 1) || (omnia_prev_pow2_u64(0) != 0))
+        ++errcnt;
+
+    if ((omnia_next_pow2_u64((UINT64_C(1) << 63) + 1) != 0) || (omnia_next_pow2_u32(UINT32_C(0x80000001)) != 0))
+        ++errcnt;
+
+    if ((sizeof(table_bits) != 9) || (sizeof(table_size) != 1024) || (OMNIA_PREV_POW2_CONST(1000) != 512))
+        ++errcnt;
+
+    if (verbose)
+        printf("ilog2, ilog10, next_pow2 and prev_pow2: %lu error(s)\n", (unsigned long)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_popcount(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 10000;
+
+    // counts errors
+    size_t i, errcnt = 0;
+
+    uint64_t seed[2] = { 14142, 13562 };
+    omnia_xs128p_set_seed(seed);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        const uint64_t x = omnia_xs128p_next();
+        unsigned int n = 0;
+
+        for (uint64_t y = x; y != 0; y >>= 1)
+            n += (unsigned int)(y & 1);
+
+        if ((omnia_popcount_u64(x) != n) || (omnia_popcount_size((size_t)x) != omnia_popcount_u64((size_t)x)))
+            ++errcnt;
+
+        if (omnia_popcount_u32((uint32_t)x) + omnia_popcount_u32((uint32_t)(x >> 32)) != n)
+            ++errcnt;
+    }
+
+    if (verbose)
+        printf("popcount: %lu error(s)\n", (unsigned long)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_sizepow2(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 7;
+
+    static const int test_set[] =
+    {
+        -5, 0, 1, 3, 1000, 1073741824, 1073741825
+    };
+
+    static const int expected[] =
+    {
+        0, 0, 1, 4, 1024, 1073741824, 0
+    };
+
+    // counts errors
+    size_t i, errcnt = 0;
+    int result;
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        result = omnia_sizepow2(test_set[i]);
+
+        if (verbose)
+            printf("sizepow2(%d) = %d (should be %d)\n", test_set[i], result, expected[i]);
+
+        if (result != expected[i])
+            ++errcnt;
+    }
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_logs(verbose);
+    errcnt += test_popcount(verbose);
+    errcnt += test_sizepow2(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
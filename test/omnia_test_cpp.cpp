@@ -0,0 +1,278 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#define TEST_SIZE 1000
+
+// seeding is usable in constant expressions
+static constexpr omnia::xs128p CONST_XS128P(1, 2);
+static constexpr omnia::kiss64 CONST_KISS64(42);
+static constexpr omnia::kiss32 CONST_KISS32(42);
+
+static_assert(omnia::xs128p::max() == UINT64_MAX, "xs128p range");
+static_assert(omnia::kiss32::max() == UINT32_MAX, "kiss32 range");
+
+int test_sequences(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    // each class matches its C generator, seeded alike
+    const uint64_t seed[2] = { 12345678901ULL, 98765432109ULL };
+
+    omnia::xs128p xs(seed[0], seed[1]);
+    omnia_xs128p_set_seed(seed);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if (xs() != omnia_xs128p_next())
+            ++errcnt;
+    }
+
+    xs.jump();
+    omnia_xs128p_jump();
+
+    if (xs() != omnia_xs128p_next())
+        ++errcnt;
+
+    omnia::kiss64 k64(seed[0]);
+    omnia_kiss64_set_seed(seed[0]);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if (k64() != omnia_kiss64_next())
+            ++errcnt;
+    }
+
+    omnia::kiss32 k32((uint32_t)seed[1]);
+    omnia_kiss32_set_seed((uint32_t)seed[1]);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if (k32() != omnia_kiss32_next())
+            ++errcnt;
+    }
+
+    // fill continues the sequence
+    omnia::xs128p a(CONST_XS128P);
+    omnia::xs128p b(CONST_XS128P);
+    std::vector<uint64_t> values(TEST_SIZE);
+
+    a.fill(values.data(), TEST_SIZE);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if (values[i] != b())
+            ++errcnt;
+    }
+
+    if ((a != b) || (a() != b()))
+        ++errcnt;
+
+    omnia::kiss64 c(CONST_KISS64);
+    c.discard(10);
+
+    omnia::kiss64 d(42);
+
+    for (int i = 0; i < 10; ++i)
+        d();
+
+    if (c != d)
+        ++errcnt;
+
+    if (verbose)
+        printf("sequences: %d error(s)\n", (int)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_caller_owned(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    // the newer classes match their _r functions, seeded alike
+    omnia::xoshiro256ss ss(2016);
+    omnia::xoshiro256pp pp(2016);
+    omnia_xoshiro256_t xss, xpp;
+
+    omnia_xoshiro256_seed_r(&xss, 2016);
+    omnia_xoshiro256_seed_r(&xpp, 2016);
+
+    const uint64_t seed[2] = { 42, 0 };
+    const uint64_t stream[2] = { 54, 0 };
+    omnia::pcg64 p(42, 54);
+    omnia_pcg64_t cp;
+
+    omnia_pcg64_seed_r(&cp, seed, stream);
+
+    omnia::wyrand w(2016);
+    omnia_wyrand_t cw;
+
+    omnia_wyrand_seed_r(&cw, 2016);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if ((ss() != omnia_xoshiro256ss_next_r(&xss)) || (pp() != omnia_xoshiro256pp_next_r(&xpp))
+        ||  (p() != omnia_pcg64_next_r(&cp)) || (w() != omnia_wyrand_next_r(&cw)))
+            ++errcnt;
+    }
+
+    ss.jump();
+    omnia_xoshiro256_jump_r(&xss);
+    p.jump();
+    omnia_pcg64_jump_r(&cp);
+    w.jump();
+    omnia_wyrand_jump_r(&cw);
+
+    if ((ss() != omnia_xoshiro256ss_next_r(&xss)) || (p() != omnia_pcg64_next_r(&cp)) || (w() != omnia_wyrand_next_r(&cw)))
+        ++errcnt;
+
+    // a counter discards in one step
+    omnia::wyrand e(7);
+    omnia::wyrand f(7);
+    std::vector<uint64_t> values(TEST_SIZE);
+
+    e.discard(TEST_SIZE);
+    f.fill(values.data(), TEST_SIZE);
+
+    if ((e != f) || (values[TEST_SIZE - 1] == values[TEST_SIZE - 2]))
+        ++errcnt;
+
+    // the classes drive the std:: distributions
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double sum = 0.0;
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        sum += uniform(p);
+
+    if (std::fabs(sum / TEST_SIZE - 0.5) > 0.05)
+        ++errcnt;
+
+    if (verbose)
+        printf("caller-owned: %d error(s)\n", (int)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_helpers(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    omnia::xs128p xs;
+    omnia::kiss32 k32(CONST_KISS32);
+
+    size_t counts[10] = { 0 };
+
+    // ranges stay in bounds and reach every value
+    for (size_t i = 0; i < 10 * TEST_SIZE; ++i)
+    {
+        const uint64_t v = omnia::range(xs, 10, 19);
+        const uint32_t w = omnia::range(k32, UINT32_MAX - 2, UINT32_MAX);
+
+        if ((v < 10) || (v > 19) || (w < UINT32_MAX - 2))
+            ++errcnt;
+        else
+            ++counts[v - 10];
+    }
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        // expected TEST_SIZE each
+        if ((counts[i] < TEST_SIZE * 8 / 10) || (counts[i] > TEST_SIZE * 12 / 10))
+            ++errcnt;
+    }
+
+    if (omnia::range(xs, 5, 5) != 5)
+        ++errcnt;
+
+    // reals are in [0,1) with a mean near 1/2
+    double sum = 0.0;
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        const double r = omnia::real(xs);
+        const float f = omnia::real<float>(k32);
+
+        if ((r < 0.0) || (r >= 1.0) || (f < 0.0f) || (f >= 1.0f))
+            ++errcnt;
+
+        sum += r;
+    }
+
+    if (fabs(sum / TEST_SIZE - 0.5) > 0.05)
+        ++errcnt;
+
+    if (omnia::index(xs, 7) >= 7)
+        ++errcnt;
+
+    // the standard distributions accept the generators
+    std::uniform_int_distribution<int> dice(1, 6);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    omnia::kiss64 k64(7);
+    double mean = 0.0;
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        const int roll = dice(k64);
+
+        if ((roll < 1) || (roll > 6))
+            ++errcnt;
+
+        mean += normal(xs);
+    }
+
+    if (fabs(mean / TEST_SIZE) > 0.15)
+        ++errcnt;
+
+    if (verbose)
+        printf("helpers: mean real %g, mean normal %g\n", sum / TEST_SIZE, mean / TEST_SIZE);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_sequences(verbose);
+    errcnt += test_caller_owned(verbose);
+    errcnt += test_helpers(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",(int)errcnt);
+
+    return errcnt;
+}
@@ -0,0 +1,221 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int test_fft(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 64;
+
+    double re[TEST_SIZE], im[TEST_SIZE], x[TEST_SIZE];
+
+    // counts errors
+    size_t i, k, errcnt = 0;
+    double worst = 0.0;
+
+    uint64_t seed[2] = { 12345, 67890 };
+    omnia_xs128p_set_seed(seed);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        x[i] = re[i] = omnia_xs128p_real() - 0.5;
+        im[i] = 0.0;
+    }
+
+    omnia_fft(re, im, TEST_SIZE, false);
+
+    // compare with a direct DFT
+    for (k = 0; k < TEST_SIZE; ++k)
+    {
+        double sr = 0.0, si = 0.0;
+
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            sr += x[i] * cos(2.0 * OMNIA_PI * (double)(i * k) / (double)TEST_SIZE);
+            si -= x[i] * sin(2.0 * OMNIA_PI * (double)(i * k) / (double)TEST_SIZE);
+        }
+
+        worst = fmax(worst, fabs(sr - re[k]) + fabs(si - im[k]));
+    }
+
+    if (verbose)
+        printf("fft: largest difference from DFT = %g\n", worst);
+
+    if (worst > 1e-12)
+        ++errcnt;
+
+    // round trip
+    omnia_fft(re, im, TEST_SIZE, true);
+    worst = 0.0;
+
+    for (i = 0; i < TEST_SIZE; ++i)
+        worst = fmax(worst, fabs(re[i] - x[i]) + fabs(im[i]));
+
+    if (verbose)
+        printf("fft: largest round-trip error = %g\n", worst);
+
+    if (worst > 1e-14)
+        ++errcnt;
+
+    // invalid length
+    if (omnia_fft(re, im, 48, false))
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_fir(bool verbose)
+{
+    // test data
+    static const size_t SIGNAL_SIZE = 20000;
+    static const size_t TEST_SIZE = 3;
+    static const size_t ntaps[] = { 1, 31, 301 };
+    static const size_t chunks[] = { 1, 7, 500, 3001, 64 };
+
+    double * x = malloc(sizeof(double) * SIGNAL_SIZE);
+    double * y = malloc(sizeof(double) * SIGNAL_SIZE);
+    double taps[301];
+
+    // counts errors
+    size_t i, j, t, errcnt = 0;
+
+    for (i = 0; i < SIGNAL_SIZE; ++i)
+        x[i] = omnia_xs128p_real() - 0.5;
+
+    for (t = 0; t < TEST_SIZE; ++t)
+    {
+        omnia_fir_design(taps, ntaps[t], OMNIA_FILTER_LOWPASS, 0.1, 0.0);
+        omnia_fir_t * fir = omnia_fir_create(taps, ntaps[t]);
+
+        if (fir == NULL)
+        {
+            ++errcnt;
+            continue;
+        }
+
+        // filter in place, in chunks of varying size
+        memcpy(y, x, sizeof(double) * SIGNAL_SIZE);
+
+        for (i = 0, j = 0; i < SIGNAL_SIZE; i += chunks[j], j = (j + 1) % 5)
+        {
+            size_t len = (SIGNAL_SIZE - i < chunks[j]) ? SIGNAL_SIZE - i : chunks[j];
+            omnia_fir_process(fir, y + i, y + i, len);
+        }
+
+        omnia_fir_free(fir);
+
+        // compare with direct convolution
+        double worst = 0.0;
+
+        for (i = 0; i < SIGNAL_SIZE; ++i)
+        {
+            double sum = 0.0;
+
+            for (j = 0; (j < ntaps[t]) && (j <= i); ++j)
+                sum += taps[j] * x[i - j];
+
+            worst = fmax(worst, fabs(sum - y[i]));
+        }
+
+        if (verbose)
+            printf("fir(%3d taps): largest difference from convolution = %g\n", ntaps[t], worst);
+
+        if (worst > 1e-12)
+            ++errcnt;
+    }
+
+    free(x);
+    free(y);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_iir(bool verbose)
+{
+    // test data
+    static const size_t SIGNAL_SIZE = 2000;
+
+    double x[SIGNAL_SIZE], y[SIGNAL_SIZE];
+    omnia_biquad_t sections[2];
+
+    // counts errors
+    size_t i, errcnt = 0;
+
+    omnia_biquad_design(&sections[0], OMNIA_FILTER_LOWPASS, 0.05, OMNIA_SQRT_HALF);
+    omnia_biquad_design(&sections[1], OMNIA_FILTER_LOWPASS, 0.05, OMNIA_SQRT_HALF);
+    omnia_iir_t * iir = omnia_iir_create(sections, 2);
+
+    // a constant passes unchanged once the filter settles
+    for (i = 0; i < SIGNAL_SIZE; ++i)
+        x[i] = 1.0;
+
+    omnia_iir_process(iir, x, y, SIGNAL_SIZE);
+
+    if (verbose)
+        printf("iir: step response = %10.8f (should be 1.00000000)\n", y[SIGNAL_SIZE - 1]);
+
+    if (fabs(y[SIGNAL_SIZE - 1] - 1.0) > 1e-9)
+        ++errcnt;
+
+    // the Nyquist frequency is blocked
+    omnia_iir_reset(iir);
+
+    for (i = 0; i < SIGNAL_SIZE; ++i)
+        x[i] = (i & 1) ? -1.0 : 1.0;
+
+    omnia_iir_process(iir, x, y, SIGNAL_SIZE / 2);
+    omnia_iir_process(iir, x + SIGNAL_SIZE / 2, y + SIGNAL_SIZE / 2, SIGNAL_SIZE / 2);
+
+    if (verbose)
+        printf("iir: Nyquist response = %10.8f (should be 0.00000000)\n", y[SIGNAL_SIZE - 1]);
+
+    if (fabs(y[SIGNAL_SIZE - 1]) > 1e-9)
+        ++errcnt;
+
+    omnia_iir_free(iir);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_fft(verbose);
+    errcnt += test_fir(verbose);
+    errcnt += test_iir(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -0,0 +1,214 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// random bit patterns, covering every exponent
+static double random_double()
+{
+    double x;
+
+    do
+    {
+        uint64_t bits = omnia_xs128p_next();
+        memcpy(&x, &bits, sizeof(x));
+    }
+    while (!isfinite(x));
+
+    return x;
+}
+
+int test_decimal_exponent(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 100000;
+
+    // counts errors
+    size_t i, errcnt = 0;
+    char text[64];
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        double x = random_double();
+
+        if (x == 0.0)
+            continue;
+
+        // printf's exponent is that of the correctly rounded 17-digit value
+        snprintf(text, sizeof(text), "%.16e", x);
+        int expected = atoi(strchr(text, 'e') + 1);
+
+        // which differs only if rounding carried into a new power of ten
+        if ((omnia_decimal_exponent(x) != expected) && (strncmp(text + (x < 0.0), "1.0000000000000000e", 19) != 0))
+        {
+            if (verbose)
+                printf("decimal_exponent(%s) = %d\n", text, omnia_decimal_exponent(x));
+
+            ++errcnt;
+        }
+    }
+
+    if (omnia_decimal_exponent(1e22) != 22 || omnia_decimal_exponent(999.0) != 2 || omnia_decimal_exponent(4.9e-324) != -324)
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+// significant digits of a formatted value, without trailing zeros
+static void significant_digits(const char * text, char * digits)
+{
+    char * start = digits;
+
+    for (; (*text != '\0') && (*text != 'e'); ++text)
+    {
+        if ((*text >= '0') && (*text <= '9') && ((*text != '0') || (digits != start)))
+            *digits++ = *text;
+    }
+
+    while ((digits > start) && (digits[-1] == '0'))
+        --digits;
+
+    *digits = '\0';
+}
+
+int test_shortest(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 200000;
+
+    // counts errors
+    size_t i, errcnt = 0;
+    char text[OMNIA_FORMAT_BUFFER_SIZE];
+    char expected[64];
+    char digits[2][32];
+    int p;
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        double x = (i & 1) ? random_double() : omnia_sigdig((omnia_xs128p_real() - 0.5) * 1e6, (uint16_t)(1 + i % 15));
+
+        size_t length = omnia_format_double(x, text);
+
+        // shortest precision that round-trips, written by printf
+        for (p = 1; p <= 17; ++p)
+        {
+            snprintf(expected, sizeof(expected), "%.*e", p - 1, x);
+
+            if (strtod(expected, NULL) == x)
+                break;
+        }
+
+        significant_digits(text, digits[0]);
+        significant_digits(expected, digits[1]);
+
+        if ((strtod(text, NULL) != x) || (length != strlen(text)) || (strcmp(digits[0], digits[1]) != 0))
+        {
+            if (verbose)
+                printf("format_double(%.17g) = %s (should be %s)\n", x, text, expected);
+
+            ++errcnt;
+        }
+    }
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_sigdig(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 14;
+
+    // the later values are near a rounding midpoint, where the shortest digits mislead
+    static const double values[] =
+    {
+        299792.4562, -0.000123456, 1e23, 0.0, 1.0 / 3.0, 6.02214076e23, 999999.5,
+        0.15, 2.675, 0.45, 5e-324, 9.9999999999999992e22, 9.9998886718268301e-321, 1e15 + 0.5
+    };
+
+    static const uint16_t digits[] =
+    {
+        4, 2, 1, 3, 5, 6, 6,
+        1, 3, 1, 3, 16, 5, 16
+    };
+
+    // counts errors
+    size_t i, errcnt = 0;
+    char text[OMNIA_FORMAT_BUFFER_SIZE];
+    char expected[64];
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        omnia_format_sigdig(values[i], digits[i], text);
+        snprintf(expected, sizeof(expected), "%.*g", digits[i], values[i]);
+
+        if (verbose)
+            printf("format_sigdig(%.17g,%d) = %s (should be %s)\n", values[i], digits[i], text, expected);
+
+        if (strcmp(text, expected) != 0)
+            ++errcnt;
+    }
+
+    // a row that does not fit
+    double row[] = { 1.5, -2.25, 1e-7, 3.0 };
+    size_t written, count;
+
+    count = omnia_format_array(row, 4, 0, ',', expected, 64, &written);
+
+    if (verbose)
+        printf("format_array = %s (should be 1.5,-2.25,1e-07,3)\n", expected);
+
+    if ((count != 4) || (strcmp(expected, "1.5,-2.25,1e-07,3") != 0) || (written != 17))
+        ++errcnt;
+
+    count = omnia_format_array(row, 4, 0, ',', expected, 12, &written);
+
+    if ((count != 2) || (strcmp(expected, "1.5,-2.25") != 0))
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    uint64_t seed[2] = { 0x0123456789abcdefULL, 0xfedcba9876543210ULL };
+    omnia_xs128p_set_seed(seed);
+
+    errcnt += test_decimal_exponent(verbose);
+    errcnt += test_shortest(verbose);
+    errcnt += test_sigdig(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
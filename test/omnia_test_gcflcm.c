@@ -106,6 +106,252 @@ int test_gcf(bool verbose)
     return errcnt;
 }
 
+int test_binary_gcf(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 100000;
+
+    // counts errors
+    size_t i, errcnt = 0;
+
+    uint64_t seed[2] = { 31415, 92653 };
+    omnia_xs128p_set_seed(seed);
+
+    // compare with Euclid's algorithm, using values with shared factors
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        const uint64_t f = omnia_xs128p_next() >> (40 + i % 24);
+        uint64_t x = (omnia_xs128p_next() >> (i % 50)) * (f | 1);
+        uint64_t y = (omnia_xs128p_next() >> (i % 40)) * (f | 1) << (i % 5);
+        const uint64_t result = omnia_gcf(x, y);
+
+        while (y != 0)
+        {
+            const uint64_t temp = x % y;
+            x = y;
+            y = temp;
+        }
+
+        if (result != x)
+            ++errcnt;
+    }
+
+    if (verbose)
+        printf("binary gcf: %lu mismatch(es) in %lu random pairs\n", (unsigned long)errcnt, (unsigned long)TEST_SIZE);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_lcm_checked(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 5;
+
+    static const uint64_t test_set1[] =
+    {
+        0, 36, UINT64_C(4294967296), UINT64_C(4294967311), UINT64_C(0x8000000000000000)
+    };
+
+    static const uint64_t test_set2[] =
+    {
+        5, 125, UINT64_C(4294967296), UINT64_C(4294967357), 3
+    };
+
+    static const uint64_t expected[] =
+    {
+        0, 4500, UINT64_C(4294967296), 0, 0
+    };
+
+    static const bool expected_overflow[] =
+    {
+        false, false, false, true, true
+    };
+
+    // counts errors
+    size_t i, errcnt = 0;
+    uint64_t result;
+    bool overflow;
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        result = omnia_lcm_checked(test_set1[i], test_set2[i], &overflow);
+
+        if (verbose)
+            printf("lcm_checked(%lu,%lu) = %lu, overflow = %d (should be %lu, %d)\n",
+                    (unsigned long)test_set1[i],
+                    (unsigned long)test_set2[i],
+                    (unsigned long)result,
+                    (int)overflow,
+                    (unsigned long)(expected_overflow[i] ? 0 : expected[i]),
+                    (int)expected_overflow[i]);
+
+        if ((overflow != expected_overflow[i]) || (!overflow && (result != expected[i])))
+            ++errcnt;
+    }
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_arrays(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 1001;
+
+    uint64_t a[TEST_SIZE], b[TEST_SIZE], r[TEST_SIZE];
+
+    // counts errors
+    size_t i, errcnt = 0;
+    uint64_t result;
+    bool overflow;
+
+    // multiples of 360, with one element that is exactly 360
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        a[i] = 360 * ((omnia_xs128p_next() >> 20) + 1);
+        b[i] = omnia_xs128p_next() >> (i % 64);
+    }
+
+    a[TEST_SIZE - 1] = 360;
+    result = omnia_gcf_array(a, TEST_SIZE);
+
+    if (verbose)
+        printf("gcf_array = %lu (should be 360)\n", (unsigned long)result);
+
+    if (result != 360)
+        ++errcnt;
+
+    // early exit
+    a[3] = 7;
+    result = omnia_gcf_array(a, TEST_SIZE);
+
+    if (verbose)
+        printf("gcf_array = %lu (should be 1)\n", (unsigned long)result);
+
+    if (result != 1)
+        ++errcnt;
+
+    if (omnia_gcf_array(a, 0) != 0)
+        ++errcnt;
+
+    // pairwise
+    omnia_gcf_pairwise(a, b, r, TEST_SIZE);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        if (r[i] != omnia_gcf(a[i], b[i]))
+            ++errcnt;
+    }
+
+    // lcm of 1..40 fits in 64 bits, lcm of 1..50 does not
+    for (i = 0; i < 50; ++i)
+        a[i] = i + 1;
+
+    result = omnia_lcm_array(a, 40, &overflow);
+
+    if (verbose)
+        printf("lcm_array(1..40) = %lu, overflow = %d (should be 5342931457063200, 0)\n", (unsigned long)result, (int)overflow);
+
+    if (overflow || (result != UINT64_C(5342931457063200)))
+        ++errcnt;
+
+    result = omnia_lcm_array(a, 50, &overflow);
+
+    if (verbose)
+        printf("lcm_array(1..50) = %lu, overflow = %d (should be 0, 1)\n", (unsigned long)result, (int)overflow);
+
+    if (!overflow || (result != 0))
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_parallel_arrays(bool verbose)
+{
+    // test data, in many chunks
+    static const size_t TEST_SIZE = 100003;
+    static const size_t THREADS[] = { 1, 4 };
+
+    static uint64_t a[100003], b[100003], r[100003];
+
+    // counts errors
+    size_t i, t, errcnt = 0;
+    bool overflow;
+
+    omnia_set_grain(1000);
+
+    for (t = 0; t < sizeof(THREADS) / sizeof(THREADS[0]); ++t)
+    {
+        omnia_set_threads(THREADS[t]);
+
+        // the common factor survives every chunk
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            a[i] = 360 * ((omnia_xs128p_next() >> 20) + 1);
+            b[i] = omnia_xs128p_next() >> (i % 64);
+        }
+
+        a[TEST_SIZE / 2] = 360;
+
+        if (omnia_gcf_array(a, TEST_SIZE) != 360)
+            ++errcnt;
+
+        // one element in the last chunk brings it to 1
+        a[TEST_SIZE - 1] = 7;
+
+        if (omnia_gcf_array(a, TEST_SIZE) != 1)
+            ++errcnt;
+
+        omnia_gcf_pairwise(a, b, r, TEST_SIZE);
+
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            if (r[i] != omnia_gcf(a[i], b[i]))
+            {
+                ++errcnt;
+                break;
+            }
+        }
+
+        // 1..40 repeated has the LCM of 1..40
+        for (i = 0; i < TEST_SIZE; ++i)
+            a[i] = i % 40 + 1;
+
+        if ((omnia_lcm_array(a, TEST_SIZE, &overflow) != UINT64_C(5342931457063200)) || overflow)
+            ++errcnt;
+
+        // a zero ends the scan before a later overflow
+        a[5000] = 0;
+        a[90000] = 43;
+        a[90001] = 47;
+        a[90002] = 53;
+
+        if ((omnia_lcm_array(a, TEST_SIZE, &overflow) != 0) || overflow)
+            ++errcnt;
+
+        // an overflow spread over chunks ends the scan before a later zero
+        a[5000] = 1;
+        a[1500] = 43;
+        a[2500] = 47;
+        a[3500] = 53;
+        a[50000] = 0;
+
+        if ((omnia_lcm_array(a, TEST_SIZE, &overflow) != 0) || !overflow)
+            ++errcnt;
+
+        if (verbose)
+            printf("%d thread(s): %d error(s) so far\n", (int)THREADS[t], (int)errcnt);
+    }
+
+    omnia_set_threads(0);
+    omnia_set_grain(0);
+
+    // return number of errors
+    return errcnt;
+}
+
 int main(int argc, char * argv[])
 {
     bool verbose = false;
@@ -119,6 +365,10 @@ int main(int argc, char * argv[])
     
     errcnt += test_lcm(verbose);
     errcnt += test_gcf(verbose);
+    errcnt += test_binary_gcf(verbose);
+    errcnt += test_lcm_checked(verbose);
+    errcnt += test_arrays(verbose);
+    errcnt += test_parallel_arrays(verbose);
     
     if (verbose)
         fprintf(stderr,"found %d error(s)\n",errcnt);
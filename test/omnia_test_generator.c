@@ -0,0 +1,222 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+#define TEST_SIZE 1003
+
+int test_known_values(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    // reference implementations, from the state { 1, 2, 3, 4 }
+    omnia_xoshiro256_t x = { { 1, 2, 3, 4 } };
+
+    if (omnia_xoshiro256ss_next_r(&x) != 11520ULL)
+        ++errcnt;
+
+    x = (omnia_xoshiro256_t){ { 1, 2, 3, 4 } };
+
+    if (omnia_xoshiro256pp_next_r(&x) != 41943041ULL)
+        ++errcnt;
+
+    // pcg64-global-demo, seeded with 42 and stream 54
+    static const uint64_t PCG_EXPECTED[3] = { 0x86b1da1d72062b68ULL, 0x1304aa46c9853d39ULL, 0xa3670e9e0dd50358ULL };
+    const uint64_t seed[2] = { 42, 0 };
+    const uint64_t stream[2] = { 54, 0 };
+    omnia_pcg64_t p;
+
+    omnia_pcg64_seed_r(&p, seed, stream);
+
+    for (size_t i = 0; i < 3; ++i)
+        if (omnia_pcg64_next_r(&p) != PCG_EXPECTED[i])
+            ++errcnt;
+
+    // wyrand from a zero seed
+    omnia_wyrand_t w;
+    omnia_wyrand_seed_r(&w, 0);
+
+    if ((omnia_wyrand_next_r(&w) != 0x9a45cd888d59f0d6ULL) || (omnia_wyrand_next_r(&w) != 0x01445b6a189663f5ULL))
+        ++errcnt;
+
+    if (verbose)
+        printf("known values: %d error(s)\n", (int)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_jump(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    // computed from x^(2^128) modulo the characteristic polynomial
+    omnia_xoshiro256_t x = { { 1, 2, 3, 4 } };
+    omnia_xoshiro256_jump_r(&x);
+
+    if ((x.s[0] != 0x8c7a153956b5f3d1ULL) || (x.s[1] != 0x701f1a713401d85eULL)
+    ||  (x.s[2] != 0x6527f66a65469085ULL) || (x.s[3] != 0x8386b786c4408050ULL))
+        ++errcnt;
+
+    // computed as M^(2^64) s + c (M^(2^64) - 1) / (M - 1)
+    const uint64_t seed[2] = { 42, 0 };
+    const uint64_t stream[2] = { 54, 0 };
+    omnia_pcg64_t p, q;
+
+    omnia_pcg64_seed_r(&p, seed, stream);
+    q = p;
+    omnia_pcg64_jump_r(&p);
+
+    if ((p.state[0] != 0xd3f6c45a41e54320ULL) || (p.state[1] != 0x9c3f548221203276ULL)
+    ||  (p.inc[0] != q.inc[0]) || (p.inc[1] != q.inc[1]))
+        ++errcnt;
+
+    // a counter jumps by adding
+    omnia_wyrand_t w = { 12345 };
+    omnia_wyrand_jump_r(&w);
+
+    if (w.s != 12345 + (0x2d358dccaa6c78a5ULL << 32))
+        ++errcnt;
+
+    if (verbose)
+        printf("jump: %d error(s)\n", (int)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_descriptors(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    static const char * const NAMES[OMNIA_GENERATOR_COUNT] = { "xs128p", "xoshiro256ss", "xoshiro256pp", "pcg64", "wyrand" };
+
+    uint64_t expected[TEST_SIZE];
+    uint64_t result[TEST_SIZE];
+
+    for (int id = 0; id < OMNIA_GENERATOR_COUNT; ++id)
+    {
+        const omnia_generator_t * gen = omnia_get_generator((omnia_generator_id_t)id);
+        size_t local = 0;
+
+        if ((gen == NULL) || (omnia_find_generator(NAMES[id]) != gen) || (strcmp(gen->name, NAMES[id]) != 0)
+        ||  (gen->state_size > sizeof(omnia_generator_state_t)))
+        {
+            ++errcnt;
+            continue;
+        }
+
+        omnia_generator_state_t a, b;
+
+        // fill stores what next returns, and leaves the same state
+        gen->seed(&a, 20160101);
+        gen->seed(&b, 20160101);
+
+        for (size_t i = 0; i < TEST_SIZE; ++i)
+            expected[i] = gen->next(&a);
+
+        gen->fill(&b, result, TEST_SIZE);
+
+        if ((memcmp(expected, result, sizeof(expected)) != 0) || (memcmp(&a, &b, gen->state_size) != 0))
+            ++local;
+
+        // nearby seeds give unrelated streams
+        gen->seed(&b, 20160102);
+        gen->fill(&b, result, TEST_SIZE);
+
+        if (memcmp(expected, result, sizeof(expected)) == 0)
+            ++local;
+
+        // a jumped stream does not repeat the original
+        gen->seed(&a, 20160101);
+        gen->seed(&b, 20160101);
+        gen->jump(&b);
+        gen->fill(&b, result, TEST_SIZE);
+
+        if ((memcmp(expected, result, sizeof(expected)) == 0) || (memcmp(&a, &b, gen->state_size) == 0))
+            ++local;
+
+        // reals lie in [0,1) and average one half
+        double sum = 0.0;
+
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            const double r = omnia_generator_real(gen, &a);
+
+            if ((r < 0.0) || (r >= 1.0))
+                ++local;
+
+            sum += r;
+        }
+
+        if (fabs(sum / 100000.0 - 0.5) > 0.005)
+            ++local;
+
+        if (verbose)
+            printf("%s: %d error(s)\n", gen->name, (int)local);
+
+        errcnt += local;
+    }
+
+    if ((omnia_get_generator(OMNIA_GENERATOR_COUNT) != NULL) || (omnia_find_generator("kiss64") != NULL) || (omnia_find_generator(NULL) != NULL))
+        ++errcnt;
+
+    // the typed functions behind the descriptors
+    omnia_generator_state_t s;
+    omnia_xoshiro256_t x;
+    omnia_get_generator(OMNIA_GENERATOR_XOSHIRO256PP)->seed(&s, 7);
+    omnia_xoshiro256_seed_r(&x, 7);
+
+    if (omnia_get_generator(OMNIA_GENERATOR_XOSHIRO256PP)->next(&s) != omnia_xoshiro256pp_next_r(&x))
+        ++errcnt;
+
+    if (verbose)
+        printf("descriptors: %d error(s)\n", (int)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_known_values(verbose);
+    errcnt += test_jump(verbose);
+    errcnt += test_descriptors(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -0,0 +1,171 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+// this program uses the inline definitions
+#define OMNIA_INLINE
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_SIZE 1000
+
+int test_generator(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    const uint64_t seed[2] = { 12345678901ULL, 98765432109ULL };
+    omnia_xs128p_t a;
+    omnia_xs128p_t b;
+
+    // the inline generator matches the library's, and states are independent
+    omnia_xs128p_seed_r(&a, seed);
+    omnia_xs128p_seed_r(&b, seed);
+    omnia_xs128p_set_seed(seed);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        const uint64_t v = omnia_xs128p_next_r(&a);
+
+        if (v != omnia_xs128p_next())
+            ++errcnt;
+
+        if ((i % 2) == 0)
+            omnia_xs128p_next_r(&b);
+    }
+
+    // fill and jump from the library continue the same sequence
+    uint64_t values[TEST_SIZE];
+
+    b = a;
+    omnia_xs128p_fill_r(&a, values, TEST_SIZE);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if (values[i] != omnia_xs128p_next_r(&b))
+            ++errcnt;
+    }
+
+    omnia_xs128p_fill(values, TEST_SIZE);
+    omnia_xs128p_jump_r(&a);
+    omnia_xs128p_jump();
+
+    if (omnia_xs128p_next_r(&a) != omnia_xs128p_next())
+        ++errcnt;
+
+    // helpers stay in range
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        const uint64_t r = omnia_xs128p_range_r(&a, 7, 3);
+        const double x = omnia_xs128p_real_r(&a);
+
+        if ((r < 3) || (r > 7) || (x < 0.0) || (x > 1.0) || (omnia_xs128p_index_r(&a, 10) >= 10))
+            ++errcnt;
+    }
+
+    if (verbose)
+        printf("generator: %d error(s)\n", (int)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_scalars(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    // the inline gcf agrees with the library's array version
+    uint64_t x[TEST_SIZE];
+    uint64_t y[TEST_SIZE];
+    uint64_t g[TEST_SIZE];
+    omnia_xs128p_t r;
+
+    omnia_xs128p_seed_r(&r, (const uint64_t[]){ 1, 2 });
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        const uint64_t common = omnia_xs128p_next_r(&r) >> 50;
+
+        x[i] = (omnia_xs128p_next_r(&r) >> 40) * common;
+        y[i] = (omnia_xs128p_next_r(&r) >> 40) * common;
+    }
+
+    x[0] = 0;
+    y[1] = 0;
+    x[2] = y[2];
+
+    omnia_gcf_pairwise(x, y, g, TEST_SIZE);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if (omnia_gcf(x[i], y[i]) != g[i])
+            ++errcnt;
+    }
+
+    // so does rounding, on halves and near them
+    double v[TEST_SIZE];
+    double rounded[TEST_SIZE];
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        v[i] = ((double)i - TEST_SIZE / 2) * 0.25 + ((i % 3 == 0) ? 1e-9 : 0.0);
+
+    omnia_round_nearest_array(v, rounded, TEST_SIZE);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if (omnia_round_nearest(v[i]) != rounded[i])
+            ++errcnt;
+    }
+
+    if ((omnia_round_nearest(2.5) != 2.0) || (omnia_round_nearest(-3.5) != -4.0) || (omnia_round_nearest(-0.6) != -1.0))
+        ++errcnt;
+
+    // powers of two
+    if ((omnia_sizepow2(0) != 0) || (omnia_sizepow2(1) != 1) || (omnia_sizepow2(1000) != 1024) || (omnia_sizepow2(1024) != 1024)
+        || (omnia_sizepow2(INT_MAX / 2 + 1) != INT_MAX / 2 + 1) || (omnia_sizepow2(INT_MAX / 2 + 2) != 0))
+        ++errcnt;
+
+    if (verbose)
+        printf("scalars: %d error(s)\n", (int)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_generator(verbose);
+    errcnt += test_scalars(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -19,20 +19,18 @@
 
 #include <stdio.h>
 #include <time.h>
-#include <locale.h>
+#include <stdlib.h>
 
 static const size_t TEST_SIZE = 1010000000;
 static const size_t NUM_BUCKETS = 101;
 
-double test_xs128p()
+void test_xs128p()
 {
     double total;
     size_t i;
     double n, l, s;
     double counts[NUM_BUCKETS];
 
-    struct timespec start, stop;
-
     printf("\n>>>> xorshift+ <<<<\n");
 
     s = 1.1;
@@ -78,29 +76,16 @@ double test_xs128p()
     printf("    average = %10.0f\n", stats[0]);
     printf("   std. dev = %10.0f (%8.4f%%)\n", stats[2], stats[2] / stats[1] * 100.0);
 
-    // get starting time
-    clock_gettime(CLOCK_REALTIME,&start);
-
-    // test generation speed
-    for (i = 0; i < TEST_SIZE; ++i)
-        omnia_xs128p_next();
-
-    // calculate run time
-    clock_gettime(CLOCK_REALTIME,&stop);
-
-    // done
-    return ((stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / (double)TEST_SIZE);
+    omnia_free(stats);
 }
 
-double test_kiss32()
+void test_kiss32()
 {
     double total;
     size_t i;
     double n, l, s;
     double counts[NUM_BUCKETS];
 
-    struct timespec start, stop;
-
     printf("\n>>>> 32 bit KISS <<<<\n");
 
     s = 1.1;
@@ -142,29 +127,16 @@ double test_kiss32()
     printf("    average = %10.0f\n", stats[0]);
     printf("   std. dev = %10.0f (%8.4f%%)\n", stats[2], stats[2] / stats[1] * 100.0);
 
-    // get starting time
-    clock_gettime(CLOCK_REALTIME,&start);
-
-    // test generation speed
-    for (i = 0; i < TEST_SIZE; ++i)
-        omnia_kiss32_next();
-
-    // calculate run time
-    clock_gettime(CLOCK_REALTIME,&stop);
-
-    // done
-    return ((stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / (double)TEST_SIZE);
+    omnia_free(stats);
 }
 
-double test_kiss64()
+void test_kiss64()
 {
     double total;
     size_t i;
     double n, l, s;
     double counts[NUM_BUCKETS];
 
-    struct timespec start, stop;
-
     printf("\n>>>> 64-bit KISS <<<<\n");
 
     s = 1.1;
@@ -206,33 +178,15 @@ double test_kiss64()
     printf("    average = %10.0f\n", stats[0]);
     printf("   std. dev = %10.0f (%8.4f%%)\n", stats[2], stats[2] / stats[1] * 100.0);
 
-    // get starting time
-    clock_gettime(CLOCK_REALTIME,&start);
-
-    // test generation speed
-    for (i = 0; i < TEST_SIZE; ++i)
-        omnia_kiss64_next();
-
-    // calculate run time
-    clock_gettime(CLOCK_REALTIME,&stop);
-
-    // done
-    return ((stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / (double)TEST_SIZE);
+    omnia_free(stats);
 }
 
 int main()
 {
-    double kiss32_time = test_kiss32();
-    double kiss64_time = test_kiss64();
-    double xs128p_time = test_xs128p();
-
-    setlocale(LC_NUMERIC, "");
-
-    printf("\nALGORITHM TIMING (random numbers / second)\n\n");
-    printf("            KISS32 = %'d/sec\n",    (long)(TEST_SIZE / kiss32_time));
-    printf("            KISS64 = %'d/sec\n\n",  (long)(TEST_SIZE / kiss64_time));
-    printf("            XS128P = %'d/sec\n\n",  (long)(TEST_SIZE / xs128p_time));
+    // generation speed is measured by bench/omnia_bench
+    test_kiss32();
+    test_kiss64();
+    test_xs128p();
 
     return 0;
 }
-
@@ -0,0 +1,373 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define TEST_DIMS 1024
+#define TEST_SIZE 1024
+
+// does each interval of length 1 / intervals hold at most one value of coordinate j?
+static bool stratified(const double * points, const size_t dims, const size_t j, const size_t n, const size_t intervals)
+{
+    bool * seen = (bool *)calloc(intervals, sizeof(bool));
+    bool result = true;
+
+    for (size_t i = 0; (i < n) && result; ++i)
+    {
+        const double x = points[i * dims + j];
+        const size_t cell = (size_t)(x * (double)intervals);
+
+        if ((x < 0.0) || (x >= 1.0) || (cell >= intervals) || seen[cell])
+            result = false;
+        else
+            seen[cell] = true;
+    }
+
+    free(seen);
+    return result;
+}
+
+int test_sobol(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    // Joe and Kuo direction numbers, in Gray-code order
+    static const double EXPECTED[8][4] =
+    {
+        { 0, 0, 0, 0 },
+        { 0.5, 0.5, 0.5, 0.5 },
+        { 0.75, 0.25, 0.25, 0.25 },
+        { 0.25, 0.75, 0.75, 0.75 },
+        { 0.375, 0.375, 0.625, 0.875 },
+        { 0.875, 0.875, 0.125, 0.375 },
+        { 0.625, 0.125, 0.875, 0.625 },
+        { 0.125, 0.625, 0.375, 0.125 }
+    };
+
+    double * a = (double *)malloc(sizeof(double) * TEST_DIMS * TEST_SIZE);
+    double * b = (double *)malloc(sizeof(double) * TEST_DIMS * TEST_SIZE);
+    omnia_sobol_t * sobol = omnia_sobol_create(TEST_DIMS);
+
+    if ((a == NULL) || (b == NULL) || (sobol == NULL))
+    {
+        if (verbose)
+            printf("cannot create sobol generator\n");
+
+        free(a);
+        free(b);
+        omnia_sobol_free(sobol);
+        return 1;
+    }
+
+    if (omnia_sobol_fill(sobol, a, TEST_SIZE) != TEST_SIZE)
+        ++errcnt;
+
+    for (size_t i = 0; i < 8; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            if (a[i * TEST_DIMS + j] != EXPECTED[i][j])
+            {
+                if (verbose)
+                    printf("sobol point %zu coordinate %zu: %g, expected %g\n", i, j, a[i * TEST_DIMS + j], EXPECTED[i][j]);
+
+                ++errcnt;
+            }
+
+    // the first 2^k points are a net: one in each interval of length 2^-k
+    for (size_t j = 0; j < TEST_DIMS; ++j)
+        if (!stratified(a, TEST_DIMS, j, TEST_SIZE, TEST_SIZE))
+        {
+            if (verbose)
+                printf("sobol coordinate %zu is not stratified\n", j);
+
+            ++errcnt;
+        }
+
+    // seeking gives the same points as stepping
+    omnia_sobol_seek(sobol, 389);
+    omnia_sobol_fill(sobol, b, 1);
+    omnia_sobol_next(sobol, b + TEST_DIMS);
+    omnia_sobol_fill(sobol, b + 2 * TEST_DIMS, TEST_SIZE - 389 - 2);
+
+    if ((memcmp(a + 389 * TEST_DIMS, b, sizeof(double) * TEST_DIMS * (TEST_SIZE - 389)) != 0)
+    ||  (omnia_sobol_index(sobol) != TEST_SIZE))
+    {
+        if (verbose)
+            printf("sobol seek differs from fill\n");
+
+        ++errcnt;
+    }
+
+    // a point far into the last dimension
+    omnia_sobol_seek(sobol, 4999);
+    omnia_sobol_next(sobol, b);
+
+    if (b[TEST_DIMS - 1] != 0.7418212890625)
+    {
+        if (verbose)
+            printf("sobol point 4999: %.17g, expected 0.7418212890625\n", b[TEST_DIMS - 1]);
+
+        ++errcnt;
+    }
+
+    // the sequence ends after 2^32 points
+    omnia_sobol_seek(sobol, OMNIA_LOWDISC_MAX_POINTS - 2);
+
+    if ((omnia_sobol_fill(sobol, b, 5) != 2) || omnia_sobol_next(sobol, b)
+    ||  omnia_sobol_seek(sobol, OMNIA_LOWDISC_MAX_POINTS + 1))
+    {
+        if (verbose)
+            printf("sobol sequence does not end at OMNIA_LOWDISC_MAX_POINTS\n");
+
+        ++errcnt;
+    }
+
+    omnia_sobol_free(sobol);
+
+    if ((omnia_sobol_create(0) != NULL) || (omnia_sobol_create(OMNIA_LOWDISC_MAX_DIMENSIONS + 1) != NULL))
+        ++errcnt;
+
+    free(a);
+    free(b);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_sobol_scrambled(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    const size_t dims = 64;
+    double * a = (double *)malloc(sizeof(double) * dims * TEST_SIZE);
+    double * b = (double *)malloc(sizeof(double) * dims * TEST_SIZE);
+    omnia_sobol_t * s1 = omnia_sobol_create_scrambled(dims, 42);
+    omnia_sobol_t * s2 = omnia_sobol_create_scrambled(dims, 42);
+    omnia_sobol_t * s3 = omnia_sobol_create_scrambled(dims, 43);
+
+    omnia_sobol_fill(s1, a, TEST_SIZE);
+
+    // scrambling keeps the net property, and moves the origin
+    for (size_t j = 0; j < dims; ++j)
+        if (!stratified(a, dims, j, TEST_SIZE, TEST_SIZE))
+            ++errcnt;
+
+    if (a[0] == 0.0)
+        ++errcnt;
+
+    // equal seeds agree, with seeking
+    omnia_sobol_seek(s2, 700);
+    omnia_sobol_fill(s2, b, TEST_SIZE - 700);
+
+    if (memcmp(a + 700 * dims, b, sizeof(double) * dims * (TEST_SIZE - 700)) != 0)
+        ++errcnt;
+
+    // different seeds do not
+    omnia_sobol_fill(s3, b, TEST_SIZE);
+
+    if (memcmp(a, b, sizeof(double) * dims * TEST_SIZE) == 0)
+        ++errcnt;
+
+    if (verbose)
+        printf("scrambled sobol: %d error(s)\n", (int)errcnt);
+
+    omnia_sobol_free(s1);
+    omnia_sobol_free(s2);
+    omnia_sobol_free(s3);
+    free(a);
+    free(b);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_halton(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    static const double EXPECTED[8][3] =
+    {
+        { 0.0,   0.0,       0.0  },
+        { 0.5,   1.0 / 3.0, 0.2  },
+        { 0.25,  2.0 / 3.0, 0.4  },
+        { 0.75,  1.0 / 9.0, 0.6  },
+        { 0.125, 4.0 / 9.0, 0.8  },
+        { 0.625, 7.0 / 9.0, 0.04 },
+        { 0.375, 2.0 / 9.0, 0.24 },
+        { 0.875, 5.0 / 9.0, 0.44 }
+    };
+
+    double * a = (double *)malloc(sizeof(double) * TEST_DIMS * TEST_SIZE);
+    double * b = (double *)malloc(sizeof(double) * TEST_DIMS * TEST_SIZE);
+    omnia_halton_t * halton = omnia_halton_create(TEST_DIMS);
+
+    if ((a == NULL) || (b == NULL) || (halton == NULL))
+    {
+        if (verbose)
+            printf("cannot create halton generator\n");
+
+        free(a);
+        free(b);
+        omnia_halton_free(halton);
+        return 1;
+    }
+
+    omnia_halton_fill(halton, a, TEST_SIZE);
+
+    for (size_t i = 0; i < 8; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            if (fabs(a[i * TEST_DIMS + j] - EXPECTED[i][j]) > 1e-15)
+            {
+                if (verbose)
+                    printf("halton point %zu coordinate %zu: %.17g, expected %.17g\n", i, j, a[i * TEST_DIMS + j], EXPECTED[i][j]);
+
+                ++errcnt;
+            }
+
+    // radical inverses in the first ten bases
+    static const unsigned BASES[10] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29 };
+
+    for (size_t j = 0; j < 10; ++j)
+        for (size_t i = 0; i < TEST_SIZE; ++i)
+        {
+            double expected = 0.0;
+            double scale = 1.0 / BASES[j];
+
+            for (size_t k = i; k != 0; k /= BASES[j], scale /= BASES[j])
+                expected += (double)(k % BASES[j]) * scale;
+
+            if (fabs(a[i * TEST_DIMS + j] - expected) > 1e-15)
+                ++errcnt;
+        }
+
+    // in the last dimension, base 8161, point i is i / 8161
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        if (fabs(a[i * TEST_DIMS + TEST_DIMS - 1] - (double)i / 8161.0) > 1e-15)
+            ++errcnt;
+
+    // seeking gives exactly the same points as stepping
+    omnia_halton_seek(halton, 511);
+    omnia_halton_next(halton, b);
+    omnia_halton_fill(halton, b + TEST_DIMS, TEST_SIZE - 512);
+
+    if ((memcmp(a + 511 * TEST_DIMS, b, sizeof(double) * TEST_DIMS * (TEST_SIZE - 511)) != 0)
+    ||  (omnia_halton_index(halton) != TEST_SIZE))
+    {
+        if (verbose)
+            printf("halton seek differs from fill\n");
+
+        ++errcnt;
+    }
+
+    // the radical inverse of 2^32 - 1 in base 2
+    omnia_halton_seek(halton, OMNIA_LOWDISC_MAX_POINTS - 1);
+
+    if (!omnia_halton_next(halton, b) || (b[0] != 1.0 - ldexp(1.0, -32)) || omnia_halton_next(halton, b))
+    {
+        if (verbose)
+            printf("halton point 2^32 - 1: %.17g\n", b[0]);
+
+        ++errcnt;
+    }
+
+    omnia_halton_free(halton);
+
+    if ((omnia_halton_create(0) != NULL) || (omnia_halton_create(OMNIA_LOWDISC_MAX_DIMENSIONS + 1) != NULL))
+        ++errcnt;
+
+    free(a);
+    free(b);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_halton_scrambled(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    const size_t dims = 200;
+    double * a = (double *)malloc(sizeof(double) * dims * TEST_SIZE);
+    double * b = (double *)malloc(sizeof(double) * dims * TEST_SIZE);
+    omnia_halton_t * h1 = omnia_halton_create_scrambled(dims, 7);
+    omnia_halton_t * h2 = omnia_halton_create_scrambled(dims, 7);
+    omnia_halton_t * h3 = omnia_halton_create_scrambled(dims, 8);
+
+    omnia_halton_fill(h1, a, TEST_SIZE);
+
+    // scrambling each digit with a bijection keeps the stratification
+    if (!stratified(a, dims, 0, 1024, 1024) || !stratified(a, dims, 1, 729, 729)
+    ||  !stratified(a, dims, 2, 625, 625) || !stratified(a, dims, dims - 1, TEST_SIZE, 1223))
+        ++errcnt;
+
+    for (size_t i = 0; i < dims * TEST_SIZE; ++i)
+        if ((a[i] < 0.0) || (a[i] >= 1.0))
+            ++errcnt;
+
+    omnia_halton_seek(h2, 100);
+    omnia_halton_fill(h2, b, TEST_SIZE - 100);
+
+    if (memcmp(a + 100 * dims, b, sizeof(double) * dims * (TEST_SIZE - 100)) != 0)
+        ++errcnt;
+
+    omnia_halton_fill(h3, b, TEST_SIZE);
+
+    if (memcmp(a, b, sizeof(double) * dims * TEST_SIZE) == 0)
+        ++errcnt;
+
+    if (verbose)
+        printf("scrambled halton: %d error(s)\n", (int)errcnt);
+
+    omnia_halton_free(h1);
+    omnia_halton_free(h2);
+    omnia_halton_free(h3);
+    free(a);
+    free(b);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_sobol(verbose);
+    errcnt += test_sobol_scrambled(verbose);
+    errcnt += test_halton(verbose);
+    errcnt += test_halton_scrambled(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
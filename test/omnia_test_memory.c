@@ -0,0 +1,273 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// counts calls through the counting allocator
+static size_t allocations = 0;
+static size_t releases = 0;
+
+static void * counting_allocate(const size_t size, const size_t alignment, void * context)
+{
+    void * block = NULL;
+
+    ++allocations;
+
+    if (posix_memalign(&block, alignment, size) != 0)
+        return NULL;
+
+    return block;
+}
+
+static void counting_release(void * block, void * context)
+{
+    ++releases;
+    free(block);
+}
+
+int test_allocator(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    const omnia_allocator_t counting = { counting_allocate, counting_release, NULL };
+
+    // the default aligns, and its blocks can go to free
+    double * a = (double *)omnia_alloc(sizeof(double) * 10);
+
+    if ((a == NULL) || (((uintptr_t)a % OMNIA_ALIGNMENT) != 0))
+        ++errcnt;
+
+    free(a);
+
+    // library objects come from the installed allocator
+    omnia_set_allocator(&counting);
+
+    omnia_fft_plan_t * plan = omnia_fft_plan_create(64);
+    double * stats = omnia_basic_stats((const double[]){ 1.0, 2.0, 3.0 }, 3);
+
+    if ((plan == NULL) || (stats == NULL) || (allocations != 5))
+        ++errcnt;
+
+    omnia_fft_plan_free(plan);
+    omnia_free(stats);
+
+    if (releases != allocations)
+        ++errcnt;
+
+    if (verbose)
+        printf("counting allocator: %zu allocations, %zu releases\n", allocations, releases);
+
+    // NULL restores the default
+    omnia_set_allocator(NULL);
+
+    a = (double *)omnia_alloc(sizeof(double));
+    omnia_free(a);
+
+    if ((allocations != 5) || (omnia_get_allocator().allocate == counting_allocate))
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_arena(bool verbose)
+{
+    static const size_t ARENA_SIZE = 4096;
+
+    // counts errors
+    size_t errcnt = 0;
+
+    unsigned char * buffer = malloc(ARENA_SIZE);
+    omnia_arena_t arena;
+
+    if (!omnia_arena_init(&arena, buffer, ARENA_SIZE) || omnia_arena_init(NULL, buffer, ARENA_SIZE))
+        ++errcnt;
+
+    const omnia_allocator_t allocator = omnia_arena_allocator(&arena);
+    omnia_set_allocator(&allocator);
+
+    // blocks are aligned and consecutive
+    void * a = omnia_alloc(10);
+    void * b = omnia_alloc(100);
+
+    if ((a == NULL) || (b == NULL) || (((uintptr_t)a % OMNIA_ALIGNMENT) != 0) || (((uintptr_t)b % OMNIA_ALIGNMENT) != 0) || (b <= a))
+        ++errcnt;
+
+    // releasing does nothing; exhaustion returns NULL
+    omnia_free(a);
+
+    if (omnia_alloc(ARENA_SIZE) != NULL)
+        ++errcnt;
+
+    // resetting reclaims everything
+    omnia_arena_reset(&arena);
+
+    if (omnia_alloc(16) != a)
+        ++errcnt;
+
+    // a whole loop of allocating calls runs inside the arena
+    omnia_arena_reset(&arena);
+
+    for (int pass = 0; pass < 100; ++pass)
+    {
+        static const omnia_wave_factor_t factors[] = { { 10.0, 1.0 } };
+
+        double * signal = omnia_make_sinusoid(factors, 1, 64);
+        double * stats = omnia_basic_stats(signal, 64);
+
+        if ((signal == NULL) || (stats == NULL) || ((unsigned char *)signal < buffer) || ((unsigned char *)signal >= buffer + ARENA_SIZE))
+            ++errcnt;
+
+        omnia_arena_reset(&arena);
+    }
+
+    if (verbose)
+        printf("arena: %zu of %zu bytes in use after reset\n", arena.used, arena.size);
+
+    omnia_set_allocator(NULL);
+    free(buffer);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_into(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 1000;
+    static const size_t DISTANCE = 3;
+
+    static const omnia_wave_factor_t factors[] = { { 10.0, 1.0 }, { 33.0, 0.5 } };
+
+    double * data = malloc(sizeof(double) * TEST_SIZE);
+    double * result = malloc(sizeof(double) * TEST_SIZE);
+
+    // counts errors
+    size_t i, errcnt = 0;
+
+    uint64_t seed[2] = { 16180, 33988 };
+    omnia_xs128p_set_seed(seed);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+        data[i] = omnia_xs128p_real();
+
+    // moving average against a direct sum over each window
+    double worst = 0.0;
+
+    if (!omnia_moving_average_into(data, TEST_SIZE, DISTANCE, result))
+        ++errcnt;
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        const size_t first = (i > DISTANCE) ? i - DISTANCE : 0;
+        const size_t last = (i + DISTANCE < TEST_SIZE) ? i + DISTANCE : TEST_SIZE - 1;
+        double sum = 0.0;
+
+        for (size_t k = first; k <= last; ++k)
+            sum += data[k];
+
+        worst = fmax(worst, fabs(result[i] - sum / (double)(last - first + 1)));
+    }
+
+    if (verbose)
+        printf("moving average: largest error = %g\n", worst);
+
+    if (worst > 1e-12)
+        ++errcnt;
+
+    // a large value leaving the window does not disturb the windows after it
+    static const double spike[8] = { 1e20, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+    double spiked[8];
+
+    if (!omnia_moving_average_into(spike, 8, 1, spiked))
+        ++errcnt;
+
+    for (i = 2; i < 8; ++i)
+    {
+        if (spiked[i] != 1.0)
+            ++errcnt;
+    }
+
+    if ((spiked[0] != 5e19) || (fabs(spiked[1] - 1e20 / 3.0) > 1e5))
+        ++errcnt;
+
+    // the allocating forms match
+    double * average = omnia_moving_average(data, (int)TEST_SIZE, (int)DISTANCE);
+
+    if ((average == NULL) || (memcmp(average, result, sizeof(double) * TEST_SIZE) != 0))
+        ++errcnt;
+
+    omnia_free(average);
+
+    double stats[3];
+    double * allocated = omnia_basic_stats(data, TEST_SIZE);
+
+    if (!omnia_basic_stats_into(data, TEST_SIZE, stats) || (allocated == NULL) || (memcmp(allocated, stats, sizeof(stats)) != 0))
+        ++errcnt;
+
+    // a uniform distribution has variance 1/12
+    if ((fabs(stats[0] - 0.5) > 0.05) || (fabs(stats[1] - 1.0 / 12.0) > 0.01))
+        ++errcnt;
+
+    omnia_free(allocated);
+
+    double * signal = omnia_make_sinusoid(factors, 2, TEST_SIZE);
+
+    if (!omnia_make_sinusoid_into(factors, 2, result, TEST_SIZE) || (signal == NULL) || (memcmp(signal, result, sizeof(double) * TEST_SIZE) != 0))
+        ++errcnt;
+
+    if (fabs(result[5] - (sin(5.0 * OMNIA_PI / 10.0) + 0.5 * sin(5.0 * OMNIA_PI / 33.0))) > 1e-15)
+        ++errcnt;
+
+    omnia_free(signal);
+
+    // invalid arguments
+    if (omnia_moving_average_into(NULL, TEST_SIZE, 1, result) || omnia_basic_stats_into(data, 0, stats) || omnia_make_sinusoid_into(factors, 0, result, TEST_SIZE))
+        ++errcnt;
+
+    free(data);
+    free(result);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_allocator(verbose);
+    errcnt += test_arena(verbose);
+    errcnt += test_into(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
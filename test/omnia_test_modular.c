@@ -0,0 +1,212 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <string.h>
+
+int test_extended(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 10000;
+
+    // counts errors
+    size_t i, errcnt = 0;
+
+    uint64_t seed[2] = { 27182, 81828 };
+    omnia_xs128p_set_seed(seed);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        const uint64_t f = (omnia_xs128p_next() >> 48) + 1;
+        const uint64_t a = (omnia_xs128p_next() >> (i % 48)) * f;
+        const uint64_t b = (omnia_xs128p_next() >> (i % 32)) * f;
+        int64_t x, y;
+
+        const uint64_t g = omnia_gcf_extended(a, b, &x, &y);
+
+        // the identity holds exactly, so it also holds mod 2^64
+        if ((g != omnia_gcf(a, b)) || (a * (uint64_t)x + b * (uint64_t)y != g))
+            ++errcnt;
+
+        // inverses, where they exist
+        const uint64_t m = b | 1;
+        const uint64_t inv = omnia_modinv(a, m);
+
+        if (omnia_gcf(a, m) == 1)
+        {
+            if ((m > 1) && (omnia_mulmod(a, inv, m) != 1))
+                ++errcnt;
+        }
+        else if (inv != 0)
+            ++errcnt;
+    }
+
+    if (verbose)
+        printf("extended gcf and modinv: %lu error(s) in %lu random pairs\n", (unsigned long)errcnt, (unsigned long)TEST_SIZE);
+
+    if (omnia_modinv(3, 7) != 5)
+        ++errcnt;
+
+    if ((omnia_modinv(4, 8) != 0) || (omnia_modinv(5, 1) != 0))
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_powmod(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 5;
+
+    static const uint64_t base[] =
+    {
+        2, 3, 2, UINT64_C(123456789), 7
+    };
+
+    static const uint64_t exponent[] =
+    {
+        10, 200, UINT64_C(1000000000000000000), UINT64_C(987654321), 13
+    };
+
+    static const uint64_t modulus[] =
+    {
+        1000, 1000000007, UINT64_C(18446744073709551557), UINT64_C(0x8000000000000000), 1
+    };
+
+    static const uint64_t expected[] =
+    {
+        24, 136318165, UINT64_C(15194517888737919093), UINT64_C(2707128288486860373), 0
+    };
+
+    // counts errors
+    size_t i, errcnt = 0;
+    uint64_t result;
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        result = omnia_powmod(base[i], exponent[i], modulus[i]);
+
+        if (verbose)
+            printf("powmod(%lu,%lu,%lu) = %lu (should be %lu)\n",
+                    (unsigned long)base[i],
+                    (unsigned long)exponent[i],
+                    (unsigned long)modulus[i],
+                    (unsigned long)result,
+                    (unsigned long)expected[i]);
+
+        if (result != expected[i])
+            ++errcnt;
+    }
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_montgomery(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 1003;
+
+    uint64_t a[TEST_SIZE], b[TEST_SIZE], r[TEST_SIZE];
+    omnia_montgomery_t ctx;
+
+    // counts errors
+    size_t i, t, errcnt = 0;
+
+    if (omnia_montgomery_init(&ctx, 0))
+        ++errcnt;
+
+    for (t = 0; t < 8; ++t)
+    {
+        // odd and even moduli of various sizes, including 2^64 - 1
+        const uint64_t m = (t == 0) ? UINT64_MAX : ((omnia_xs128p_next() >> (t * 7)) & ~UINT64_C(1)) | 2 | (t & 1);
+        size_t bad = 0;
+
+        omnia_montgomery_init(&ctx, m);
+
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            a[i] = omnia_xs128p_next();
+            b[i] = omnia_xs128p_next();
+        }
+
+        omnia_montgomery_mul_array(&ctx, a, b, r, TEST_SIZE);
+
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            if (r[i] != omnia_mulmod(a[i], b[i], m))
+                ++bad;
+        }
+
+        // a^3 computed two ways
+        omnia_montgomery_pow_array(&ctx, a, 3, r, TEST_SIZE);
+
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            const uint64_t square = omnia_mulmod(a[i], a[i], m);
+
+            if (r[i] != omnia_mulmod(square, a[i], m))
+                ++bad;
+        }
+
+        if (verbose)
+            printf("montgomery(%s modulus %lu): %lu error(s)\n", (m & 1) ? "odd" : "even", (unsigned long)m, (unsigned long)bad);
+
+        errcnt += bad;
+    }
+
+    // Fermat's little theorem for the largest 64-bit prime
+    omnia_montgomery_init(&ctx, UINT64_C(18446744073709551557));
+
+    for (i = 0; i < TEST_SIZE; ++i)
+        a[i] = omnia_xs128p_next() | 1;
+
+    omnia_montgomery_pow_array(&ctx, a, UINT64_C(18446744073709551556), a, TEST_SIZE);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        if (a[i] != 1)
+            ++errcnt;
+    }
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_extended(verbose);
+    errcnt += test_powmod(verbose);
+    errcnt += test_montgomery(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -0,0 +1,235 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define TEST_SIZE 10000
+
+// x * y over the unit square; the integral is 1/4
+static double product(const double * point, void * data)
+{
+    (void)data;
+    return point[0] * point[1];
+}
+
+static void product_batch(const double * points, double * values, const size_t n, void * data)
+{
+    (void)data;
+
+    for (size_t i = 0; i < n; ++i)
+        values[i] = points[2 * i] * points[2 * i + 1];
+}
+
+static double constant(const double * point, void * data)
+{
+    (void)point;
+    return *(const double *)data;
+}
+
+// relative difference, for comparing sums formed in different orders
+static double rel_diff(const double a, const double b)
+{
+    return fabs(a - b) / fmax(fabs(b), 1e-300);
+}
+
+// identical results, field by field
+static bool same_result(const omnia_mc_result_t * a, const omnia_mc_result_t * b)
+{
+    return (a->estimate == b->estimate) && (a->error == b->error) && (a->variance == b->variance)
+        && (a->samples == b->samples) && (a->converged == b->converged);
+}
+
+int test_running_stats(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    double * data = (double *)malloc(sizeof(double) * TEST_SIZE);
+    double basic[3];
+
+    omnia_xs128p_t rng = { { 0x0123456789abcdefULL, 0xfedcba9876543210ULL } };
+
+    // a large offset makes the naive sum-of-squares formula fail
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        data[i] = 1.0e9 + (double)(omnia_xs128p_next_r(&rng) >> 11) * 0x1.0p-53;
+
+    omnia_basic_stats_into(data, TEST_SIZE, basic);
+
+    const double expected = basic[1] * TEST_SIZE / (TEST_SIZE - 1);
+
+    omnia_running_stats_t one, array, merged, half;
+
+    omnia_running_stats_init(&one);
+    omnia_running_stats_init(&array);
+    omnia_running_stats_init(&merged);
+    omnia_running_stats_init(&half);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        omnia_running_stats_add(&one, data[i]);
+
+    omnia_running_stats_add_array(&array, data, TEST_SIZE);
+
+    omnia_running_stats_add_array(&merged, data, 3000);
+    omnia_running_stats_add_array(&half, data + 3000, TEST_SIZE - 3000);
+    omnia_running_stats_merge(&merged, &half);
+
+    const omnia_running_stats_t * all[3] = { &one, &array, &merged };
+
+    for (size_t k = 0; k < 3; ++k)
+    {
+        if ((all[k]->count != TEST_SIZE) || (rel_diff(all[k]->mean, basic[0]) > 1e-14)
+        ||  (rel_diff(omnia_running_stats_variance(all[k]), expected) > 1e-6))
+        {
+            if (verbose)
+                printf("running stats %zu: mean %.17g, variance %.17g; expected %.17g, %.17g\n", k, all[k]->mean, omnia_running_stats_variance(all[k]), basic[0], expected);
+
+            ++errcnt;
+        }
+    }
+
+    // uniform values have variance 1/12
+    if (fabs(omnia_running_stats_variance(&one) - 1.0 / 12.0) > 0.005)
+        ++errcnt;
+
+    if (fabs(omnia_running_stats_error(&one) - sqrt(omnia_running_stats_variance(&one) / TEST_SIZE)) > 1e-15)
+        ++errcnt;
+
+    omnia_running_stats_init(&one);
+    omnia_running_stats_add(&one, 1.0);
+
+    if (!isnan(omnia_running_stats_variance(&one)))
+        ++errcnt;
+
+    free(data);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_integrate(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    omnia_mc_options_t options;
+    omnia_mc_result_t r1, r2, r3;
+
+    omnia_mc_options_init(&options, 2);
+    options.target_error = 1.0e-3;
+
+    if (!omnia_mc_integrate(&options, product, NULL, &r1))
+        return 1;
+
+    if (verbose)
+        printf("x * y: %.6f +/- %.6f from %llu samples\n", r1.estimate, r1.error, (unsigned long long)r1.samples);
+
+    if (!r1.converged || (r1.error > 1.0e-3) || (fabs(r1.estimate - 0.25) > 5.0 * r1.error))
+        ++errcnt;
+
+    // the variance of x * y is 7/144
+    if (fabs(r1.variance - 7.0 / 144.0) > 0.005)
+        ++errcnt;
+
+    // the same samples whatever the number of threads, and in batches
+    omnia_set_threads(4);
+    omnia_mc_integrate(&options, product, NULL, &r2);
+    omnia_set_threads(1);
+    omnia_mc_integrate_batch(&options, product_batch, NULL, &r3);
+    omnia_set_threads(0);
+
+    if (!same_result(&r1, &r2) || !same_result(&r1, &r3))
+    {
+        if (verbose)
+            printf("results depend on threads or batching\n");
+
+        ++errcnt;
+    }
+
+    // another seed gives other samples
+    options.seed += 1;
+    omnia_mc_integrate(&options, product, NULL, &r2);
+
+    if (r2.estimate == r1.estimate)
+        ++errcnt;
+
+    // without a target, exactly max_samples
+    options.target_error = 0.0;
+    options.max_samples = 1000;
+    omnia_mc_integrate(&options, product, NULL, &r2);
+
+    if ((r2.samples != 1000) || r2.converged)
+        ++errcnt;
+
+    // a tighter target than max_samples allows
+    options.target_error = 1.0e-6;
+    options.max_samples = 100000;
+    omnia_mc_integrate(&options, product, NULL, &r2);
+
+    if ((r2.samples != 100000) || r2.converged)
+        ++errcnt;
+
+    // a constant converges at once, but not before min_samples
+    double value = 3.0;
+
+    omnia_mc_options_init(&options, 5);
+    options.target_error = 1.0e-3;
+    options.min_samples = 50000;
+    omnia_mc_integrate(&options, constant, &value, &r2);
+
+    if ((r2.estimate != 3.0) || (r2.variance != 0.0) || !r2.converged || (r2.samples < 50000) || (r2.samples > 100000))
+        ++errcnt;
+
+    // invalid arguments
+    options.dims = 0;
+
+    if (omnia_mc_integrate(&options, constant, &value, &r2))
+        ++errcnt;
+
+    options.dims = 5;
+
+    if (omnia_mc_integrate(&options, NULL, &value, &r2) || omnia_mc_integrate_batch(&options, NULL, &value, &r2)
+    ||  omnia_mc_integrate(NULL, constant, &value, &r2) || omnia_mc_integrate(&options, constant, &value, NULL))
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_running_stats(verbose);
+    errcnt += test_integrate(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -0,0 +1,332 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define TEST_SIZE 1000000
+
+// counts how often each element is visited, and which chunks were seen
+typedef struct
+{
+    unsigned char * visits;
+    size_t chunks;
+    size_t bad_chunks;
+}
+cover_t;
+
+static void cover_range(const size_t begin, const size_t end, void * data)
+{
+    cover_t * c = (cover_t *)data;
+
+    for (size_t i = begin; i < end; ++i)
+        ++c->visits[i];
+
+    if ((begin % omnia_get_grain() != 0) || ((end - begin > omnia_get_grain())))
+        __atomic_add_fetch(&c->bad_chunks, 1, __ATOMIC_RELAXED);
+
+    __atomic_add_fetch(&c->chunks, 1, __ATOMIC_RELAXED);
+}
+
+// starts a loop from inside a loop
+static void nested_range(const size_t begin, const size_t end, void * data)
+{
+    cover_t * c = (cover_t *)data;
+    cover_t inner = { c->visits + begin, 0, 0 };
+
+    omnia_parallel_for(end - begin, cover_range, &inner);
+    __atomic_add_fetch(&c->chunks, inner.chunks, __ATOMIC_RELAXED);
+}
+
+int test_parallel_for(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    static const size_t THREADS[] = { 1, 2, 3, 8 };
+    static const size_t SIZES[] = { 1, 999, 1000, 1001, 100000 };
+
+    unsigned char * visits = (unsigned char *)malloc(TEST_SIZE);
+
+    if (visits == NULL)
+        return 1;
+
+    omnia_set_grain(1000);
+
+    if (omnia_get_grain() != 1000)
+        ++errcnt;
+
+    // every element is visited exactly once, in whole chunks, for any thread count
+    for (size_t t = 0; t < sizeof(THREADS) / sizeof(THREADS[0]); ++t)
+    {
+        omnia_set_threads(THREADS[t]);
+
+        if (omnia_get_threads() != THREADS[t])
+            ++errcnt;
+
+        for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); ++s)
+        {
+            const size_t n = SIZES[s];
+            cover_t c = { visits, 0, 0 };
+
+            memset(visits, 0, n + 1);
+            omnia_parallel_for(n, cover_range, &c);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (visits[i] != 1)
+                {
+                    ++errcnt;
+                    break;
+                }
+            }
+
+            if ((visits[n] != 0) || (c.chunks != (n + 999) / 1000) || (c.bad_chunks != 0))
+                ++errcnt;
+        }
+
+        // nested loops run where they start
+        cover_t c = { visits, 0, 0 };
+
+        omnia_set_grain(10000);
+        memset(visits, 0, 100000);
+        omnia_parallel_for(100000, nested_range, &c);
+        omnia_set_grain(1000);
+
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            if (visits[i] != 1)
+            {
+                ++errcnt;
+                break;
+            }
+        }
+
+        if (verbose)
+            printf("%d thread(s): %d error(s) so far\n", (int)THREADS[t], (int)errcnt);
+    }
+
+    // defaults
+    omnia_set_threads(0);
+    omnia_set_grain(0);
+
+    if ((omnia_get_threads() < 1) || (omnia_get_grain() != 65536))
+        ++errcnt;
+
+    free(visits);
+
+    // return number of errors
+    return errcnt;
+}
+
+// reads and changes the thread setting from inside a loop
+static void setting_range(const size_t begin, const size_t end, void * data)
+{
+    size_t * wrong = (size_t *)data;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        const size_t threads = omnia_get_threads();
+
+        if ((threads != 4) && (threads != 3))
+            __atomic_add_fetch(wrong, 1, __ATOMIC_RELAXED);
+
+        if (i == 7)
+            omnia_set_threads(3);
+    }
+}
+
+// runs a loop of its own on another application thread
+static void * cover_thread(void * data)
+{
+    cover_t * c = (cover_t *)data;
+
+    for (int k = 0; k < 20; ++k)
+        omnia_parallel_for(TEST_SIZE / 2, cover_range, c);
+
+    return NULL;
+}
+
+int test_reentry(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    // the settings may be used inside a loop; a new thread count applies afterward
+    size_t wrong = 0;
+
+    omnia_set_threads(4);
+    omnia_set_grain(1);
+    omnia_parallel_for(16, setting_range, &wrong);
+
+    if ((wrong != 0) || (omnia_get_threads() != 3))
+        ++errcnt;
+
+    omnia_parallel_for(16, setting_range, &wrong);
+
+    if (wrong != 0)
+        ++errcnt;
+
+    // loops started by separate threads do not wait for each other
+    unsigned char * visits = (unsigned char *)malloc(TEST_SIZE);
+
+    if (visits == NULL)
+        return errcnt + 1;
+
+    cover_t c[2] = { { visits, 0, 0 }, { visits + TEST_SIZE / 2, 0, 0 } };
+    pthread_t other;
+
+    omnia_set_threads(0);
+    omnia_set_grain(1000);
+    memset(visits, 0, TEST_SIZE);
+
+    if (pthread_create(&other, NULL, cover_thread, &c[1]) != 0)
+        ++errcnt;
+    else
+    {
+        cover_thread(&c[0]);
+        pthread_join(other, NULL);
+
+        for (size_t i = 0; i < TEST_SIZE; ++i)
+        {
+            if (visits[i] != 20)
+            {
+                ++errcnt;
+                break;
+            }
+        }
+
+        if ((c[0].chunks != 20 * (TEST_SIZE / 2000)) || (c[1].chunks != 20 * (TEST_SIZE / 2000))
+        ||  (c[0].bad_chunks != 0) || (c[1].bad_chunks != 0))
+            ++errcnt;
+    }
+
+    omnia_set_grain(0);
+    free(visits);
+
+    if (verbose)
+        printf("reentry: %d error(s)\n", (int)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_kernels(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    double * data = (double *)malloc(sizeof(double) * TEST_SIZE);
+    double * single = (double *)malloc(sizeof(double) * TEST_SIZE);
+    double * multi = (double *)malloc(sizeof(double) * TEST_SIZE);
+    double stats1[3];
+    double stats4[3];
+
+    if ((data == NULL) || (single == NULL) || (multi == NULL))
+        return 1;
+
+    const omnia_wave_factor_t factors[2] = { { 100.0, 1.0 }, { 33.0, 0.5 } };
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        data[i] = sin((double)i * 0.001) + (double)(i % 7);
+
+    omnia_set_grain(10000);
+
+    // statistics and signals do not depend on the thread count
+    omnia_set_threads(1);
+    omnia_basic_stats_into(data, TEST_SIZE, stats1);
+    omnia_make_sinusoid_into(factors, 2, single, TEST_SIZE);
+
+    omnia_set_threads(4);
+    omnia_basic_stats_into(data, TEST_SIZE, stats4);
+    omnia_make_sinusoid_into(factors, 2, multi, TEST_SIZE);
+
+    if (memcmp(stats1, stats4, sizeof(stats1)) != 0)
+        ++errcnt;
+
+    if (memcmp(single, multi, sizeof(double) * TEST_SIZE) != 0)
+        ++errcnt;
+
+    // moving averages match a direct computation
+    const size_t distance = 50;
+
+    omnia_moving_average_into(data, TEST_SIZE, distance, multi);
+
+    for (size_t i = 0; i < TEST_SIZE; i += 997)
+    {
+        const size_t lo = (i > distance) ? i - distance : 0;
+        const size_t hi = (i + distance < TEST_SIZE) ? i + distance : TEST_SIZE - 1;
+        double sum = 0.0;
+
+        for (size_t j = lo; j <= hi; ++j)
+            sum += data[j];
+
+        if (fabs(multi[i] - sum / (double)(hi - lo + 1)) > 1e-9)
+            ++errcnt;
+    }
+
+    // noise stays within its bounds, and each chunk gets different noise
+    memset(multi, 0, sizeof(double) * TEST_SIZE);
+    omnia_add_noise(multi, TEST_SIZE, 0.5);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        if (fabs(multi[i]) > 0.5)
+            ++errcnt;
+    }
+
+    if (memcmp(multi, multi + 10000, sizeof(double) * 100) == 0)
+        ++errcnt;
+
+    if (verbose)
+        printf("mean %g variance %g\n", stats4[0], stats4[1]);
+
+    omnia_set_threads(0);
+    omnia_set_grain(0);
+
+    free(data);
+    free(single);
+    free(multi);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_parallel_for(verbose);
+    errcnt += test_reentry(verbose);
+    errcnt += test_kernels(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
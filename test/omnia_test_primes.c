@@ -0,0 +1,306 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// trial division, for reference
+static bool slow_is_prime(const uint64_t n)
+{
+    if (n < 2)
+        return false;
+
+    for (uint64_t d = 2; d * d <= n; ++d)
+    {
+        if (n % d == 0)
+            return false;
+    }
+
+    return true;
+}
+
+int test_is_prime(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 10;
+    static const size_t SMALL_SIZE = 200000;
+
+    static const uint64_t test_set[] =
+    {
+        UINT64_C(561),                      // Carmichael number
+        UINT64_C(3215031751),               // strong pseudoprime to bases 2, 3, 5 and 7
+        UINT64_C(3825123056546413051),      // strong pseudoprime to bases 2 through 37
+        UINT64_C(4294967291),               // largest 32-bit prime
+        UINT64_C(18446744073709551557),     // largest 64-bit prime
+        UINT64_C(18446744073709551615),     // 2^64 - 1
+        UINT64_C(18446744030759878681),     // square of the largest 32-bit prime
+        UINT64_C(2305843009213693951),      // Mersenne prime 2^61 - 1
+        UINT64_C(1000000000000000003),
+        UINT64_C(1000000000000000001)
+    };
+
+    static const bool expected[] =
+    {
+        false, false, false, true, true, false, false, true, true, false
+    };
+
+    bool results[TEST_SIZE];
+
+    // counts errors
+    size_t i, errcnt = 0;
+
+    omnia_is_prime_array(test_set, results, TEST_SIZE);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        if (verbose)
+            printf("is_prime(%lu) = %d (should be %d)\n",
+                    (unsigned long)test_set[i],
+                    (int)results[i],
+                    (int)expected[i]);
+
+        if (results[i] != expected[i])
+            ++errcnt;
+    }
+
+    // every small value
+    for (i = 0; i < SMALL_SIZE; ++i)
+    {
+        if (omnia_is_prime(i) != slow_is_prime(i))
+            ++errcnt;
+    }
+
+    if (verbose)
+        printf("is_prime: %lu error(s) in total\n", (unsigned long)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_factor(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 2000;
+
+    uint64_t factors[OMNIA_FACTOR_MAX];
+
+    // counts errors
+    size_t i, j, count, errcnt = 0;
+
+    // 2^64 - 1 = 3 * 5 * 17 * 257 * 641 * 65537 * 6700417
+    count = omnia_factor(UINT64_MAX, factors);
+
+    if (verbose)
+    {
+        printf("factor(2^64 - 1) =");
+
+        for (j = 0; j < count; ++j)
+            printf(" %lu", (unsigned long)factors[j]);
+
+        printf("\n");
+    }
+
+    if ((count != 7) || (factors[3] != 257) || (factors[6] != 6700417))
+        ++errcnt;
+
+    // a product of two large primes
+    count = omnia_factor(UINT64_C(4294967291) * UINT64_C(4294967279), factors);
+
+    if ((count != 2) || (factors[0] != UINT64_C(4294967279)) || (factors[1] != UINT64_C(4294967291)))
+        ++errcnt;
+
+    // a square of a prime above the trial division limit
+    count = omnia_factor(UINT64_C(1000003) * UINT64_C(1000003), factors);
+
+    if ((count != 2) || (factors[0] != UINT64_C(1000003)) || (factors[1] != UINT64_C(1000003)))
+        ++errcnt;
+
+    if ((omnia_factor(1, factors) != 0) || (omnia_factor(UINT64_C(1) << 63, factors) != 63))
+        ++errcnt;
+
+    // random values: the factors are prime, ascending, and multiply to the value
+    uint64_t seed[2] = { 16180, 33988 };
+    omnia_xs128p_set_seed(seed);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        const uint64_t n = omnia_xs128p_next() >> (i % 32);
+        uint64_t product = 1;
+        bool bad = false;
+
+        count = omnia_factor(n, factors);
+
+        for (j = 0; j < count; ++j)
+        {
+            product *= factors[j];
+
+            if (!omnia_is_prime(factors[j]) || ((j > 0) && (factors[j] < factors[j - 1])))
+                bad = true;
+        }
+
+        if (bad || ((n > 1) && (product != n)))
+            ++errcnt;
+    }
+
+    if (verbose)
+        printf("factor: %lu error(s) in total\n", (unsigned long)errcnt);
+
+    // return number of errors
+    return errcnt;
+}
+
+// checks a stream of primes against omnia_is_prime
+typedef struct
+{
+    uint64_t start;     // lowest value that may be delivered
+    uint64_t next;      // next value to be checked
+    uint64_t limit;     // end of the range
+    size_t   calls;     // number of batches received
+    size_t   max_calls; // stop after this many batches
+    size_t   errcnt;    // primes missed, repeated or misreported
+}
+stream_check_t;
+
+static bool check_batch(const uint64_t * primes, const size_t count, void * data)
+{
+    stream_check_t * check = (stream_check_t *)data;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (primes[i] < check->start)
+            ++check->errcnt;
+
+        // every value between the previous prime and this one is composite
+        for (; check->next < primes[i]; ++check->next)
+        {
+            if (omnia_is_prime(check->next))
+                ++check->errcnt;
+        }
+
+        if ((check->next != primes[i]) || !omnia_is_prime(primes[i]))
+            ++check->errcnt;
+
+        check->next = primes[i] + 1;
+    }
+
+    return ++check->calls < check->max_calls;
+}
+
+int test_sieve(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 8;
+
+    static const uint64_t limits[] =
+    {
+        0, 1, 2, 13, 17, 100, 1000000, 100000000
+    };
+
+    static const uint64_t expected[] =
+    {
+        0, 0, 1, 6, 7, 25, 78498, 5761455
+    };
+
+    // even starts just above a prime must not deliver that prime
+    static const uint64_t starts[] =
+    {
+        0, 1000, UINT64_C(1000000000000), 18, 24, 1497578
+    };
+
+    // counts errors
+    size_t i, t, errcnt = 0;
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        for (t = 1; t <= 4; t += 3)
+        {
+            const uint64_t result = omnia_prime_count(limits[i], t);
+
+            if (verbose)
+                printf("prime_count(%lu, %lu threads) = %lu (should be %lu)\n",
+                        (unsigned long)limits[i],
+                        (unsigned long)t,
+                        (unsigned long)result,
+                        (unsigned long)expected[i]);
+
+            if (result != expected[i])
+                ++errcnt;
+        }
+    }
+
+    // streams start at arbitrary values and arrive in order
+    for (i = 0; i < sizeof(starts) / sizeof(starts[0]); ++i)
+    {
+        stream_check_t check = { starts[i], starts[i], starts[i] + 3000000, 0, SIZE_MAX, 0 };
+
+        if (!omnia_sieve_primes(check.next, check.limit, check_batch, &check, 3))
+            ++errcnt;
+
+        // composites after the last prime
+        for (; check.next <= check.limit; ++check.next)
+        {
+            if (omnia_is_prime(check.next))
+                ++check.errcnt;
+        }
+
+        if (verbose)
+            printf("sieve_primes(%lu, %lu): %lu error(s) in %lu batches\n",
+                    (unsigned long)starts[i],
+                    (unsigned long)check.limit,
+                    (unsigned long)check.errcnt,
+                    (unsigned long)check.calls);
+
+        errcnt += check.errcnt;
+    }
+
+    // the callback can stop the sieve
+    stream_check_t check = { 0, 0, 0, 0, 2, 0 };
+
+    omnia_sieve_primes(0, 100000000, check_batch, &check, 4);
+
+    if (verbose)
+        printf("sieve_primes stopped after %lu batches (should be 2)\n", (unsigned long)check.calls);
+
+    if ((check.calls != 2) || (check.errcnt != 0))
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_is_prime(verbose);
+    errcnt += test_factor(verbose);
+    errcnt += test_sieve(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
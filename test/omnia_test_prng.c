@@ -0,0 +1,150 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_SIZE 1000
+
+int test_fill(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    uint64_t expected64[TEST_SIZE];
+    uint64_t result64[TEST_SIZE];
+    uint32_t expected32[TEST_SIZE];
+    uint32_t result32[TEST_SIZE];
+
+    // each fill must continue the sequence exactly where next would
+    const uint64_t seed[2] = { 12345678901ULL, 98765432109ULL };
+
+    omnia_xs128p_set_seed(seed);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        expected64[i] = omnia_xs128p_next();
+
+    omnia_xs128p_set_seed(seed);
+    omnia_xs128p_fill(result64, TEST_SIZE / 2);
+    omnia_xs128p_fill(result64 + TEST_SIZE / 2, TEST_SIZE / 2);
+
+    if (memcmp(expected64, result64, sizeof(expected64)) != 0)
+    {
+        if (verbose)
+            printf("xs128p fill differs from next\n");
+
+        ++errcnt;
+    }
+
+    omnia_kiss64_set_seed(seed[0]);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        expected64[i] = omnia_kiss64_next();
+
+    omnia_kiss64_set_seed(seed[0]);
+    omnia_kiss64_fill(result64, 1);
+    omnia_kiss64_fill(result64 + 1, TEST_SIZE - 1);
+
+    if (memcmp(expected64, result64, sizeof(expected64)) != 0)
+    {
+        if (verbose)
+            printf("kiss64 fill differs from next\n");
+
+        ++errcnt;
+    }
+
+    omnia_kiss32_set_seed((uint32_t)seed[1]);
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+        expected32[i] = omnia_kiss32_next();
+
+    omnia_kiss32_set_seed((uint32_t)seed[1]);
+    omnia_kiss32_fill(result32, TEST_SIZE - 1);
+    result32[TEST_SIZE - 1] = omnia_kiss32_next();
+
+    if (memcmp(expected32, result32, sizeof(expected32)) != 0)
+    {
+        if (verbose)
+            printf("kiss32 fill differs from next\n");
+
+        ++errcnt;
+    }
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_jump(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    // reference from raising the 128-bit transition matrix to the 2^64 power
+    const uint64_t seed[2] = { 1, 2 };
+    static const uint64_t EXPECTED = 0xe0779a2aa6946409ULL;
+
+    omnia_xs128p_set_seed(seed);
+    omnia_xs128p_jump();
+
+    const uint64_t value = omnia_xs128p_next();
+
+    if (value != EXPECTED)
+        ++errcnt;
+
+    if (verbose)
+        printf("after jump: %016llx, expected %016llx\n", (unsigned long long)value, (unsigned long long)EXPECTED);
+
+    // jumped streams do not start alike
+    uint64_t a[TEST_SIZE];
+    uint64_t b[TEST_SIZE];
+
+    omnia_xs128p_set_seed(seed);
+    omnia_xs128p_fill(a, TEST_SIZE);
+    omnia_xs128p_set_seed(seed);
+    omnia_xs128p_jump();
+    omnia_xs128p_jump();
+    omnia_xs128p_fill(b, TEST_SIZE);
+
+    if (memcmp(a, b, sizeof(a)) == 0)
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_fill(verbose);
+    errcnt += test_jump(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -0,0 +1,154 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define TEST_SIZE 1000
+
+// calls omnia_exp_array on another thread
+static void * exp_thread(void * data)
+{
+    double * x = (double *)data;
+
+    omnia_exp_array(x, x, TEST_SIZE, OMNIA_ACCURACY_ULP);
+    return NULL;
+}
+
+int test_disabled(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    omnia_profile_entry_t entries[OMNIA_PROFILE_COUNT];
+    double x[TEST_SIZE] = { 0.0 };
+
+    // without profiling the API still works and reports nothing
+    omnia_exp_array(x, x, TEST_SIZE, OMNIA_ACCURACY_ULP);
+    omnia_profile_snapshot(entries);
+
+    for (size_t i = 0; i < OMNIA_PROFILE_COUNT; ++i)
+    {
+        if ((entries[i].name == NULL) || (entries[i].calls != 0) || (entries[i].elements != 0) || (entries[i].cycles != 0))
+            ++errcnt;
+    }
+
+    omnia_profile_reset();
+
+    if (verbose)
+        printf("profiling is not compiled in\n");
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_counters(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    omnia_profile_entry_t entries[OMNIA_PROFILE_COUNT];
+    double x[TEST_SIZE];
+    double y[TEST_SIZE];
+
+    for (size_t i = 0; i < TEST_SIZE; ++i)
+    {
+        x[i] = (double)i / TEST_SIZE;
+        y[i] = 1.0 - x[i];
+    }
+
+    omnia_profile_reset();
+
+    // two calls on this thread, one on another
+    omnia_exp_array(x, x, TEST_SIZE, OMNIA_ACCURACY_ULP);
+    omnia_exp_array(x, x, TEST_SIZE / 2, OMNIA_ACCURACY_1E7);
+
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, exp_thread, y) != 0)
+        return errcnt + 1;
+
+    pthread_join(thread, NULL);
+
+    omnia_sin_array(x, x, 10, OMNIA_ACCURACY_ULP);
+    omnia_profile_snapshot(entries);
+
+    const omnia_profile_entry_t * e = &entries[OMNIA_PROFILE_EXP_ARRAY];
+
+    if ((strcmp(e->name, "omnia_exp_array") != 0) || (e->calls != 3) || (e->elements != 2 * TEST_SIZE + TEST_SIZE / 2) || (e->cycles == 0))
+        ++errcnt;
+
+    // sin_array does not count as sincos_array
+    if ((entries[OMNIA_PROFILE_SIN_ARRAY].calls != 1) || (entries[OMNIA_PROFILE_SIN_ARRAY].elements != 10) || (entries[OMNIA_PROFILE_SINCOS_ARRAY].calls != 0))
+        ++errcnt;
+
+    if (verbose)
+    {
+        for (size_t i = 0; i < OMNIA_PROFILE_COUNT; ++i)
+        {
+            if (entries[i].calls != 0)
+                printf("%-32s %8llu calls %10llu elements %12llu cycles\n", entries[i].name, (unsigned long long)entries[i].calls,
+                       (unsigned long long)entries[i].elements, (unsigned long long)entries[i].cycles);
+        }
+    }
+
+    // a reset clears the counts of every thread, including exited ones
+    omnia_profile_reset();
+    omnia_profile_snapshot(entries);
+
+    for (size_t i = 0; i < OMNIA_PROFILE_COUNT; ++i)
+    {
+        if ((entries[i].calls != 0) || (entries[i].elements != 0) || (entries[i].cycles != 0))
+            ++errcnt;
+    }
+
+    // and counting resumes afterward
+    omnia_exp_array(x, x, 7, OMNIA_ACCURACY_ULP);
+    omnia_profile_snapshot(entries);
+
+    if ((entries[OMNIA_PROFILE_EXP_ARRAY].calls != 1) || (entries[OMNIA_PROFILE_EXP_ARRAY].elements != 7))
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    if (omnia_profile_enabled())
+        errcnt += test_counters(verbose);
+    else
+        errcnt += test_disabled(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -0,0 +1,192 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// true if r is num/den in lowest terms
+static bool is(const omnia_rational_t r, const int64_t num, const int64_t den)
+{
+    const omnia_rational_t n = omnia_rational_normalize(r);
+
+    return (n.num == num) && (n.den == den);
+}
+
+int test_arithmetic(bool verbose)
+{
+    // counts errors
+    size_t errcnt = 0;
+
+    omnia_rational_t a, b, r;
+
+    // the sign moves to the numerator
+    omnia_rational_set(&a, 6, -4);
+
+    if (verbose)
+        printf("6/-4 = %ld/%ld, normalized to %ld/%ld (should be -3/2)\n",
+                (long)a.num, (long)a.den,
+                (long)omnia_rational_normalize(a).num, (long)omnia_rational_normalize(a).den);
+
+    if (!is(a, -3, 2) || omnia_rational_set(&a, 1, 0))
+        ++errcnt;
+
+    omnia_rational_set(&a, 1, 3);
+    omnia_rational_set(&b, 1, 6);
+
+    if (!omnia_rational_add(a, b, &r) || !is(r, 1, 2))
+        ++errcnt;
+
+    omnia_rational_set(&b, 1, 2);
+
+    if (!omnia_rational_sub(a, b, &r) || !is(r, -1, 6))
+        ++errcnt;
+
+    omnia_rational_set(&a, 2, 3);
+    omnia_rational_set(&b, 3, 4);
+
+    if (!omnia_rational_mul(a, b, &r) || !is(r, 1, 2))
+        ++errcnt;
+
+    omnia_rational_set(&a, 1, 2);
+    omnia_rational_set(&b, -1, 4);
+
+    if (!omnia_rational_div(a, b, &r) || !is(r, -2, 1))
+        ++errcnt;
+
+    if (verbose)
+        printf("(1/2) / (-1/4) = %ld/%ld (should be -2/1)\n", (long)omnia_rational_normalize(r).num, (long)omnia_rational_normalize(r).den);
+
+    // division by zero
+    omnia_rational_set(&b, 0, 5);
+
+    if (omnia_rational_div(a, b, &r))
+        ++errcnt;
+
+    // a product that only fits once reduced
+    omnia_rational_set(&a, INT64_C(1) << 62, 3);
+    omnia_rational_set(&b, 3, INT64_C(1) << 62);
+
+    if (!omnia_rational_mul(a, b, &r) || (r.num != 1) || (r.den != 1))
+        ++errcnt;
+
+    // results that do not fit
+    omnia_rational_set(&a, INT64_MAX, 1);
+
+    if (omnia_rational_add(a, a, &r))
+        ++errcnt;
+
+    omnia_rational_set(&a, 1, INT64_C(1) << 62);
+    omnia_rational_set(&b, 1, 4);
+
+    if (omnia_rational_mul(a, b, &r))
+        ++errcnt;
+
+    // comparisons ignore representation
+    omnia_rational_set(&a, 2, 4);
+    omnia_rational_set(&b, 1, 2);
+
+    if (omnia_rational_compare(a, b) != 0)
+        ++errcnt;
+
+    omnia_rational_set(&b, -1, 2);
+
+    if ((omnia_rational_compare(a, b) != 1) || (omnia_rational_compare(b, a) != -1))
+        ++errcnt;
+
+    if (omnia_rational_to_double(a) != 0.5)
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_sum(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 50;
+
+    omnia_rational_t terms[TEST_SIZE], chain, sum;
+
+    // counts errors
+    size_t i, errcnt = 0;
+
+    // harmonic numbers
+    for (i = 0; i < TEST_SIZE; ++i)
+        omnia_rational_set(&terms[i], 1, (int64_t)i + 1);
+
+    omnia_rational_set(&chain, 0, 1);
+
+    for (i = 0; i < 40; ++i)
+    {
+        omnia_rational_add(chain, terms[i], &chain);
+        chain = omnia_rational_normalize(chain);
+    }
+
+    if (!omnia_rational_sum(terms, 40, &sum) || (omnia_rational_compare(sum, chain) != 0))
+        ++errcnt;
+
+    sum = omnia_rational_normalize(sum);
+
+    if (verbose)
+        printf("H(40) = %ld/%ld\n", (long)sum.num, (long)sum.den);
+
+    // the denominator of H(50) needs more than 64 bits
+    if (omnia_rational_sum(terms, 50, &sum))
+        ++errcnt;
+
+    // terms that cancel keep the common denominator small
+    for (i = 0; i < TEST_SIZE; ++i)
+        omnia_rational_set(&terms[i], (i & 1) ? -1 : 1, (int64_t)(i / 2) + 1);
+
+    if (!omnia_rational_sum(terms, TEST_SIZE, &sum) || !is(sum, 0, 1))
+        ++errcnt;
+
+    // many terms with one denominator
+    for (i = 0; i < TEST_SIZE; ++i)
+        omnia_rational_set(&terms[i], (int64_t)i, 7);
+
+    if (!omnia_rational_sum(terms, TEST_SIZE, &sum) || !is(sum, 175, 1))
+        ++errcnt;
+
+    if (verbose)
+        printf("sum of 0/7 through 49/7 = %ld/%ld (should be 175/1)\n", (long)omnia_rational_normalize(sum).num, (long)omnia_rational_normalize(sum).den);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_arithmetic(verbose);
+    errcnt += test_sum(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -18,6 +18,78 @@
 #include "../src/omnia.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+
+// compare the array functions against their scalar forms
+static size_t test_arrays()
+{
+    static const size_t TEST_SIZE = 100000;
+
+    double * x = malloc(sizeof(double) * TEST_SIZE);
+    double * r = malloc(sizeof(double) * TEST_SIZE);
+    size_t i, errcnt = 0;
+    uint16_t digits;
+
+    uint64_t seed[2] = { 20160404, 19570929 };
+    omnia_xs128p_set_seed(seed);
+
+    // wide range of magnitudes, halfway cases, powers of ten and specials
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        switch (i % 5)
+        {
+            case 0:
+                x[i] = (omnia_xs128p_real() - 0.5) * pow(10.0, (double)omnia_xs128p_range(0, 600) - 300.0);
+                break;
+            case 1:
+                x[i] = (double)omnia_xs128p_range(0, 2000) * 0.5 - 500.0;
+                break;
+            case 2:
+                x[i] = pow(10.0, (double)omnia_xs128p_range(0, 40) - 20.0);
+                break;
+            case 3:
+                x[i] = nextafter(pow(10.0, (double)omnia_xs128p_range(0, 40) - 20.0), 0.0);
+                break;
+            default:
+                x[i] = (omnia_xs128p_real() - 0.5) * 1e6;
+                break;
+        }
+    }
+
+    x[0] = 0.0;
+    x[1] = -0.0;
+    x[2] = INFINITY;
+    x[3] = 4.9e-324;
+    x[4] = 1.0e300;
+
+    omnia_round_nearest_array(x, r, TEST_SIZE);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        if (r[i] != omnia_round_nearest(x[i]))
+            ++errcnt;
+    }
+
+    for (digits = 1; digits <= 15; ++digits)
+    {
+        omnia_sigdig_array(x, r, TEST_SIZE, digits);
+
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            double s = omnia_sigdig(x[i], digits);
+
+            if ((r[i] != s) && !(isnan(r[i]) && isnan(s)))
+                ++errcnt;
+        }
+    }
+
+    printf("array mismatches = %d (should be 0)\n", errcnt);
+
+    free(x);
+    free(r);
+
+    return errcnt;
+}
 
 int main(int argc, char * argv[])
 {
@@ -51,7 +123,7 @@ int main(int argc, char * argv[])
     printf("sigdig(6.5,2)    = %15.8f (should be      6.50000000)\n", omnia_sigdig(6.5,2));
     printf("sigdig(-6.5,2)   = %15.8f (should be     -6.50000000)\n", omnia_sigdig(-6.5,2));
     printf("sigdig(17.5,2)   = %15.8f (should be     18.00000000)\n", omnia_sigdig(17.5,2));
-    printf("sigdig(-17.5,2)  = %15.8f (should be    -18.00000000)\n", omnia_sigdig(-17.5,2));
+    printf("sigdig(-17.5,2)  = %15.8f (should be    -18.00000000)\n\n", omnia_sigdig(-17.5,2));
 
-    return 0;
+    return test_arrays();
 }
@@ -0,0 +1,211 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int test_goertzel(bool verbose)
+{
+    // test data
+    static const size_t SIGNAL_SIZE = 4000;
+    static const size_t TEST_SIZE = 5;
+
+    static const omnia_wave_factor_t factors[] =
+    {
+        { 50.0, 1.0 }, { 20.0, 0.5 }, { 8.0, 0.25 }, { 25.0, 0.0 }, { 40.0, 0.0 }
+    };
+
+    double signal[SIGNAL_SIZE];
+    double amplitudes[TEST_SIZE];
+
+    // counts errors
+    size_t i, n, errcnt = 0;
+
+    // the first three waves are present, the last two are not
+    for (i = 0; i < SIGNAL_SIZE; ++i)
+    {
+        signal[i] = 0.0;
+
+        for (n = 0; n < TEST_SIZE; ++n)
+            signal[i] += factors[n].amplitude * sin(OMNIA_PI * (double)i / factors[n].wavelength);
+    }
+
+    if (!omnia_goertzel_waves(signal, SIGNAL_SIZE, factors, TEST_SIZE, amplitudes))
+        return 1;
+
+    for (n = 0; n < TEST_SIZE; ++n)
+    {
+        if (verbose)
+            printf("amplitude(%5.1f) = %10.8f (should be %10.8f)\n",
+                    factors[n].wavelength, amplitudes[n], factors[n].amplitude);
+
+        if (fabs(amplitudes[n] - factors[n].amplitude) > 1e-9)
+            ++errcnt;
+    }
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_peaks(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 16;
+    static const size_t MAX_PEAKS = 2;
+
+    static const double magnitude[] =
+    {
+        0.0, 1.0, 4.0, 1.0, 0.0, 0.5, 0.2, 0.1, 2.0, 3.0, 2.0, 0.1, 0.0, 6.0, 6.0, 0.0
+    };
+
+    static const double expected_bin[] = { 13.5, 2.0 };
+    static const double expected_mag[] = { 6.75, 4.0 };
+
+    omnia_spectral_peak_t peaks[MAX_PEAKS];
+
+    // counts errors
+    size_t i, errcnt = 0;
+
+    // flat-topped peak at 13/14, sharp peak at 2; smaller peaks are discarded
+    size_t found = omnia_find_peaks(magnitude, TEST_SIZE, 1.0, peaks, MAX_PEAKS);
+
+    if (found != MAX_PEAKS)
+        ++errcnt;
+
+    for (i = 0; i < found; ++i)
+    {
+        if (verbose)
+            printf("peak %d = %6.3f, %6.3f (should be %6.3f, %6.3f)\n", i,
+                    peaks[i].bin, peaks[i].magnitude, expected_bin[i], expected_mag[i]);
+
+        if ((fabs(peaks[i].bin - expected_bin[i]) > 1e-12) || (fabs(peaks[i].magnitude - expected_mag[i]) > 1e-12))
+            ++errcnt;
+    }
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_correlation(bool verbose)
+{
+    // test data
+    static const size_t SIGNAL_SIZE = 3000;
+    static const size_t TEST_SIZE = 3;
+    static const size_t max_lags[] = { 5, 1000, 4000 };
+
+    double * x = malloc(sizeof(double) * SIGNAL_SIZE);
+    double * y = malloc(sizeof(double) * SIGNAL_SIZE);
+    double * autocorr = malloc(sizeof(double) * 4001);
+    double * crosscorr = malloc(sizeof(double) * 8001);
+
+    // counts errors
+    size_t i, t, errcnt = 0;
+    ptrdiff_t k;
+
+    uint64_t seed[2] = { 314159, 271828 };
+    omnia_xs128p_set_seed(seed);
+
+    for (i = 0; i < SIGNAL_SIZE; ++i)
+    {
+        x[i] = sin(OMNIA_PI * (double)i / 30.0) + omnia_xs128p_real() - 0.5;
+        y[i] = omnia_xs128p_real() - 0.5;
+    }
+
+    // small lag counts use direct summation, large ones use the FFT
+    for (t = 0; t < TEST_SIZE; ++t)
+    {
+        const ptrdiff_t m = (ptrdiff_t)max_lags[t];
+        double worst = 0.0;
+
+        omnia_autocorrelation(x, SIGNAL_SIZE, max_lags[t], false, autocorr);
+        omnia_cross_correlation(x, y, SIGNAL_SIZE, max_lags[t], false, crosscorr);
+
+        for (k = -m; k <= m; ++k)
+        {
+            double sa = 0.0, sc = 0.0;
+
+            for (i = 0; i < SIGNAL_SIZE; ++i)
+            {
+                ptrdiff_t j = (ptrdiff_t)i + k;
+
+                if ((j >= 0) && (j < (ptrdiff_t)SIGNAL_SIZE))
+                {
+                    sa += x[i] * x[j];
+                    sc += x[i] * y[j];
+                }
+            }
+
+            if (k >= 0)
+                worst = fmax(worst, fabs(sa - autocorr[k]));
+
+            worst = fmax(worst, fabs(sc - crosscorr[m + k]));
+        }
+
+        if (verbose)
+            printf("correlation(max lag %4d): largest difference from direct sum = %g\n", max_lags[t], worst);
+
+        if (worst > 1e-9)
+            ++errcnt;
+    }
+
+    // a period of 60 samples shows up as a normalized peak at lag 60
+    omnia_autocorrelation(x, SIGNAL_SIZE, 100, true, autocorr);
+
+    size_t best = 30;
+
+    for (i = 30; i <= 100; ++i)
+        if (autocorr[i] > autocorr[best])
+            best = i;
+
+    if (verbose)
+        printf("autocorrelation peak at lag %d (should be 60)\n", best);
+
+    if ((best != 60) || (autocorr[0] != 1.0))
+        ++errcnt;
+
+    free(x);
+    free(y);
+    free(autocorr);
+    free(crosscorr);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_goertzel(verbose);
+    errcnt += test_peaks(verbose);
+    errcnt += test_correlation(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
@@ -18,21 +18,231 @@
 #include "../src/omnia.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-int main(int argc, char * argv[])
+// error of x relative to the reference, in units in the last place of the reference
+static double ulps(const double x, const long double ref)
+{
+    if ((long double)x == ref)
+        return 0.0;
+
+    int e;
+    frexpl(ref, &e);
+
+    return (double)(fabsl((long double)x - ref) / ldexpl(1.0L, e - 53));
+}
+
+// error relative to the reference
+static double relative(const double x, const long double ref)
 {
-    int i;
-    double a [] = { 1.0, 1.33333333333333333, 1.5 };
+    return (double)(fabsl((long double)x - ref) / fmaxl(fabsl(ref), 1.0e-300L));
+}
+
+// the functions under test, their array forms and their references
+typedef struct
+{
+    const char * name;
+    double (* scalar)(const double);
+    void (* array)(const double *, double *, const size_t, const omnia_accuracy_t);
+    long double (* reference)(long double);
+}
+function_t;
+
+static const function_t functions[] =
+{
+    { "asinh", omnia_asinh, omnia_asinh_array, asinhl },
+    { "acosh", omnia_acosh, omnia_acosh_array, acoshl },
+    { "atanh", omnia_atanh, omnia_atanh_array, atanhl }
+};
+
+// fill an array with arguments spread over the domain of a function
+static void fill_arguments(double * x, const size_t n, const size_t f)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double m = 0.5 + omnia_xs128p_real();
+        const int e = (int)(omnia_xs128p_next() % 80);
+
+        switch (f)
+        {
+            case 0:
+                // both signs, tiny to huge
+                x[i] = ldexp((i & 1) ? m : -m, e - 40 + ((i % 64) == 0 ? 900 : 0));
+                break;
+            case 1:
+                // just above one to huge
+                x[i] = (i & 1) ? 1.0 + ldexp(m, e - 60) : ldexp(m, e + 1 + ((i % 64) == 0 ? 900 : 0));
+                break;
+            default:
+                // both signs, tiny to just below one
+                x[i] = (i & 1) ? ldexp(m, -1 - e / 2) : -(1.0 - ldexp(m, -1 - e / 2));
+                break;
+        }
+    }
+}
+
+int test_scalar(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 100000;
+
+    double * x = malloc(sizeof(double) * TEST_SIZE);
+
+    // counts errors
+    size_t i, f, errcnt = 0;
+
+    uint64_t seed[2] = { 31415, 92653 };
+    omnia_xs128p_set_seed(seed);
+
+    for (f = 0; f < 3; ++f)
+    {
+        double worst = 0.0;
+
+        fill_arguments(x, TEST_SIZE, f);
+
+        for (i = 0; i < TEST_SIZE; ++i)
+            worst = fmax(worst, ulps(functions[f].scalar(x[i]), functions[f].reference(x[i])));
+
+        if (verbose)
+            printf("%s: largest error = %g ULP\n", functions[f].name, worst);
+
+        if (worst > 2.0)
+            ++errcnt;
+    }
+
+    // round trips, the original checks
+    const double a[] = { 1.0, 1.33333333333333333, 1.5 };
 
     for (i = 0; i < 3; ++i)
     {
-        printf("atanh(tanh(%11.8f)) = %11.8f\n",  a[i], omnia_atanh(tanh(a[i])));
-        printf("atanh(tanh(%11.8f)) = %11.8f\n", -a[i], omnia_atanh(tanh(-a[i])));
-        printf("asinh(sinh(%11.8f)) = %11.8f\n",  a[i], omnia_asinh(sinh(a[i])));
-        printf("asinh(sinh(%11.8f)) = %11.8f\n", -a[i], omnia_asinh(sinh(-a[i])));
-        printf("acosh(cosh(%11.8f)) = %11.8f\n",  a[i], omnia_acosh(cosh(a[i])));
-        printf("acosh(cosh(%11.8f)) = %11.8f\n", -a[i], omnia_acosh(cosh(-a[i])));
+        if ((fabs(omnia_atanh(tanh(a[i])) - a[i]) > 1e-12) || (fabs(omnia_atanh(tanh(-a[i])) + a[i]) > 1e-12))
+            ++errcnt;
+
+        if ((fabs(omnia_asinh(sinh(a[i])) - a[i]) > 1e-12) || (fabs(omnia_asinh(sinh(-a[i])) + a[i]) > 1e-12))
+            ++errcnt;
+
+        if ((fabs(omnia_acosh(cosh(a[i])) - a[i]) > 1e-12) || (fabs(omnia_acosh(cosh(-a[i])) - a[i]) > 1e-12))
+            ++errcnt;
+    }
+
+    // the naive formulas fail on these
+    if ((omnia_asinh(1e-20) != 1e-20) || (omnia_atanh(-1e-20) != -1e-20))
+        ++errcnt;
+
+    if ((omnia_asinh(-1e300) >= -690.0) || isinf(omnia_asinh(1e300)) || isinf(omnia_acosh(1e300)))
+        ++errcnt;
+
+    if (!isnan(omnia_acosh(0.5)) || !isnan(omnia_atanh(1.5)) || !isinf(omnia_atanh(-1.0)) || !isinf(omnia_asinh(-INFINITY)))
+        ++errcnt;
+
+    free(x);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_array(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 100000;
+    static const size_t SPECIAL_SIZE = 8;
+
+    static const char * names[] = { "ULP", "1E7", "1E4" };
+    static const double limits[] = { 2.0, 1.0e-7, 1.0e-4 };
+
+    static const double specials[] = { 0.0, -0.0, 1.0, -1.0, 2.0, INFINITY, -INFINITY, NAN };
+
+    double * x = malloc(sizeof(double) * TEST_SIZE);
+    double * r = malloc(sizeof(double) * TEST_SIZE);
+
+    // counts errors
+    size_t i, f, t, errcnt = 0;
+
+    uint64_t seed[2] = { 27182, 81828 };
+    omnia_xs128p_set_seed(seed);
+
+    for (f = 0; f < 3; ++f)
+    {
+        fill_arguments(x, TEST_SIZE, f);
+
+        for (t = 0; t < 3; ++t)
+        {
+            double worst = 0.0;
+
+            functions[f].array(x, r, TEST_SIZE, (omnia_accuracy_t)t);
+
+            for (i = 0; i < TEST_SIZE; ++i)
+            {
+                const long double ref = functions[f].reference(x[i]);
+                const double err = (t == 0) ? ulps(r[i], ref) : relative(r[i], ref);
+                worst = fmax(worst, err);
+            }
+
+            if (verbose)
+                printf("%s_array(%s): largest error = %g%s\n", functions[f].name, names[t], worst, (t == 0) ? " ULP" : "");
+
+            if (worst > limits[t])
+                ++errcnt;
+        }
+
+        // acosh just above one, where log1p passes on the error in its argument
+        if (f == 1)
+        {
+            for (i = 0; i < TEST_SIZE; ++i)
+                x[i] = 1.0 + ldexp(1.0 + omnia_xs128p_real(), -1 - (int)(i % 52));
+
+            x[0] = 1.0000004419128716;
+            functions[f].array(x, r, TEST_SIZE, OMNIA_ACCURACY_ULP);
+
+            double worst = 0.0;
+
+            for (i = 0; i < TEST_SIZE; ++i)
+                worst = fmax(worst, ulps(r[i], acoshl(x[i])));
+
+            if (verbose)
+                printf("acosh_array near one: largest error = %g ULP\n", worst);
+
+            if (worst > limits[0])
+                ++errcnt;
+        }
+
+        // special values, in place, match the scalar functions
+        memcpy(x, specials, sizeof(specials));
+        functions[f].array(x, x, SPECIAL_SIZE, OMNIA_ACCURACY_ULP);
+
+        for (i = 0; i < SPECIAL_SIZE; ++i)
+        {
+            const double ref = functions[f].scalar(specials[i]);
+
+            if (!((x[i] == ref) || (isnan(x[i]) && isnan(ref))))
+                ++errcnt;
+        }
+    }
+
+    free(x);
+    free(r);
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
     }
 
-    return 0;
+    errcnt += test_scalar(verbose);
+    errcnt += test_array(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
 }
@@ -0,0 +1,381 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// error of x relative to the reference, in units in the last place of the reference
+static double ulps(const double x, const double ref)
+{
+    if (x == ref)
+        return 0.0;
+
+    int e;
+    frexp(ref, &e);
+
+    return fabs(x - ref) / ldexp(1.0, e - 53);
+}
+
+// error relative to the reference; absolute near zero
+static double relative(const double x, const double ref)
+{
+    return fabs(x - ref) / fmax(fabs(ref), 1.0e-300);
+}
+
+int test_log(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 100000;
+    static const size_t SPECIAL_SIZE = 8;
+
+    static const char * names[] = { "ULP", "1E7", "1E4" };
+    static const double limits[] = { 1.0, 1.0e-7, 1.0e-4 };
+
+    double * x = malloc(sizeof(double) * TEST_SIZE);
+    double * r = malloc(sizeof(double) * TEST_SIZE);
+
+    // counts errors
+    size_t i, t, errcnt = 0;
+
+    uint64_t seed[2] = { 57721, 56649 };
+    omnia_xs128p_set_seed(seed);
+
+    // values across the whole exponent range, plus values near 1
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        if (i & 1)
+            x[i] = ldexp(0.5 + omnia_xs128p_real(), (int)(omnia_xs128p_next() % 2040) - 1020);
+        else
+            x[i] = 0.75 + 0.5 * omnia_xs128p_real();
+    }
+
+    for (t = 0; t < 3; ++t)
+    {
+        double worst = 0.0;
+
+        omnia_log_array(x, r, TEST_SIZE, (omnia_accuracy_t)t);
+
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            const double err = (t == 0) ? ulps(r[i], log(x[i])) : relative(r[i], log(x[i]));
+            worst = fmax(worst, err);
+        }
+
+        if (verbose)
+            printf("log_array(%s): largest error = %g%s\n", names[t], worst, (t == 0) ? " ULP" : "");
+
+        if (worst > limits[t])
+            ++errcnt;
+    }
+
+    // special values, in place
+    const double specials[] = { 0.0, -0.0, -1.0, INFINITY, NAN, 4.9e-324, 2.2e-308, 1.0 };
+
+    memcpy(x, specials, sizeof(specials));
+    omnia_log_array(x, x, SPECIAL_SIZE, OMNIA_ACCURACY_ULP);
+
+    for (i = 0; i < SPECIAL_SIZE; ++i)
+    {
+        const double ref = log(specials[i]);
+
+        if (!((x[i] == ref) || (isnan(x[i]) && isnan(ref))))
+            ++errcnt;
+    }
+
+    free(x);
+    free(r);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_exp(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 100000;
+    static const size_t SPECIAL_SIZE = 8;
+
+    static const char * names[] = { "ULP", "1E7", "1E4" };
+    static const double limits[] = { 1.0, 1.0e-7, 1.0e-4 };
+
+    double * x = malloc(sizeof(double) * TEST_SIZE);
+    double * r = malloc(sizeof(double) * TEST_SIZE);
+
+    // counts errors
+    size_t i, t, errcnt = 0;
+
+    uint64_t seed[2] = { 14142, 13562 };
+    omnia_xs128p_set_seed(seed);
+
+    // the whole range of normal results, plus small arguments
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        if (i & 1)
+            x[i] = 1416.0 * omnia_xs128p_real() - 708.0;
+        else
+            x[i] = 2.0 * omnia_xs128p_real() - 1.0;
+    }
+
+    for (t = 0; t < 3; ++t)
+    {
+        double worst = 0.0;
+
+        omnia_exp_array(x, r, TEST_SIZE, (omnia_accuracy_t)t);
+
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            const double err = (t == 0) ? ulps(r[i], exp(x[i])) : relative(r[i], exp(x[i]));
+            worst = fmax(worst, err);
+        }
+
+        if (verbose)
+            printf("exp_array(%s): largest error = %g%s\n", names[t], worst, (t == 0) ? " ULP" : "");
+
+        if (worst > limits[t])
+            ++errcnt;
+    }
+
+    // special values, in place
+    const double specials[] = { 0.0, -0.0, 710.0, -746.0, -720.0, INFINITY, -INFINITY, NAN };
+
+    memcpy(x, specials, sizeof(specials));
+    omnia_exp_array(x, x, SPECIAL_SIZE, OMNIA_ACCURACY_ULP);
+
+    for (i = 0; i < SPECIAL_SIZE; ++i)
+    {
+        const double ref = exp(specials[i]);
+
+        if (!((x[i] == ref) || (isnan(x[i]) && isnan(ref))))
+            ++errcnt;
+    }
+
+    free(x);
+    free(r);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_sincos(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 100000;
+    static const size_t SPECIAL_SIZE = 6;
+
+    static const char * names[] = { "ULP", "1E7", "1E4" };
+    static const double limits[] = { 1.0, 1.0e-7, 1.0e-4 };
+
+    double * x = malloc(sizeof(double) * TEST_SIZE);
+    double * s = malloc(sizeof(double) * TEST_SIZE);
+    double * c = malloc(sizeof(double) * TEST_SIZE);
+    double * r = malloc(sizeof(double) * TEST_SIZE);
+
+    // counts errors
+    size_t i, t, errcnt = 0;
+
+    uint64_t seed[2] = { 17320, 50807 };
+    omnia_xs128p_set_seed(seed);
+
+    // small arguments, a few periods, and the limit of fast reduction
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        switch (i % 3)
+        {
+            case 0:
+                x[i] = ldexp(omnia_xs128p_real() - 0.5, -(int)(omnia_xs128p_next() % 30));
+                break;
+            case 1:
+                x[i] = 200.0 * omnia_xs128p_real() - 100.0;
+                break;
+            default:
+                x[i] = 2.0e6 * omnia_xs128p_real() - 1.0e6;
+                break;
+        }
+    }
+
+    for (t = 0; t < 3; ++t)
+    {
+        double worst_sin = 0.0, worst_cos = 0.0;
+
+        omnia_sincos_array(x, s, c, TEST_SIZE, (omnia_accuracy_t)t);
+
+        for (i = 0; i < TEST_SIZE; ++i)
+        {
+            // the lower tiers bound the absolute error
+            if (t == 0)
+            {
+                worst_sin = fmax(worst_sin, ulps(s[i], sin(x[i])));
+                worst_cos = fmax(worst_cos, ulps(c[i], cos(x[i])));
+            }
+            else
+            {
+                worst_sin = fmax(worst_sin, fabs(s[i] - sin(x[i])));
+                worst_cos = fmax(worst_cos, fabs(c[i] - cos(x[i])));
+            }
+        }
+
+        if (verbose)
+            printf("sincos_array(%s): largest error = %g, %g%s\n", names[t], worst_sin, worst_cos, (t == 0) ? " ULP" : "");
+
+        if ((worst_sin > limits[t]) || (worst_cos > limits[t]))
+            ++errcnt;
+
+        // the single functions match sincos
+        omnia_sin_array(x, r, TEST_SIZE, (omnia_accuracy_t)t);
+
+        if (memcmp(r, s, sizeof(double) * TEST_SIZE) != 0)
+            ++errcnt;
+
+        omnia_cos_array(x, r, TEST_SIZE, (omnia_accuracy_t)t);
+
+        if (memcmp(r, c, sizeof(double) * TEST_SIZE) != 0)
+            ++errcnt;
+    }
+
+    // special values, in place
+    const double specials[] = { 0.0, -0.0, 1.0e7, -1.0e300, INFINITY, NAN };
+
+    memcpy(x, specials, sizeof(specials));
+    omnia_sincos_array(x, s, x, SPECIAL_SIZE, OMNIA_ACCURACY_ULP);
+
+    for (i = 0; i < SPECIAL_SIZE; ++i)
+    {
+        const double sref = sin(specials[i]);
+        const double cref = cos(specials[i]);
+
+        if (!((s[i] == sref) || (isnan(s[i]) && isnan(sref))))
+            ++errcnt;
+
+        if (!((x[i] == cref) || (isnan(x[i]) && isnan(cref))))
+            ++errcnt;
+    }
+
+    // sin(x) is x for tiny x, at every tier, keeping the sign of zero
+    const double tiny[] = { 0.0, -0.0, 4.9e-324, -2.2e-308, 1.0e-20, -7.0e-9 };
+
+    for (t = 0; t < 3; ++t)
+    {
+        omnia_sin_array(tiny, r, 6, (omnia_accuracy_t)t);
+
+        if (memcmp(r, tiny, sizeof(tiny)) != 0)
+            ++errcnt;
+    }
+
+    free(x);
+    free(s);
+    free(c);
+    free(r);
+
+    // return number of errors
+    return errcnt;
+}
+
+int test_log_base(bool verbose)
+{
+    // test data
+    static const size_t TEST_SIZE = 4;
+
+    static const double test_set[] =
+    {
+        0.5, 8.0, 1000.0, 0.001
+    };
+
+    static const double expected_log2[] =
+    {
+        -1.0, 3.0, 9.965784284662087, -9.965784284662087
+    };
+
+    static const double expected_db[] =
+    {
+        -3.010299956639812, 9.030899869919435, 30.0, -30.0
+    };
+
+    double r[TEST_SIZE];
+    omnia_log_base_t base2;
+
+    // counts errors
+    size_t i, errcnt = 0;
+
+    if (!omnia_log_base_init(&base2, 2.0) || omnia_log_base_init(&base2, 1.0) || omnia_log_base_init(&base2, -2.0))
+        ++errcnt;
+
+    omnia_log_base_init(&base2, 2.0);
+    omnia_log_base_array(&base2, test_set, r, TEST_SIZE, OMNIA_ACCURACY_ULP);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        const double scalar = omnia_log_base(&base2, test_set[i]);
+        const double old = omnia_log2base(test_set[i], 2.0);
+
+        if (verbose)
+            printf("log2(%g) = %.15g, %.15g, %.15g (should be %.15g)\n", test_set[i], r[i], scalar, old, expected_log2[i]);
+
+        if ((fabs(r[i] - expected_log2[i]) > 1e-14) || (fabs(scalar - expected_log2[i]) > 1e-14) || (fabs(old - expected_log2[i]) > 1e-14))
+            ++errcnt;
+    }
+
+    omnia_power_to_db_array(test_set, r, TEST_SIZE, OMNIA_ACCURACY_1E7);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        if (verbose)
+            printf("power_to_db(%g) = %.9f (should be %.9f)\n", test_set[i], r[i], expected_db[i]);
+
+        if (fabs(r[i] - expected_db[i]) > 1e-5)
+            ++errcnt;
+    }
+
+    omnia_amplitude_to_db_array(test_set, r, TEST_SIZE, OMNIA_ACCURACY_1E4);
+
+    for (i = 0; i < TEST_SIZE; ++i)
+    {
+        if (fabs(r[i] - 2.0 * expected_db[i]) > 1e-2)
+            ++errcnt;
+    }
+
+    // invalid bases
+    if (!isnan(omnia_log2base(8.0, 1.0)) || !isnan(omnia_log2base(8.0, -2.0)) || !isnan(omnia_log2base(-8.0, 2.0)))
+        ++errcnt;
+
+    // return number of errors
+    return errcnt;
+}
+
+int main(int argc, char * argv[])
+{
+    bool verbose = false;
+    size_t errcnt = 0;
+
+    if (argc > 1)
+    {
+        if (0 == strcmp(argv[1],"-v"))
+            verbose = true;
+    }
+
+    errcnt += test_log(verbose);
+    errcnt += test_log_base(verbose);
+    errcnt += test_exp(verbose);
+    errcnt += test_sincos(verbose);
+
+    if (verbose)
+        fprintf(stderr,"found %d error(s)\n",errcnt);
+
+    return errcnt;
+}
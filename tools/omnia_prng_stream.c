@@ -0,0 +1,269 @@
+/*
+    Omnia is a heterogeous collection of tools written in Standard C.
+
+    It is part of the author's Library of Interesting and Esoteric Oddities
+
+    Copyright 2016 Scott Robert Ladd. All rights reserved.
+
+    This is user-supported open source software. Its continued development
+    is dependent on financial support from the community. You can provide
+    funding by visiting the author's website at:
+
+        http://www.drakontos.com
+
+    You license the library under the Simplified BSD License (FreeBSD
+    License), the text of which is available at the website above.
+*/
+
+#include "../src/omnia.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+
+/*
+    Writes the raw output of a library generator to standard output, for
+    statistical test batteries that read a byte stream, for example
+
+        omnia_prng_stream -g xs128p | RNG_test stdin64
+
+    Values are generated a buffer at a time with the bulk fill functions
+    and written in native byte order with large unbuffered writes, so the
+    pipe rather than the generator is usually the limit. The stream ends
+    when the reader closes the pipe, or after the requested byte count.
+
+    Options:
+        -g name     generator: xs128p, xoshiro256ss, xoshiro256pp, pcg64,
+                    wyrand, kiss64 or kiss32 (default xs128p)
+        -s seed     seed; decimal, or hexadecimal with 0x (default 1)
+        -j count    jump ahead by count times the generator's jump distance
+                    first; not available for kiss64 and kiss32
+        -r          reverse the bits of each value
+        -n bytes    stop after this many bytes (default unlimited)
+
+    All but the KISS generators are run through their descriptors.
+*/
+
+// bytes generated and written at a time
+static const size_t BUFFER_SIZE = 1 << 20;
+
+typedef enum
+{
+    GENERATOR_DESCRIBED,
+    GENERATOR_KISS64,
+    GENERATOR_KISS32
+}
+generator_t;
+
+// expand one seed with SplitMix64, so that nearby seeds give unrelated streams
+static uint64_t splitmix64(uint64_t * state)
+{
+    uint64_t v = (*state += 0x9e3779b97f4a7c15ULL);
+
+    v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    v = (v ^ (v >> 27)) * 0x94d049bb133111ebULL;
+
+    return v ^ (v >> 31);
+}
+
+// reverse the bits in each 64-bit word
+static void reverse64(uint64_t * values, const size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint64_t v = values[i];
+
+        v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+        v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+        v = ((v >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((v & 0x0f0f0f0f0f0f0f0fULL) << 4);
+
+        values[i] = __builtin_bswap64(v);
+    }
+}
+
+// reverse the bits in each 32-bit word
+static void reverse32(uint32_t * values, const size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint32_t v = values[i];
+
+        v = ((v >> 1) & 0x55555555U) | ((v & 0x55555555U) << 1);
+        v = ((v >> 2) & 0x33333333U) | ((v & 0x33333333U) << 2);
+        v = ((v >> 4) & 0x0f0f0f0fU) | ((v & 0x0f0f0f0fU) << 4);
+
+        values[i] = __builtin_bswap32(v);
+    }
+}
+
+// fill the buffer with the next values from the generator
+static void generate(const generator_t generator, const omnia_generator_t * described, omnia_generator_state_t * state, void * buffer, const bool reverse)
+{
+    switch (generator)
+    {
+        case GENERATOR_DESCRIBED:
+            described->fill(state, (uint64_t *)buffer, BUFFER_SIZE / sizeof(uint64_t));
+            break;
+
+        case GENERATOR_KISS64:
+            omnia_kiss64_fill((uint64_t *)buffer, BUFFER_SIZE / sizeof(uint64_t));
+            break;
+
+        case GENERATOR_KISS32:
+            omnia_kiss32_fill((uint32_t *)buffer, BUFFER_SIZE / sizeof(uint32_t));
+            break;
+    }
+
+    if (reverse)
+    {
+        if (generator == GENERATOR_KISS32)
+            reverse32((uint32_t *)buffer, BUFFER_SIZE / sizeof(uint32_t));
+        else
+            reverse64((uint64_t *)buffer, BUFFER_SIZE / sizeof(uint64_t));
+    }
+}
+
+// write all of a buffer; false if the output is closed or fails
+static bool write_all(const unsigned char * data, size_t size)
+{
+    while (size > 0)
+    {
+        const ssize_t written = write(STDOUT_FILENO, data, size);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        data += written;
+        size -= (size_t)written;
+    }
+
+    return true;
+}
+
+static void usage(const char * program)
+{
+    fprintf(stderr, "usage: %s [-g xs128p|xoshiro256ss|xoshiro256pp|pcg64|wyrand|kiss64|kiss32] [-s seed] [-j jumps] [-r] [-n bytes]\n", program);
+}
+
+int main(int argc, char * argv[])
+{
+    generator_t generator = GENERATOR_DESCRIBED;
+    const omnia_generator_t * described = omnia_get_generator(OMNIA_GENERATOR_XS128P);
+    omnia_generator_state_t state;
+    uint64_t seed = 1;
+    unsigned long long jumps = 0;
+    bool reverse = false;
+    unsigned long long limit = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((i + 1 < argc) && (0 == strcmp(argv[i], "-g")))
+        {
+            ++i;
+
+            described = omnia_find_generator(argv[i]);
+
+            if (described != NULL)
+                generator = GENERATOR_DESCRIBED;
+            else if (0 == strcmp(argv[i], "kiss64"))
+                generator = GENERATOR_KISS64;
+            else if (0 == strcmp(argv[i], "kiss32"))
+                generator = GENERATOR_KISS32;
+            else
+            {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        else if ((i + 1 < argc) && (0 == strcmp(argv[i], "-s")))
+            seed = strtoull(argv[++i], NULL, 0);
+        else if ((i + 1 < argc) && (0 == strcmp(argv[i], "-j")))
+            jumps = strtoull(argv[++i], NULL, 0);
+        else if ((i + 1 < argc) && (0 == strcmp(argv[i], "-n")))
+            limit = strtoull(argv[++i], NULL, 0);
+        else if (0 == strcmp(argv[i], "-r"))
+            reverse = true;
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // KISS has no jump function
+    if ((jumps != 0) && (generator != GENERATOR_DESCRIBED))
+    {
+        fprintf(stderr, "%s: -j does not apply to kiss64 or kiss32\n", argv[0]);
+        return 1;
+    }
+
+    // seed the selected generator
+    uint64_t mix = seed;
+
+    switch (generator)
+    {
+        case GENERATOR_DESCRIBED:
+            described->seed(&state, seed);
+
+            for (unsigned long long j = 0; j < jumps; ++j)
+                described->jump(&state);
+
+            break;
+
+        case GENERATOR_KISS64:
+            omnia_kiss64_set_seed(splitmix64(&mix));
+            break;
+
+        case GENERATOR_KISS32:
+            omnia_kiss32_set_seed((uint32_t)splitmix64(&mix));
+            break;
+    }
+
+    unsigned char * buffer = (unsigned char *)omnia_alloc(BUFFER_SIZE);
+
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+
+    // a closed pipe ends the stream normally, through a failed write
+    signal(SIGPIPE, SIG_IGN);
+
+    unsigned long long written = 0;
+    int status = 0;
+
+    while ((limit == 0) || (written < limit))
+    {
+        size_t size = BUFFER_SIZE;
+
+        if ((limit != 0) && (limit - written < size))
+            size = (size_t)(limit - written);
+
+        generate(generator, described, &state, buffer, reverse);
+
+        if (!write_all(buffer, size))
+        {
+            if (errno != EPIPE)
+            {
+                perror(argv[0]);
+                status = 1;
+            }
+
+            break;
+        }
+
+        written += size;
+    }
+
+    omnia_free(buffer);
+    return status;
+}